@@ -24,11 +24,17 @@
 
 #define GLM_FORCE_RADIANS
 
+#include <algorithm>
+#include <atomic>
 #include <fstream>
+#include <future>
 #include <iostream>
 #include <iterator>
+#include <memory>
 #include <mutex>
+#include <set>
 #include <sstream>
+#include <thread>
 #include <utility>
 
 #include <wx/datetime.h>
@@ -49,6 +55,7 @@
 
 #include "3d_cache.h"
 #include "3d_info.h"
+#include "3d_mesh_file.h"
 #include "3d_plugin_manager.h"
 #include "sg/scenegraph.h"
 #include "plugins/3dapi/ifsg_api.h"
@@ -64,6 +71,7 @@
 
 static std::mutex mutex3D_cache;
 static std::mutex mutex3D_cacheManager;
+static std::mutex mutex3D_cacheWrite;
 
 
 static bool isSHA1Same( const unsigned char* shaA, const unsigned char* shaB )
@@ -142,6 +150,11 @@ public:
     std::string   pluginInfo;   // PluginName:Version string
     SCENEGRAPH*   sceneData;
     S3DMODEL*     renderData;
+
+    // the mapped mesh cache file when renderData was loaded from it
+    std::unique_ptr<S3D_MESH_FILE> meshFile;
+
+    void ClearRenderData();
 };
 
 
@@ -158,8 +171,19 @@ S3D_CACHE_ENTRY::~S3D_CACHE_ENTRY()
     if( NULL != sceneData )
         delete sceneData;
 
-    if( NULL != renderData )
+    ClearRenderData();
+}
+
+
+void S3D_CACHE_ENTRY::ClearRenderData()
+{
+    // render data mapped from the mesh cache is owned by the mesh file
+    if( meshFile )
+        renderData = NULL;
+    else if( NULL != renderData )
         S3D::Destroy3DModel( &renderData );
+
+    meshFile.reset();
 }
 
 
@@ -211,7 +235,8 @@ S3D_CACHE::~S3D_CACHE()
 }
 
 
-SCENEGRAPH* S3D_CACHE::load( const wxString& aModelFile, S3D_CACHE_ENTRY** aCachePtr )
+SCENEGRAPH* S3D_CACHE::load( const wxString& aModelFile, S3D_CACHE_ENTRY** aCachePtr,
+                             bool aRenderOnly )
 {
     if( aCachePtr )
         *aCachePtr = NULL;
@@ -262,10 +287,23 @@ SCENEGRAPH* S3D_CACHE::load( const wxString& aModelFile, S3D_CACHE_ENTRY** aCach
                     mi->second->sceneData = NULL;
                 }
 
-                if( NULL != mi->second->renderData )
-                    S3D::Destroy3DModel( &mi->second->renderData );
+                mi->second->ClearRenderData();
+
+                if( !aRenderOnly || !loadMeshData( mi->second ) )
+                {
+                    mi->second->sceneData = m_Plugins->Load3DModel( full3Dpath,
+                                                                    mi->second->pluginInfo );
+                }
+            }
+        }
 
-                mi->second->sceneData = m_Plugins->Load3DModel( full3Dpath, mi->second->pluginInfo );
+        // only the render data was loaded from the mesh cache; load the scene data now
+        if( !aRenderOnly && NULL == mi->second->sceneData && mi->second->meshFile )
+        {
+            if( !loadCacheData( mi->second ) )
+            {
+                mi->second->sceneData = m_Plugins->Load3DModel( full3Dpath,
+                                                                mi->second->pluginInfo );
             }
         }
 
@@ -276,7 +314,7 @@ SCENEGRAPH* S3D_CACHE::load( const wxString& aModelFile, S3D_CACHE_ENTRY** aCach
     }
 
     // a cache item does not exist; search the Filename->Cachename map
-    return checkCache( full3Dpath, aCachePtr );
+    return checkCache( full3Dpath, aCachePtr, aRenderOnly );
 }
 
 
@@ -286,75 +324,147 @@ SCENEGRAPH* S3D_CACHE::Load( const wxString& aModelFile )
 }
 
 
-SCENEGRAPH* S3D_CACHE::checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr )
+SCENEGRAPH* S3D_CACHE::checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr,
+                                   bool aRenderOnly )
 {
     if( aCachePtr )
         *aCachePtr = NULL;
 
-    unsigned char sha1sum[20];
+    S3D_CACHE_ENTRY* ep = loadEntry( aFileName, aRenderOnly );
 
-    if( !getSHA1( aFileName, sha1sum ) || m_CacheDir.empty() )
+    if( !addEntry( aFileName, ep ) )
     {
-        // just in case we can't get a hash digest (for example, on access issues)
-        // or we do not have a configured cache file directory, we create an
-        // entry to prevent further attempts at loading the file
-        S3D_CACHE_ENTRY* ep = new S3D_CACHE_ENTRY;
-        m_CacheList.push_back( ep );
-        wxFileName fname( aFileName );
-        ep->modTime = fname.GetModificationTime();
+        wxLogTrace( MASK_3D_CACHE, "%s:%s:%d\n * [BUG] duplicate entry in map file; key = '%s'",
+                    __FILE__, __FUNCTION__, __LINE__, aFileName );
 
-        if( m_CacheMap.insert( std::pair< wxString, S3D_CACHE_ENTRY* >
-            ( aFileName, ep ) ).second == false )
-        {
-            wxLogTrace( MASK_3D_CACHE, "%s:%s:%d\n * [BUG] duplicate entry in map file; key = '%s'",
-                        __FILE__, __FUNCTION__, __LINE__, aFileName );
+        return NULL;
+    }
 
-            m_CacheList.pop_back();
-            delete ep;
-        }
-        else
-        {
-            if( aCachePtr )
-                *aCachePtr = ep;
+    if( aCachePtr )
+        *aCachePtr = ep;
 
-        }
+    return ep->sceneData;
+}
 
-        return NULL;
-    }
 
+S3D_CACHE_ENTRY* S3D_CACHE::loadEntry( const wxString& aFileName, bool aRenderOnly )
+{
     S3D_CACHE_ENTRY* ep = new S3D_CACHE_ENTRY;
-    m_CacheList.push_back( ep );
     wxFileName fname( aFileName );
     ep->modTime = fname.GetModificationTime();
 
-    if( m_CacheMap.insert( std::pair< wxString, S3D_CACHE_ENTRY* >
-                               ( aFileName, ep ) ).second == false )
-    {
-        wxLogTrace( MASK_3D_CACHE, "%s:%s:%d\n * [BUG] duplicate entry in map file; key = '%s'",
-                    __FILE__, __FUNCTION__, __LINE__, aFileName );
-
-        m_CacheList.pop_back();
-        delete ep;
-        return NULL;
-    }
+    unsigned char sha1sum[20];
 
-    if( aCachePtr )
-        *aCachePtr = ep;
+    // just in case we can't get a hash digest (for example, on access issues)
+    // or we do not have a configured cache file directory, we return an empty
+    // entry to prevent further attempts at loading the file
+    if( !getSHA1( aFileName, sha1sum ) || m_CacheDir.empty() )
+        return ep;
 
     ep->SetSHA1( sha1sum );
 
+    if( aRenderOnly && loadMeshData( ep ) )
+        return ep;
+
     wxString bname = ep->GetCacheBaseName();
     wxString cachename = m_CacheDir + bname + wxT( ".3dc" );
 
     if( wxFileName::FileExists( cachename ) && loadCacheData( ep ) )
-        return ep->sceneData;
+        return ep;
 
     ep->sceneData = m_Plugins->Load3DModel( aFileName, ep->pluginInfo );
 
     if( NULL != ep->sceneData )
         saveCacheData( ep );
 
-    return ep->sceneData;
+    return ep;
+}
+
+
+bool S3D_CACHE::addEntry( const wxString& aFileName, S3D_CACHE_ENTRY* aCacheItem )
+{
+    if( m_CacheMap.insert( std::pair< wxString, S3D_CACHE_ENTRY* >
+                               ( aFileName, aCacheItem ) ).second == false )
+    {
+        delete aCacheItem;
+        return false;
+    }
+
+    m_CacheList.push_back( aCacheItem );
+    return true;
+}
+
+
+void S3D_CACHE::LoadModels( const std::vector<wxString>& aModelFileNames )
+{
+    std::vector<wxString> fileNames;
+
+    {
+        std::lock_guard<std::mutex> lock( mutex3D_cache );
+
+        // the unique files which are not in the cache yet
+        std::set<wxString> newFiles;
+
+        for( const wxString& modelFile : aModelFileNames )
+        {
+            wxString full3Dpath = m_FNResolver->ResolvePath( modelFile );
+
+            if( full3Dpath.empty() || m_CacheMap.find( full3Dpath ) != m_CacheMap.end() )
+                continue;
+
+            if( newFiles.insert( full3Dpath ).second )
+                fileNames.push_back( full3Dpath );
+        }
+    }
+
+    if( fileNames.empty() )
+        return;
+
+    std::vector<S3D_CACHE_ENTRY*> entries( fileNames.size(), NULL );
+
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                   fileNames.size() );
+    std::atomic<size_t> nextFile( 0 );
+    std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+    auto load_lambda = [&]() -> size_t
+    {
+        for( size_t i = nextFile++; i < fileNames.size(); i = nextFile++ )
+        {
+            S3D_CACHE_ENTRY* ep = loadEntry( fileNames[i], true );
+
+            // build the render data here too, GetModel() will only look it up
+            if( NULL == ep->renderData && NULL != ep->sceneData )
+            {
+                ep->renderData = S3D::GetModel( ep->sceneData );
+
+                if( NULL != ep->renderData )
+                    saveMeshData( ep );
+            }
+
+            entries[i] = ep;
+        }
+
+        return 1;
+    };
+
+    if( parallelThreadCount <= 1 )
+        load_lambda();
+    else
+    {
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, load_lambda );
+
+        // Finalize the threads
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii].wait();
+    }
+
+    std::lock_guard<std::mutex> lock( mutex3D_cache );
+
+    // a file may have been loaded by another caller meanwhile; addEntry() drops ours
+    for( size_t i = 0; i < fileNames.size(); ++i )
+        addEntry( fileNames[i], entries[i] );
 }
 
 
@@ -504,11 +614,65 @@ bool S3D_CACHE::saveCacheData( S3D_CACHE_ENTRY* aCacheItem )
         }
     }
 
+    // writing numbers the nodes with shared counters
+    std::lock_guard<std::mutex> lock( mutex3D_cacheWrite );
+
     return S3D::WriteCache( fname.ToUTF8(), true, (SGNODE*)aCacheItem->sceneData,
         aCacheItem->pluginInfo.c_str() );
 }
 
 
+bool S3D_CACHE::loadMeshData( S3D_CACHE_ENTRY* aCacheItem )
+{
+    wxString bname = aCacheItem->GetCacheBaseName();
+
+    if( bname.empty() || m_CacheDir.empty() )
+        return false;
+
+    wxString fname = m_CacheDir + bname + wxT( ".3dm" );
+
+    if( !wxFileName::FileExists( fname ) )
+        return false;
+
+    std::unique_ptr<S3D_MESH_FILE> meshFile( new S3D_MESH_FILE );
+
+    if( !meshFile->Open( fname ) )
+        return false;
+
+    // the mesh data is only valid with the plugin which tessellated the model
+    if( !m_Plugins->CheckTag( meshFile->GetPluginInfo().c_str() ) )
+    {
+        wxLogTrace( MASK_3D_CACHE, " * [3D model] mesh file '%s' was written by another plugin",
+                    fname );
+
+        return false;
+    }
+
+    aCacheItem->ClearRenderData();
+    aCacheItem->pluginInfo = meshFile->GetPluginInfo();
+    aCacheItem->renderData = meshFile->GetModel();
+    aCacheItem->meshFile = std::move( meshFile );
+
+    return true;
+}
+
+
+bool S3D_CACHE::saveMeshData( S3D_CACHE_ENTRY* aCacheItem )
+{
+    if( NULL == aCacheItem->renderData || aCacheItem->meshFile )
+        return false;
+
+    wxString bname = aCacheItem->GetCacheBaseName();
+
+    if( bname.empty() || m_CacheDir.empty() )
+        return false;
+
+    wxString fname = m_CacheDir + bname + wxT( ".3dm" );
+
+    return S3D_MESH_FILE::Write( fname, *aCacheItem->renderData, aCacheItem->pluginInfo );
+}
+
+
 bool S3D_CACHE::Set3DConfigDir( const wxString& aConfigDir )
 {
     if( !m_ConfigDir.empty() )
@@ -732,7 +896,11 @@ void S3D_CACHE::ClosePlugins( void )
 S3DMODEL* S3D_CACHE::GetModel( const wxString& aModelFileName )
 {
     S3D_CACHE_ENTRY* cp = NULL;
-    SCENEGRAPH* sp = load( aModelFileName, &cp );
+    SCENEGRAPH* sp = load( aModelFileName, &cp, true );
+
+    // the render data may have been mapped from the mesh cache, with no scene data
+    if( cp && cp->renderData )
+        return cp->renderData;
 
     if( !sp )
         return NULL;
@@ -752,6 +920,9 @@ S3DMODEL* S3D_CACHE::GetModel( const wxString& aModelFileName )
     S3DMODEL* mp = S3D::GetModel( sp );
     cp->renderData = mp;
 
+    if( mp )
+        saveMeshData( cp );
+
     return mp;
 }
 
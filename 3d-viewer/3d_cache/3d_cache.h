@@ -34,6 +34,7 @@
 #include "kicad_string.h"
 #include <list>
 #include <map>
+#include <vector>
 #include "plugins/3dapi/c3dmodel.h"
 #include <project.h>
 #include <wx/string.h>
@@ -86,10 +87,13 @@ private:
      *
      * @param[in]   aFileName   file name (full or partial path)
      * @param[out]  aCachePtr   optional return address for cache entry pointer
+     * @param[in]   aRenderOnly true if only the render data is needed; the scene data is
+     *                          then not loaded when the render data is in the mesh cache
      * @return      SCENEGRAPH object associated with file name
-     * @retval      NULL    on error
+     * @retval      NULL    on error, or if only the render data was loaded
      */
-    SCENEGRAPH* checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr = NULL );
+    SCENEGRAPH* checkCache( const wxString& aFileName, S3D_CACHE_ENTRY** aCachePtr = NULL,
+                            bool aRenderOnly = false );
 
     /**
      * Function getSHA1
@@ -108,8 +112,24 @@ private:
     // save scene data to a cache file
     bool saveCacheData( S3D_CACHE_ENTRY* aCacheItem );
 
-    // the real load function (can supply a cache entry pointer to member functions)
-    SCENEGRAPH* load( const wxString& aModelFile, S3D_CACHE_ENTRY** aCachePtr = NULL );
+    // map render data from a mesh cache file
+    bool loadMeshData( S3D_CACHE_ENTRY* aCacheItem );
+
+    // save render data to a mesh cache file
+    bool saveMeshData( S3D_CACHE_ENTRY* aCacheItem );
+
+    // load a model into a new cache entry which is not added to the cache; see
+    // checkCache() for aRenderOnly.  Does not use the cache lists, so it may run
+    // on several threads at once.
+    S3D_CACHE_ENTRY* loadEntry( const wxString& aFileName, bool aRenderOnly );
+
+    // add an entry to the cache; the entry is deleted if the file is already cached
+    bool addEntry( const wxString& aFileName, S3D_CACHE_ENTRY* aCacheItem );
+
+    // the real load function (can supply a cache entry pointer to member functions);
+    // see checkCache() for aRenderOnly
+    SCENEGRAPH* load( const wxString& aModelFile, S3D_CACHE_ENTRY** aCachePtr = NULL,
+                      bool aRenderOnly = false );
 
 public:
     S3D_CACHE();
@@ -210,6 +230,16 @@ public:
      */
     S3DMODEL* GetModel( const wxString& aModelFileName );
 
+    /**
+     * Function LoadModels
+     * loads the models which are not cached yet and builds their render data,
+     * reading or parsing the files on worker threads, so later calls to GetModel()
+     * for these files only look them up.
+     *
+     * @param aModelFileNames are the partial or full paths of the models to be loaded
+     */
+    void LoadModels( const std::vector<wxString>& aModelFileNames );
+
     wxString GetModelHash( const wxString& aModelFileName );
 };
 
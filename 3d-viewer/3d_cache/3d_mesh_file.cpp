@@ -0,0 +1,405 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <wx/ffile.h>
+#include <wx/filefn.h>
+#include <wx/log.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "3d_mesh_file.h"
+
+
+#define MASK_3D_CACHE "3D_CACHE"
+
+#define MESH_FILE_MAGIC     "KIMESH3D"
+#define MESH_FILE_VERSION   1
+#define MESH_FILE_BYTEORDER 0x01020304
+
+// Arrays are aligned in the file, so they are aligned in the mapping
+#define MESH_FILE_ALIGNMENT 16
+
+
+struct MESH_FILE_HEADER
+{
+    char     m_Magic[8];
+    uint32_t m_Version;
+    uint32_t m_ByteOrder;
+    uint32_t m_SizeofMaterial;      // sizeof( SMATERIAL ), materials are stored as is
+    uint32_t m_SizeofVec3;          // sizeof( SFVEC3F )
+    uint32_t m_SizeofVec2;          // sizeof( SFVEC2F )
+    uint32_t m_PluginInfoSize;      // the plugin info follows the header
+    uint32_t m_MaterialsSize;
+    uint32_t m_MeshesSize;
+    uint64_t m_MaterialsOffset;
+    uint64_t m_MeshesOffset;        // offset of the MESH_FILE_RECORD list
+};
+
+
+struct MESH_FILE_RECORD
+{
+    uint32_t m_VertexSize;
+    uint32_t m_FaceIdxSize;
+    uint32_t m_MaterialIdx;
+    uint32_t m_Padding;
+    uint64_t m_Positions;           // offsets of the arrays, 0 for a NULL array
+    uint64_t m_Normals;
+    uint64_t m_Texcoords;
+    uint64_t m_Color;
+    uint64_t m_FaceIdx;
+};
+
+
+static uint64_t alignOffset( uint64_t aOffset )
+{
+    return ( aOffset + MESH_FILE_ALIGNMENT - 1 ) & ~uint64_t( MESH_FILE_ALIGNMENT - 1 );
+}
+
+
+// Reserves room for an array in the file layout and returns its offset
+static uint64_t allocArray( uint64_t& aFileSize, const void* aArray, uint64_t aBytes )
+{
+    if( !aArray )
+        return 0;
+
+    uint64_t offset = alignOffset( aFileSize );
+    aFileSize = offset + aBytes;
+
+    return offset;
+}
+
+
+// Checks an array of the file lies within the mapping
+static bool checkArray( uint64_t aOffset, uint64_t aBytes, uint64_t aFileSize )
+{
+    return ( aOffset % MESH_FILE_ALIGNMENT ) == 0 && aOffset <= aFileSize
+           && aBytes <= aFileSize - aOffset;
+}
+
+
+S3D_MESH_FILE::S3D_MESH_FILE() :
+        m_data( NULL ),
+        m_size( 0 ),
+        m_model( NULL )
+{
+#ifdef _WIN32
+    m_fileHandle = INVALID_HANDLE_VALUE;
+    m_mappingHandle = NULL;
+#endif
+}
+
+
+S3D_MESH_FILE::~S3D_MESH_FILE()
+{
+    close();
+}
+
+
+bool S3D_MESH_FILE::Write( const wxString& aFileName, const S3DMODEL& aModel,
+                           const std::string& aPluginInfo )
+{
+    if( aModel.m_MeshesSize == 0 || !aModel.m_Meshes )
+        return false;
+
+    // Lay out the file
+    MESH_FILE_HEADER header;
+    memset( &header, 0, sizeof( header ) );
+
+    memcpy( header.m_Magic, MESH_FILE_MAGIC, sizeof( header.m_Magic ) );
+    header.m_Version = MESH_FILE_VERSION;
+    header.m_ByteOrder = MESH_FILE_BYTEORDER;
+    header.m_SizeofMaterial = sizeof( SMATERIAL );
+    header.m_SizeofVec3 = sizeof( SFVEC3F );
+    header.m_SizeofVec2 = sizeof( SFVEC2F );
+    header.m_PluginInfoSize = aPluginInfo.size();
+    header.m_MaterialsSize = aModel.m_MaterialsSize;
+    header.m_MeshesSize = aModel.m_MeshesSize;
+
+    uint64_t fileSize = sizeof( header ) + aPluginInfo.size();
+
+    header.m_MaterialsOffset = allocArray( fileSize, aModel.m_Materials,
+                                           sizeof( SMATERIAL ) * aModel.m_MaterialsSize );
+    header.m_MeshesOffset = alignOffset( fileSize );
+    fileSize = header.m_MeshesOffset + sizeof( MESH_FILE_RECORD ) * aModel.m_MeshesSize;
+
+    std::vector<MESH_FILE_RECORD> records( aModel.m_MeshesSize );
+
+    for( unsigned int i = 0; i < aModel.m_MeshesSize; ++i )
+    {
+        const SMESH&      mesh = aModel.m_Meshes[i];
+        MESH_FILE_RECORD& record = records[i];
+        const uint64_t    vertices = mesh.m_VertexSize;
+
+        memset( &record, 0, sizeof( record ) );
+
+        record.m_VertexSize = mesh.m_VertexSize;
+        record.m_FaceIdxSize = mesh.m_FaceIdxSize;
+        record.m_MaterialIdx = mesh.m_MaterialIdx;
+        record.m_Positions = allocArray( fileSize, mesh.m_Positions, sizeof( SFVEC3F ) * vertices );
+        record.m_Normals = allocArray( fileSize, mesh.m_Normals, sizeof( SFVEC3F ) * vertices );
+        record.m_Texcoords = allocArray( fileSize, mesh.m_Texcoords, sizeof( SFVEC2F ) * vertices );
+        record.m_Color = allocArray( fileSize, mesh.m_Color, sizeof( SFVEC3F ) * vertices );
+        record.m_FaceIdx = allocArray( fileSize, mesh.m_FaceIdx,
+                                       sizeof( unsigned int ) * mesh.m_FaceIdxSize );
+    }
+
+    // Fill the file image, then write it in one go
+    std::vector<char> image( fileSize, 0 );
+
+    auto copyArray = [&image]( uint64_t aOffset, const void* aArray, uint64_t aBytes )
+    {
+        if( aArray && aBytes )
+            memcpy( &image[aOffset], aArray, aBytes );
+    };
+
+    copyArray( 0, &header, sizeof( header ) );
+    copyArray( sizeof( header ), aPluginInfo.data(), aPluginInfo.size() );
+    copyArray( header.m_MaterialsOffset, aModel.m_Materials,
+               sizeof( SMATERIAL ) * aModel.m_MaterialsSize );
+    copyArray( header.m_MeshesOffset, records.data(),
+               sizeof( MESH_FILE_RECORD ) * records.size() );
+
+    for( unsigned int i = 0; i < aModel.m_MeshesSize; ++i )
+    {
+        const SMESH&            mesh = aModel.m_Meshes[i];
+        const MESH_FILE_RECORD& record = records[i];
+        const uint64_t          vertices = mesh.m_VertexSize;
+
+        copyArray( record.m_Positions, mesh.m_Positions, sizeof( SFVEC3F ) * vertices );
+        copyArray( record.m_Normals, mesh.m_Normals, sizeof( SFVEC3F ) * vertices );
+        copyArray( record.m_Texcoords, mesh.m_Texcoords, sizeof( SFVEC2F ) * vertices );
+        copyArray( record.m_Color, mesh.m_Color, sizeof( SFVEC3F ) * vertices );
+        copyArray( record.m_FaceIdx, mesh.m_FaceIdx,
+                   sizeof( unsigned int ) * mesh.m_FaceIdxSize );
+    }
+
+    wxString tmpName = aFileName + wxT( ".tmp" );
+    wxFFile  file( tmpName, wxT( "wb" ) );
+
+    if( !file.IsOpened() )
+    {
+        wxLogTrace( MASK_3D_CACHE, " * [3D model] cannot create mesh file '%s'", tmpName );
+        return false;
+    }
+
+    bool ok = file.Write( image.data(), image.size() ) == image.size();
+    ok = file.Close() && ok;
+
+    if( !ok || !wxRenameFile( tmpName, aFileName, true ) )
+    {
+        wxLogTrace( MASK_3D_CACHE, " * [3D model] cannot write mesh file '%s'", aFileName );
+        wxRemoveFile( tmpName );
+        return false;
+    }
+
+    return true;
+}
+
+
+bool S3D_MESH_FILE::Open( const wxString& aFileName )
+{
+    close();
+
+    if( !map( aFileName ) )
+        return false;
+
+    if( m_size < sizeof( MESH_FILE_HEADER ) )
+    {
+        close();
+        return false;
+    }
+
+    MESH_FILE_HEADER header;
+    memcpy( &header, m_data, sizeof( header ) );
+
+    if( memcmp( header.m_Magic, MESH_FILE_MAGIC, sizeof( header.m_Magic ) ) != 0
+            || header.m_Version != MESH_FILE_VERSION
+            || header.m_ByteOrder != MESH_FILE_BYTEORDER
+            || header.m_SizeofMaterial != sizeof( SMATERIAL )
+            || header.m_SizeofVec3 != sizeof( SFVEC3F )
+            || header.m_SizeofVec2 != sizeof( SFVEC2F )
+            || header.m_MeshesSize == 0
+            || header.m_PluginInfoSize > m_size - sizeof( header )
+            || !checkArray( header.m_MaterialsOffset,
+                            sizeof( SMATERIAL ) * uint64_t( header.m_MaterialsSize ), m_size )
+            || !checkArray( header.m_MeshesOffset,
+                            sizeof( MESH_FILE_RECORD ) * uint64_t( header.m_MeshesSize ),
+                            m_size ) )
+    {
+        wxLogTrace( MASK_3D_CACHE, " * [3D model] invalid mesh file '%s'", aFileName );
+        close();
+        return false;
+    }
+
+    m_pluginInfo.assign( m_data + sizeof( header ), header.m_PluginInfoSize );
+
+    const MESH_FILE_RECORD* records =
+            reinterpret_cast<const MESH_FILE_RECORD*>( m_data + header.m_MeshesOffset );
+
+    // Only the mesh list is allocated, its arrays are in the mapping
+    SMESH* meshes = new SMESH[header.m_MeshesSize];
+
+    for( uint32_t i = 0; i < header.m_MeshesSize; ++i )
+    {
+        const MESH_FILE_RECORD& record = records[i];
+        const uint64_t          vertices = record.m_VertexSize;
+
+        if( record.m_MaterialIdx >= header.m_MaterialsSize
+                || !checkArray( record.m_Positions, sizeof( SFVEC3F ) * vertices, m_size )
+                || !checkArray( record.m_Normals, sizeof( SFVEC3F ) * vertices, m_size )
+                || !checkArray( record.m_Texcoords, sizeof( SFVEC2F ) * vertices, m_size )
+                || !checkArray( record.m_Color, sizeof( SFVEC3F ) * vertices, m_size )
+                || !checkArray( record.m_FaceIdx,
+                                sizeof( unsigned int ) * uint64_t( record.m_FaceIdxSize ),
+                                m_size ) )
+        {
+            wxLogTrace( MASK_3D_CACHE, " * [3D model] invalid mesh in file '%s'", aFileName );
+            delete[] meshes;
+            close();
+            return false;
+        }
+
+        auto arrayAt = [this]( uint64_t aOffset ) -> char*
+        {
+            return aOffset ? m_data + aOffset : NULL;
+        };
+
+        SMESH& mesh = meshes[i];
+
+        mesh.m_VertexSize = record.m_VertexSize;
+        mesh.m_Positions = reinterpret_cast<SFVEC3F*>( arrayAt( record.m_Positions ) );
+        mesh.m_Normals = reinterpret_cast<SFVEC3F*>( arrayAt( record.m_Normals ) );
+        mesh.m_Texcoords = reinterpret_cast<SFVEC2F*>( arrayAt( record.m_Texcoords ) );
+        mesh.m_Color = reinterpret_cast<SFVEC3F*>( arrayAt( record.m_Color ) );
+        mesh.m_FaceIdxSize = record.m_FaceIdxSize;
+        mesh.m_FaceIdx = reinterpret_cast<unsigned int*>( arrayAt( record.m_FaceIdx ) );
+        mesh.m_MaterialIdx = record.m_MaterialIdx;
+    }
+
+    m_model = new S3DMODEL;
+    m_model->m_MeshesSize = header.m_MeshesSize;
+    m_model->m_Meshes = meshes;
+    m_model->m_MaterialsSize = header.m_MaterialsSize;
+    m_model->m_Materials = reinterpret_cast<SMATERIAL*>( m_data + header.m_MaterialsOffset );
+
+    return true;
+}
+
+
+bool S3D_MESH_FILE::map( const wxString& aFileName )
+{
+    // The mapping is private and writable: a renderer writing to the model only
+    // modifies its own copy of the page
+#ifdef _WIN32
+    m_fileHandle = CreateFileW( aFileName.wc_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+
+    if( m_fileHandle == INVALID_HANDLE_VALUE )
+        return false;
+
+    LARGE_INTEGER size;
+
+    if( !GetFileSizeEx( m_fileHandle, &size ) || size.QuadPart == 0 )
+        return false;
+
+    m_mappingHandle = CreateFileMappingW( m_fileHandle, NULL, PAGE_WRITECOPY, 0, 0, NULL );
+
+    if( !m_mappingHandle )
+        return false;
+
+    m_data = static_cast<char*>( MapViewOfFile( m_mappingHandle, FILE_MAP_COPY, 0, 0, 0 ) );
+    m_size = static_cast<size_t>( size.QuadPart );
+
+    return m_data != NULL;
+#else
+    int fd = open( aFileName.fn_str(), O_RDONLY );
+
+    if( fd < 0 )
+        return false;
+
+    struct stat st;
+
+    if( fstat( fd, &st ) != 0 || st.st_size == 0 )
+    {
+        ::close( fd );
+        return false;
+    }
+
+    void* data = mmap( NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+
+    // The mapping stays valid once the file is closed
+    ::close( fd );
+
+    if( data == MAP_FAILED )
+        return false;
+
+    m_data = static_cast<char*>( data );
+    m_size = static_cast<size_t>( st.st_size );
+
+    return true;
+#endif
+}
+
+
+void S3D_MESH_FILE::close()
+{
+    if( m_model )
+    {
+        delete[] m_model->m_Meshes;
+        delete m_model;
+        m_model = NULL;
+    }
+
+    m_pluginInfo.clear();
+
+#ifdef _WIN32
+    if( m_data )
+        UnmapViewOfFile( m_data );
+
+    if( m_mappingHandle )
+        CloseHandle( m_mappingHandle );
+
+    if( m_fileHandle != INVALID_HANDLE_VALUE )
+        CloseHandle( m_fileHandle );
+
+    m_mappingHandle = NULL;
+    m_fileHandle = INVALID_HANDLE_VALUE;
+#else
+    if( m_data )
+        munmap( m_data, m_size );
+#endif
+
+    m_data = NULL;
+    m_size = 0;
+}
@@ -0,0 +1,110 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file 3d_mesh_file.h
+ * defines the flat mesh cache file, which holds the render data of a 3D model
+ */
+
+#ifndef MESH_FILE_3D_H
+#define MESH_FILE_3D_H
+
+#include <cstddef>
+#include <string>
+#include <wx/string.h>
+#include "plugins/3dapi/c3dmodel.h"
+
+
+/**
+ * S3D_MESH_FILE
+ *
+ * A flat cache file holding the render data (S3DMODEL) of a 3D model: the materials,
+ * then for each mesh its packed positions, normals, texture coordinates, colors and
+ * face indexes.  The arrays are stored as they are laid out in memory, so the file is
+ * mapped and the S3DMODEL arrays point straight into the mapping; the only allocations
+ * are the S3DMODEL itself and its mesh list.
+ *
+ * The file is only meant to be read by the build which wrote it: it is rejected if the
+ * byte order or the structure sizes differ.
+ */
+class S3D_MESH_FILE
+{
+public:
+    S3D_MESH_FILE();
+    ~S3D_MESH_FILE();
+
+    /**
+     * Function Write
+     * writes the render data of a model to a mesh file.  The file is written under a
+     * temporary name then renamed, so it is never mapped while partially written.
+     *
+     * @param aFileName is the full path of the mesh file
+     * @param aModel is the render data to write
+     * @param aPluginInfo is the PluginName:Version string of the plugin which loaded the model
+     * @return true on success
+     */
+    static bool Write( const wxString& aFileName, const S3DMODEL& aModel,
+                       const std::string& aPluginInfo );
+
+    /**
+     * Function Open
+     * maps a mesh file and builds its render data.
+     *
+     * @param aFileName is the full path of the mesh file
+     * @return true on success; on failure the object holds no model
+     */
+    bool Open( const wxString& aFileName );
+
+    /**
+     * Function GetModel
+     * @return the render data of the mapped file, or NULL if no file is mapped.  The model
+     * is owned by this object and is valid until it is destroyed.
+     */
+    S3DMODEL* GetModel() { return m_model; }
+
+    /**
+     * Function GetPluginInfo
+     * @return the PluginName:Version string stored in the mapped file
+     */
+    const std::string& GetPluginInfo() const { return m_pluginInfo; }
+
+private:
+    // prohibit assignment and default copy constructor
+    S3D_MESH_FILE( const S3D_MESH_FILE& source );
+    S3D_MESH_FILE& operator=( const S3D_MESH_FILE& source );
+
+    bool map( const wxString& aFileName );
+    void close();
+
+    char*       m_data;         // the mapped file
+    size_t      m_size;         // size of the mapping in bytes
+    S3DMODEL*   m_model;        // render data pointing into the mapping
+    std::string m_pluginInfo;
+
+#ifdef _WIN32
+    void*       m_fileHandle;
+    void*       m_mappingHandle;
+#endif
+};
+
+#endif  // MESH_FILE_3D_H
@@ -25,6 +25,7 @@
 #include <utility>
 #include <iostream>
 #include <sstream>
+#include <mutex>
 
 #include <wx/dir.h>
 #include <wx/dynlib.h>
@@ -499,13 +500,38 @@ SCENEGRAPH* S3D_PLUGIN_MANAGER::Load3DModel( const wxString& aFileName, std::str
 
     while( sL != items.second )
     {
-        if( sL->second->CanRender() )
+        KICAD_PLUGIN_LDR_3D* plugin = sL->second;
+        bool canRender = false;
+        bool concurrent = false;
+
+        {
+            // the plugin may have to be reopened
+            std::lock_guard<std::shared_timed_mutex> lock( m_loadLock );
+
+            canRender = plugin->CanRender();
+            concurrent = canRender && plugin->CanLoadConcurrently();
+        }
+
+        if( canRender )
         {
-            SCENEGRAPH* sp = sL->second->Load( aFileName.ToUTF8() );
+            SCENEGRAPH* sp = NULL;
+
+            if( concurrent )
+            {
+                std::shared_lock<std::shared_timed_mutex> lock( m_loadLock );
+
+                sp = plugin->Load( aFileName.ToUTF8() );
+            }
+            else
+            {
+                std::lock_guard<std::shared_timed_mutex> lock( m_loadLock );
+
+                sp = plugin->Load( aFileName.ToUTF8() );
+            }
 
             if( NULL != sp )
             {
-                sL->second->GetPluginInfo( aPluginInfo );
+                plugin->GetPluginInfo( aPluginInfo );
                 return sp;
             }
         }
@@ -31,6 +31,7 @@
 
 #include <map>
 #include <list>
+#include <shared_mutex>
 #include <string>
 #include <wx/string.h>
 
@@ -50,6 +51,9 @@ private:
     /// list of file filters
     std::list< wxString > m_FileFilters;
 
+    /// held shared while loading with plugins which can load concurrently, else exclusively
+    std::shared_timed_mutex m_loadLock;
+
     /// load plugins
     void loadPlugins( void );
 
@@ -82,6 +86,16 @@ public:
      */
     std::list< wxString > const* GetFileFilters( void ) const;
 
+    /**
+     * Function Load3DModel
+     * loads a model with the first plugin able to read it.  May be called from
+     * several threads; plugins which do not declare they can load concurrently
+     * are only called while no other model is being loaded.
+     *
+     * @param aFileName is the full path to the model
+     * @param aPluginInfo [out] is the PluginName:Version string of the plugin used
+     * @return the scene data, or NULL if no plugin could load the model
+     */
     SCENEGRAPH* Load3DModel( const wxString& aFileName, std::string& aPluginInfo );
 
     /**
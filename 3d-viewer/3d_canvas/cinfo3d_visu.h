@@ -30,6 +30,8 @@
 #ifndef CINFO3D_VISU_H
 #define CINFO3D_VISU_H
 
+#include <map>
+#include <mutex>
 #include <vector>
 #include "../3d_rendering/3d_render_raytracing/accelerators/ccontainer2d.h"
 #include "../3d_rendering/3d_render_raytracing/accelerators/ccontainer.h"
@@ -432,6 +434,18 @@ class CINFO3D_VISU
     bool createBoardPolygon();
     void createLayers( REPORTER *aStatusTextReporter );
     void destroyLayers();
+    void destroyLayer( PCB_LAYER_ID aLayer );
+    void destroyHoles();
+
+    /**
+     * @brief hashLayers - Hash the settings and the board items each enabled layer is
+     * built from, to find the layers which need to be rebuilt
+     * @return the hash of each enabled copper and technical layer
+     */
+    std::map<PCB_LAYER_ID, size_t> hashLayers() const;
+
+    void createCopperLayer( PCB_LAYER_ID aLayer, const std::vector<const TRACK *> &aTrackList );
+    void createTechLayer( PCB_LAYER_ID aLayer );
 
     // Helper functions to create the board
     COBJECT2D *createNewTrack( const TRACK* aTrack , int aClearanceValue ) const;
@@ -595,6 +609,13 @@ private:
     /// It contains the holes per each layer
     MAP_CONTAINER_2D  m_layers_holes2D;
 
+    /// Hash of the items and settings each layer of m_layers_container2D (and m_layers_poly)
+    /// was built from, so the next createLayers() keeps the unchanged layers
+    std::map<PCB_LAYER_ID, size_t> m_layers_hash;
+
+    /// Serializes the conversion of texts, as the stroke font renderer is shared
+    std::mutex        m_textLock;
+
     /// It contains the list of throughHoles of the board,
     /// the radius of the hole is inflated with the copper tickness
     CBVHCONTAINER2D   m_through_holes_outer;
@@ -56,31 +56,39 @@
 
 
 
+// A helper struct for the callback function
 // These variables are parameters used in addTextSegmToContainer.
 // But addTextSegmToContainer is a call-back function,
-// so we cannot send them as arguments.
-static int s_textWidth;
-static CGENERICCONTAINER2D *s_dstcontainer = NULL;
-static float s_biuTo3Dunits;
-static const BOARD_ITEM *s_boardItem = NULL;
+// so they are sent through its aData argument.
+struct TSEGM_2_CONTAINER_PRMS
+{
+    int                  m_textWidth;
+    CGENERICCONTAINER2D* m_dstContainer;
+    float                m_biuTo3Dunits;
+    const BOARD_ITEM*    m_boardItem;
+};
+
 
 // This is a call back function, used by GRText to draw the 3D text shape:
-void addTextSegmToContainer( int x0, int y0, int xf, int yf, void* aData )
+static void addTextSegmToContainer( int x0, int y0, int xf, int yf, void* aData )
 {
-    wxASSERT( s_dstcontainer != NULL );
+    const TSEGM_2_CONTAINER_PRMS* prms = static_cast<const TSEGM_2_CONTAINER_PRMS*>( aData );
+
+    wxASSERT( prms->m_dstContainer != NULL );
 
-    const SFVEC2F start3DU( x0 * s_biuTo3Dunits, -y0 * s_biuTo3Dunits );
-    const SFVEC2F end3DU  ( xf * s_biuTo3Dunits, -yf * s_biuTo3Dunits );
+    const SFVEC2F start3DU( x0 * prms->m_biuTo3Dunits, -y0 * prms->m_biuTo3Dunits );
+    const SFVEC2F end3DU  ( xf * prms->m_biuTo3Dunits, -yf * prms->m_biuTo3Dunits );
 
     if( Is_segment_a_circle( start3DU, end3DU ) )
-        s_dstcontainer->Add( new CFILLEDCIRCLE2D( start3DU,
-                                                  ( s_textWidth / 2 ) * s_biuTo3Dunits,
-                                                  *s_boardItem) );
+        prms->m_dstContainer->Add( new CFILLEDCIRCLE2D( start3DU,
+                                                        ( prms->m_textWidth / 2 ) *
+                                                                prms->m_biuTo3Dunits,
+                                                        *prms->m_boardItem ) );
     else
-        s_dstcontainer->Add( new CROUNDSEGMENT2D( start3DU,
-                                                  end3DU,
-                                                  s_textWidth * s_biuTo3Dunits,
-                                                  *s_boardItem ) );
+        prms->m_dstContainer->Add( new CROUNDSEGMENT2D( start3DU,
+                                                        end3DU,
+                                                        prms->m_textWidth * prms->m_biuTo3Dunits,
+                                                        *prms->m_boardItem ) );
 }
 
 
@@ -97,14 +105,19 @@ void CINFO3D_VISU::AddShapeWithClearanceToContainer( const TEXTE_PCB* aText,
     if( aText->IsMirrored() )
         size.x = -size.x;
 
-    s_boardItem    = (const BOARD_ITEM *) &aText;
-    s_dstcontainer = aDstContainer;
-    s_textWidth    = aText->GetThickness() + ( 2 * aClearanceValue );
-    s_biuTo3Dunits = m_biuTo3Dunits;
+    TSEGM_2_CONTAINER_PRMS prms;
+
+    prms.m_boardItem    = (const BOARD_ITEM *) &aText;
+    prms.m_dstContainer = aDstContainer;
+    prms.m_textWidth    = aText->GetThickness() + ( 2 * aClearanceValue );
+    prms.m_biuTo3Dunits = m_biuTo3Dunits;
 
     // not actually used, but needed by GRText
     const COLOR4D dummy_color = COLOR4D::BLACK;
 
+    // The layers are built in parallel, but GRText uses a shared renderer
+    std::lock_guard<std::mutex> lock( m_textLock );
+
     if( aText->IsMultilineAllowed() )
     {
         wxArrayString strings_list;
@@ -119,14 +132,14 @@ void CINFO3D_VISU::AddShapeWithClearanceToContainer( const TEXTE_PCB* aText,
 
             GRText( NULL, positions[ii], dummy_color, txt, aText->GetTextAngle(), size,
                     aText->GetHorizJustify(), aText->GetVertJustify(), aText->GetThickness(),
-                    aText->IsItalic(), true, addTextSegmToContainer );
+                    aText->IsItalic(), true, addTextSegmToContainer, &prms );
         }
     }
     else
     {
         GRText( NULL, aText->GetTextPos(), dummy_color, aText->GetShownText(),
                 aText->GetTextAngle(), size, aText->GetHorizJustify(), aText->GetVertJustify(),
-                aText->GetThickness(), aText->IsItalic(), true, addTextSegmToContainer );
+                aText->GetThickness(), aText->IsItalic(), true, addTextSegmToContainer, &prms );
     }
 }
 
@@ -215,13 +228,21 @@ void CINFO3D_VISU::AddGraphicsShapesWithClearanceToContainer( const MODULE* aMod
     if( aModule->Value().GetLayer() == aLayerId && aModule->Value().IsVisible() )
         texts.push_back( &aModule->Value() );
 
-    s_boardItem    = (const BOARD_ITEM *)&aModule->Value();
-    s_dstcontainer = aDstContainer;
-    s_biuTo3Dunits = m_biuTo3Dunits;
+    if( texts.empty() )
+        return;
+
+    TSEGM_2_CONTAINER_PRMS prms;
+
+    prms.m_boardItem    = (const BOARD_ITEM *)&aModule->Value();
+    prms.m_dstContainer = aDstContainer;
+    prms.m_biuTo3Dunits = m_biuTo3Dunits;
+
+    // The layers are built in parallel, but GRText uses a shared renderer
+    std::lock_guard<std::mutex> lock( m_textLock );
 
     for( TEXTE_MODULE* text : texts )
     {
-        s_textWidth = text->GetThickness() + ( 2 * aInflateValue );
+        prms.m_textWidth = text->GetThickness() + ( 2 * aInflateValue );
         wxSize size = text->GetTextSize();
 
         if( text->IsMirrored() )
@@ -229,7 +250,7 @@ void CINFO3D_VISU::AddGraphicsShapesWithClearanceToContainer( const MODULE* aMod
 
         GRText( NULL, text->GetTextPos(), BLACK, text->GetShownText(), text->GetDrawRotation(),
                 size, text->GetHorizJustify(), text->GetVertJustify(), text->GetThickness(),
-                text->IsItalic(), true, addTextSegmToContainer );
+                text->IsItalic(), true, addTextSegmToContainer, &prms );
     }
 }
 
@@ -49,15 +49,42 @@
 #include <class_zone.h>
 #include <class_text_mod.h>
 #include <convert_basic_shapes_to_polygon.h>
+#include <kicad_plugin.h>
+#include <richio.h>
 #include <trigo.h>
 #include <utility>
 #include <vector>
 #include <thread>
 #include <algorithm>
 #include <atomic>
+#include <functional>
+#include <future>
+
+#include <boost/functional/hash.hpp>
 
 #include <profile.h>
 
+// Technical layers drawn by the 3D viewer (user layers are not drawn)
+static const PCB_LAYER_ID teckLayerList[] = {
+        B_Adhes,
+        F_Adhes,
+        B_Paste,
+        F_Paste,
+        B_SilkS,
+        F_SilkS,
+        B_Mask,
+        F_Mask,
+
+        // Aux Layers
+        Dwgs_User,
+        Cmts_User,
+        Eco1_User,
+        Eco2_User,
+        Edge_Cuts,
+        Margin
+    };
+
+
 void CINFO3D_VISU::destroyLayers()
 {
     if( !m_layers_poly.empty() )
@@ -73,43 +100,73 @@ void CINFO3D_VISU::destroyLayers()
         m_layers_poly.clear();
     }
 
-    if( !m_layers_inner_holes_poly.empty() )
+    if( !m_layers_container2D.empty() )
     {
-        for( MAP_POLY::iterator ii = m_layers_inner_holes_poly.begin();
-             ii != m_layers_inner_holes_poly.end();
+        for( MAP_CONTAINER_2D::iterator ii = m_layers_container2D.begin();
+             ii != m_layers_container2D.end();
              ++ii )
         {
             delete ii->second;
             ii->second = NULL;
         }
 
-        m_layers_inner_holes_poly.clear();
+        m_layers_container2D.clear();
     }
 
-    if( !m_layers_outer_holes_poly.empty() )
+    m_layers_hash.clear();
+
+    destroyHoles();
+}
+
+
+void CINFO3D_VISU::destroyLayer( PCB_LAYER_ID aLayer )
+{
+    MAP_POLY::iterator poly = m_layers_poly.find( aLayer );
+
+    if( poly != m_layers_poly.end() )
     {
-        for( MAP_POLY::iterator ii = m_layers_outer_holes_poly.begin();
-             ii != m_layers_outer_holes_poly.end();
+        delete poly->second;
+        m_layers_poly.erase( poly );
+    }
+
+    MAP_CONTAINER_2D::iterator container = m_layers_container2D.find( aLayer );
+
+    if( container != m_layers_container2D.end() )
+    {
+        delete container->second;
+        m_layers_container2D.erase( container );
+    }
+
+    m_layers_hash.erase( aLayer );
+}
+
+
+void CINFO3D_VISU::destroyHoles()
+{
+    if( !m_layers_inner_holes_poly.empty() )
+    {
+        for( MAP_POLY::iterator ii = m_layers_inner_holes_poly.begin();
+             ii != m_layers_inner_holes_poly.end();
              ++ii )
         {
             delete ii->second;
             ii->second = NULL;
         }
 
-        m_layers_outer_holes_poly.clear();
+        m_layers_inner_holes_poly.clear();
     }
 
-    if( !m_layers_container2D.empty() )
+    if( !m_layers_outer_holes_poly.empty() )
     {
-        for( MAP_CONTAINER_2D::iterator ii = m_layers_container2D.begin();
-             ii != m_layers_container2D.end();
+        for( MAP_POLY::iterator ii = m_layers_outer_holes_poly.begin();
+             ii != m_layers_outer_holes_poly.end();
              ++ii )
         {
             delete ii->second;
             ii->second = NULL;
         }
 
-        m_layers_container2D.clear();
+        m_layers_outer_holes_poly.clear();
     }
 
     if( !m_layers_holes2D.empty() )
@@ -138,9 +195,479 @@ void CINFO3D_VISU::destroyLayers()
 }
 
 
+std::map<PCB_LAYER_ID, size_t> CINFO3D_VISU::hashLayers() const
+{
+    LSET enabledLayers;
+
+    for( PCB_LAYER_ID layer : LSET::AllCuMask( m_copperLayersCount ).Seq() )
+    {
+        if( Is3DLayerEnabled( layer ) )
+            enabledLayers.set( layer );
+    }
+
+    for( LSEQ seq = LSET::AllNonCuMask().Seq( teckLayerList, arrayDim( teckLayerList ) );
+         seq;
+         ++seq )
+    {
+        if( Is3DLayerEnabled( *seq ) )
+            enabledLayers.set( *seq );
+    }
+
+    // The settings used to convert the items
+    size_t settingsHash = 0;
+
+    boost::hash_combine( settingsHash, m_biuTo3Dunits );
+    boost::hash_combine( settingsHash, GetCopperThicknessBIU() );
+    boost::hash_combine( settingsHash, m_copperLayersCount );
+    boost::hash_combine( settingsHash, static_cast<int>( m_render_engine ) );
+    boost::hash_combine( settingsHash, GetFlag( FL_RENDER_OPENGL_COPPER_THICKNESS ) );
+    boost::hash_combine( settingsHash, GetFlag( FL_ZONE ) );
+    boost::hash_combine( settingsHash, g_DrawDefaultLineThickness );
+
+    // The board settings read by the items when converted (pad mask and paste margins, and
+    // the error of the arcs approximated by segments)
+    const BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+
+    boost::hash_combine( settingsHash, bds.m_SolderMaskMargin );
+    boost::hash_combine( settingsHash, bds.m_SolderPasteMargin );
+    boost::hash_combine( settingsHash, bds.m_SolderPasteMarginRatio );
+    boost::hash_combine( settingsHash, bds.m_MaxError );
+
+    std::vector<size_t> hashes( PCB_LAYER_ID_COUNT, settingsHash );
+
+    auto addItemHash = [&]( size_t aItemHash, const LSET& aItemLayers )
+    {
+        for( PCB_LAYER_ID layer : LSET( aItemLayers & enabledLayers ).Seq() )
+            boost::hash_combine( hashes[layer], aItemHash );
+    };
+
+    // The s-expression of an item holds everything its 3D shapes are built from
+    LOCALE_IO        toggle;
+    PCB_IO           io( CTL_FOR_CLIPBOARD );
+    STRING_FORMATTER formatter;
+
+    io.SetOutputFormatter( &formatter );
+
+    auto formatHash = [&]( BOARD_ITEM* aItem ) -> size_t
+    {
+        formatter.Clear();
+        io.Format( aItem );
+
+        return std::hash<std::string>{}( formatter.GetString() );
+    };
+
+    for( TRACK* track : m_board->Tracks() )
+        addItemHash( formatHash( track ), track->GetLayerSet() );
+
+    for( MODULE* module : m_board->Modules() )
+    {
+        LSET moduleLayers;
+
+        moduleLayers.set( module->Reference().GetLayer() );
+        moduleLayers.set( module->Value().GetLayer() );
+
+        for( D_PAD* pad : module->Pads() )
+            moduleLayers |= pad->GetLayerSet();
+
+        for( BOARD_ITEM* item : module->GraphicalItems() )
+            moduleLayers |= item->GetLayerSet();
+
+        addItemHash( formatHash( module ), moduleLayers );
+    }
+
+    for( BOARD_ITEM* item : m_board->Drawings() )
+        addItemHash( formatHash( item ), item->GetLayerSet() );
+
+    for( ZONE_CONTAINER* zone : m_board->Zones() )
+    {
+        // Only the filled areas are drawn: hash them instead of formatting the zone
+        const SHAPE_POLY_SET& fill = zone->GetFilledPolysList();
+        size_t                zoneHash = 0;
+
+        boost::hash_combine( zoneHash, zone->GetMinThickness() );
+        boost::hash_combine( zoneHash, zone->GetFilledPolysUseThickness() );
+        boost::hash_combine( zoneHash, fill.OutlineCount() );
+
+        for( int ii = 0; ii < fill.OutlineCount(); ++ii )
+            boost::hash_combine( zoneHash, fill.HoleCount( ii ) );
+
+        for( auto it = fill.CIterateWithHoles(); it; it++ )
+        {
+            boost::hash_combine( zoneHash, it->x );
+            boost::hash_combine( zoneHash, it->y );
+        }
+
+        addItemHash( zoneHash, zone->GetLayerSet() );
+    }
+
+    std::map<PCB_LAYER_ID, size_t> layerHashes;
+
+    for( PCB_LAYER_ID layer : enabledLayers.Seq() )
+        layerHashes[layer] = hashes[layer];
+
+    return layerHashes;
+}
+
+
+void CINFO3D_VISU::createCopperLayer( PCB_LAYER_ID aLayer,
+                                      const std::vector<const TRACK *> &aTrackList )
+{
+    wxASSERT( m_layers_container2D.find( aLayer ) != m_layers_container2D.end() );
+
+    CBVHCONTAINER2D *layerContainer = m_layers_container2D.at( aLayer );
+
+    // Create tracks as objects and add it to container
+    // /////////////////////////////////////////////////////////////////////////
+    for( const TRACK *track : aTrackList )
+    {
+        // NOTE: Vias can be on multiple layers
+        if( !track->IsOnLayer( aLayer ) )
+            continue;
+
+        // Add object item to layer container
+        layerContainer->Add( createNewTrack( track, 0.0f ) );
+    }
+
+    // Add modules PADs objects to containers
+    // /////////////////////////////////////////////////////////////////////////
+    for( auto module : m_board->Modules() )
+    {
+        // Note: NPTH pads are not drawn on copper layers when the pad
+        // has same shape as its hole
+        AddPadsShapesWithClearanceToContainer( module,
+                                               layerContainer,
+                                               aLayer,
+                                               0,
+                                               true );
+
+        // Micro-wave modules may have items on copper layers
+        AddGraphicsShapesWithClearanceToContainer( module,
+                                                   layerContainer,
+                                                   aLayer,
+                                                   0 );
+    }
+
+    // Add graphic item on copper layers to object containers
+    // /////////////////////////////////////////////////////////////////////////
+    for( auto item : m_board->Drawings() )
+    {
+        if( !item->IsOnLayer( aLayer ) )
+            continue;
+
+        switch( item->Type() )
+        {
+        case PCB_LINE_T:
+            AddShapeWithClearanceToContainer( (DRAWSEGMENT*)item,
+                                              layerContainer,
+                                              aLayer,
+                                              0 );
+            break;
+
+        case PCB_TEXT_T:
+            AddShapeWithClearanceToContainer( (TEXTE_PCB*) item,
+                                              layerContainer,
+                                              aLayer,
+                                              0 );
+            break;
+
+        case PCB_DIMENSION_T:
+            AddShapeWithClearanceToContainer( (DIMENSION*) item,
+                                              layerContainer,
+                                              aLayer,
+                                              0 );
+            break;
+
+        default:
+            wxLogTrace( m_logTrace,
+                        wxT( "createLayers: item type: %d not implemented" ),
+                        item->Type() );
+            break;
+        }
+    }
+
+    // The zones are added to the container by their own tasks
+
+    if( !GetFlag( FL_RENDER_OPENGL_COPPER_THICKNESS )
+            || ( m_render_engine != RENDER_ENGINE::OPENGL_LEGACY ) )
+        return;
+
+    wxASSERT( m_layers_poly.find( aLayer ) != m_layers_poly.end() );
+
+    SHAPE_POLY_SET *layerPoly = m_layers_poly.at( aLayer );
+
+    // Creates outline contours of the tracks and add it to the poly of the layer
+    // /////////////////////////////////////////////////////////////////////////
+    for( const TRACK *track : aTrackList )
+    {
+        if( !track->IsOnLayer( aLayer ) )
+            continue;
+
+        // Add the track contour
+        track->TransformShapeWithClearanceToPolygon( *layerPoly, 0 );
+    }
+
+    // Add modules PADs poly contourns
+    // /////////////////////////////////////////////////////////////////////////
+    for( auto module : m_board->Modules() )
+    {
+        // Note: NPTH pads are not drawn on copper layers when the pad
+        // has same shape as its hole
+        transformPadsShapesWithClearanceToPolygon( module->Pads(),
+                                                   aLayer,
+                                                   *layerPoly,
+                                                   0,
+                                                   true );
+
+        // Micro-wave modules may have items on copper layers
+        {
+            std::lock_guard<std::mutex> lock( m_textLock );
+
+            module->TransformGraphicTextWithClearanceToPolygonSet( aLayer, *layerPoly, 0 );
+        }
+
+        transformGraphicModuleEdgeToPolygonSet( module, aLayer, *layerPoly );
+    }
+
+    // Add graphic item on copper layers to poly contourns
+    // /////////////////////////////////////////////////////////////////////////
+    for( auto item : m_board->Drawings() )
+    {
+        if( !item->IsOnLayer( aLayer ) )
+            continue;
+
+        switch( item->Type() )
+        {
+        case PCB_LINE_T:
+            ( (DRAWSEGMENT*) item )->TransformShapeWithClearanceToPolygon( *layerPoly, 0 );
+            break;
+
+        case PCB_TEXT_T:
+        {
+            std::lock_guard<std::mutex> lock( m_textLock );
+
+            ( (TEXTE_PCB*) item )->TransformShapeWithClearanceToPolygonSet( *layerPoly, 0 );
+        }
+            break;
+
+        default:
+            wxLogTrace( m_logTrace, wxT( "createLayers: item type: %d not implemented" ),
+                    item->Type() );
+            break;
+        }
+    }
+
+    // Add copper zones contours
+    // /////////////////////////////////////////////////////////////////////////
+    if( GetFlag( FL_ZONE ) )
+    {
+        for( int ii = 0; ii < m_board->GetAreaCount(); ++ii )
+        {
+            const ZONE_CONTAINER* zone = m_board->GetArea( ii );
+
+            if( zone->GetLayer() == aLayer )
+                zone->TransformSolidAreasShapesToPolygonSet( *layerPoly );
+        }
+    }
+
+    // This will make a union of all added contours
+    layerPoly->Simplify( SHAPE_POLY_SET::PM_FAST );
+}
+
+
+void CINFO3D_VISU::createTechLayer( PCB_LAYER_ID aLayer )
+{
+    const PCB_LAYER_ID curr_layer_id = aLayer;
+
+    wxASSERT( m_layers_container2D.find( aLayer ) != m_layers_container2D.end() );
+    wxASSERT( m_layers_poly.find( aLayer ) != m_layers_poly.end() );
+
+    CBVHCONTAINER2D *layerContainer = m_layers_container2D.at( aLayer );
+    SHAPE_POLY_SET  *layerPoly = m_layers_poly.at( aLayer );
+
+    // Add drawing objects
+    // /////////////////////////////////////////////////////////////////////////
+    for( auto item : m_board->Drawings() )
+    {
+        if( !item->IsOnLayer( curr_layer_id ) )
+            continue;
+
+        switch( item->Type() )
+        {
+        case PCB_LINE_T:
+            AddShapeWithClearanceToContainer( (DRAWSEGMENT*)item,
+                                              layerContainer,
+                                              curr_layer_id,
+                                              0 );
+            break;
+
+        case PCB_TEXT_T:
+            AddShapeWithClearanceToContainer( (TEXTE_PCB*) item,
+                                              layerContainer,
+                                              curr_layer_id,
+                                              0 );
+            break;
+
+        case PCB_DIMENSION_T:
+            AddShapeWithClearanceToContainer( (DIMENSION*) item,
+                                              layerContainer,
+                                              curr_layer_id,
+                                              0 );
+            break;
+
+        default:
+            break;
+        }
+    }
+
+
+    // Add drawing contours
+    // /////////////////////////////////////////////////////////////////////////
+    for( auto item : m_board->Drawings() )
+    {
+        if( !item->IsOnLayer( curr_layer_id ) )
+            continue;
+
+        switch( item->Type() )
+        {
+        case PCB_LINE_T:
+            ( (DRAWSEGMENT*) item )->TransformShapeWithClearanceToPolygon( *layerPoly, 0 );
+            break;
+
+        case PCB_TEXT_T:
+        {
+            std::lock_guard<std::mutex> lock( m_textLock );
+
+            ( (TEXTE_PCB*) item )->TransformShapeWithClearanceToPolygonSet( *layerPoly, 0 );
+        }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+
+    // Add modules tech layers - objects
+    // /////////////////////////////////////////////////////////////////////////
+    for( auto module : m_board->Modules() )
+    {
+        if( (curr_layer_id == F_SilkS) || (curr_layer_id == B_SilkS) )
+        {
+            int     linewidth = g_DrawDefaultLineThickness;
+
+            for( auto pad : module->Pads() )
+            {
+                if( !pad->IsOnLayer( curr_layer_id ) )
+                    continue;
+
+                buildPadShapeThickOutlineAsSegments( pad, layerContainer, linewidth );
+            }
+        }
+        else
+        {
+            AddPadsShapesWithClearanceToContainer(
+                    module, layerContainer, curr_layer_id, 0, false );
+        }
+
+        AddGraphicsShapesWithClearanceToContainer( module, layerContainer, curr_layer_id, 0 );
+    }
+
+
+    // Add modules tech layers - contours
+    // /////////////////////////////////////////////////////////////////////////
+    for( auto module : m_board->Modules() )
+    {
+        if( (curr_layer_id == F_SilkS) || (curr_layer_id == B_SilkS) )
+        {
+            const int linewidth = g_DrawDefaultLineThickness;
+
+            for( auto pad : module->Pads() )
+            {
+                if( !pad->IsOnLayer( curr_layer_id ) )
+                    continue;
+
+                buildPadShapeThickOutlineAsPolygon( pad, *layerPoly, linewidth );
+            }
+        }
+        else
+        {
+            transformPadsShapesWithClearanceToPolygon(
+                    module->Pads(), curr_layer_id, *layerPoly, 0, false );
+        }
+
+        // On tech layers, use a poor circle approximation, only for texts (stroke font)
+        {
+            std::lock_guard<std::mutex> lock( m_textLock );
+
+            module->TransformGraphicTextWithClearanceToPolygonSet( curr_layer_id, *layerPoly, 0 );
+        }
+
+        // Add the remaining things with dynamic seg count for circles
+        transformGraphicModuleEdgeToPolygonSet( module, curr_layer_id, *layerPoly );
+    }
+
+
+    // Draw non copper zones
+    // /////////////////////////////////////////////////////////////////////////
+    if( GetFlag( FL_ZONE ) )
+    {
+        for( int ii = 0; ii < m_board->GetAreaCount(); ++ii )
+        {
+            ZONE_CONTAINER* zone = m_board->GetArea( ii );
+
+            if( !zone->IsOnLayer( curr_layer_id ) )
+                continue;
+
+            AddSolidAreasShapesToContainer( zone,
+                                            layerContainer,
+                                            curr_layer_id );
+        }
+
+        for( int ii = 0; ii < m_board->GetAreaCount(); ++ii )
+        {
+            ZONE_CONTAINER* zone = m_board->GetArea( ii );
+
+            if( !zone->IsOnLayer( curr_layer_id ) )
+                continue;
+
+            zone->TransformSolidAreasShapesToPolygonSet( *layerPoly );
+        }
+    }
+
+    // This will make a union of all added contours
+    layerPoly->Simplify( SHAPE_POLY_SET::PM_FAST );
+}
+
+
 void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
 {
-    destroyLayers();
+    destroyHoles();
+
+    // Keep the layers built from the same board items and settings by the previous call
+    // /////////////////////////////////////////////////////////////////////////
+    const std::map<PCB_LAYER_ID, size_t> layerHashes = hashLayers();
+
+    std::vector<PCB_LAYER_ID> changedLayers;
+
+    for( const std::pair<const PCB_LAYER_ID, size_t>& layerHash : m_layers_hash )
+    {
+        auto hash = layerHashes.find( layerHash.first );
+
+        if( ( hash == layerHashes.end() ) || ( hash->second != layerHash.second ) )
+            changedLayers.push_back( layerHash.first );
+    }
+
+    for( PCB_LAYER_ID layer : changedLayers )
+        destroyLayer( layer );
+
+    // Layers built without a hash (e.g. by an interrupted reload) cannot be kept
+    for( auto ii = m_layers_container2D.begin(); ii != m_layers_container2D.end(); )
+    {
+        PCB_LAYER_ID layer = ( ii++ )->first;
+
+        if( m_layers_hash.find( layer ) == m_layers_hash.end() )
+            destroyLayer( layer );
+    }
 
     // Build Copper layers
     // Based on: https://github.com/KiCad/kicad-source-mirror/blob/master/3d-viewer/3d_draw.cpp#L692
@@ -208,6 +735,10 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     layer_id.clear();
     layer_id.reserve( m_copperLayersCount );
 
+    // The layers which were not kept, to be built
+    std::vector< PCB_LAYER_ID > copperLayersToBuild;
+    std::vector< PCB_LAYER_ID > techLayersToBuild;
+
     for( unsigned i = 0; i < arrayDim( cu_seq ); ++i )
         cu_seq[i] = ToLAYER_ID( B_Cu - i );
 
@@ -220,6 +751,11 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
 
         layer_id.push_back( curr_layer_id );
 
+        if( m_layers_container2D.find( curr_layer_id ) != m_layers_container2D.end() )
+            continue;
+
+        copperLayersToBuild.push_back( curr_layer_id );
+
         CBVHCONTAINER2D *layerContainer = new CBVHCONTAINER2D;
         m_layers_container2D[curr_layer_id] = layerContainer;
 
@@ -231,42 +767,32 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
         }
     }
 
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T02: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time ) / 1e3 );
-    start_Time = GetRunningMicroSecs();
-#endif
-
-    if( aStatusTextReporter )
-        aStatusTextReporter->Report( _( "Create tracks and vias" ) );
-
-    // Create tracks as objects and add it to container
+    // Build Tech layers
+    // Based on: https://github.com/KiCad/kicad-source-mirror/blob/master/3d-viewer/3d_draw.cpp#L1059
     // /////////////////////////////////////////////////////////////////////////
-    for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
-    {
-        const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
-
-        wxASSERT( m_layers_container2D.find( curr_layer_id ) != m_layers_container2D.end() );
+    for( LSEQ seq = LSET::AllNonCuMask().Seq( teckLayerList, arrayDim( teckLayerList ) );
+         seq;
+         ++seq )
+    {
+        const PCB_LAYER_ID curr_layer_id = *seq;
 
-        CBVHCONTAINER2D *layerContainer = m_layers_container2D[curr_layer_id];
+        if( !Is3DLayerEnabled( curr_layer_id ) )
+            continue;
 
-        // ADD TRACKS
-        unsigned int nTracks = trackList.size();
+        if( m_layers_container2D.find( curr_layer_id ) != m_layers_container2D.end() )
+            continue;
 
-        for( unsigned int trackIdx = 0; trackIdx < nTracks; ++trackIdx )
-        {
-            const TRACK *track = trackList[trackIdx];
+        techLayersToBuild.push_back( curr_layer_id );
 
-            // NOTE: Vias can be on multiple layers
-            if( !track->IsOnLayer( curr_layer_id ) )
-                continue;
+        CBVHCONTAINER2D *layerContainer = new CBVHCONTAINER2D;
+        m_layers_container2D[curr_layer_id] = layerContainer;
 
-            // Add object item to layer container
-            layerContainer->Add( createNewTrack( track, 0.0f ) );
-        }
+        SHAPE_POLY_SET *layerPoly = new SHAPE_POLY_SET;
+        m_layers_poly[curr_layer_id] = layerPoly;
     }
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T03: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time  ) / 1e3 );
+    printf( "T02: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time ) / 1e3 );
     start_Time = GetRunningMicroSecs();
 #endif
 
@@ -452,40 +978,6 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     start_Time = GetRunningMicroSecs();
 #endif
 
-    // Creates outline contours of the tracks and add it to the poly of the layer
-    // /////////////////////////////////////////////////////////////////////////
-    if( GetFlag( FL_RENDER_OPENGL_COPPER_THICKNESS )
-            && ( m_render_engine == RENDER_ENGINE::OPENGL_LEGACY ) )
-    {
-        for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
-        {
-            const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
-
-            wxASSERT( m_layers_poly.find( curr_layer_id ) != m_layers_poly.end() );
-
-            SHAPE_POLY_SET *layerPoly = m_layers_poly[curr_layer_id];
-
-            // ADD TRACKS
-            unsigned int nTracks = trackList.size();
-
-            for( unsigned int trackIdx = 0; trackIdx < nTracks; ++trackIdx )
-            {
-                const TRACK *track = trackList[trackIdx];
-
-                if( !track->IsOnLayer( curr_layer_id ) )
-                    continue;
-
-                // Add the track contour
-                track->TransformShapeWithClearanceToPolygon( *layerPoly, 0 );
-            }
-        }
-    }
-
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T06: %.3f ms\n", (float)( GetRunningMicroSecs()  - start_Time  ) / 1e3 );
-    start_Time = GetRunningMicroSecs();
-#endif
-
     // Add holes of modules
     // /////////////////////////////////////////////////////////////////////////
     for( auto module : m_board->Modules() )
@@ -551,292 +1043,72 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     start_Time = GetRunningMicroSecs();
 #endif
 
-    // Add modules PADs objects to containers
-    // /////////////////////////////////////////////////////////////////////////
-    for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
-    {
-        const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
-
-        wxASSERT( m_layers_container2D.find( curr_layer_id ) != m_layers_container2D.end() );
-
-        CBVHCONTAINER2D *layerContainer = m_layers_container2D[curr_layer_id];
-
-        // ADD PADS
-        for( auto module : m_board->Modules() )
-        {
-            // Note: NPTH pads are not drawn on copper layers when the pad
-            // has same shape as its hole
-            AddPadsShapesWithClearanceToContainer( module,
-                                                   layerContainer,
-                                                   curr_layer_id,
-                                                   0,
-                                                   true );
-
-            // Micro-wave modules may have items on copper layers
-            AddGraphicsShapesWithClearanceToContainer( module,
-                                                       layerContainer,
-                                                       curr_layer_id,
-                                                       0 );
-        }
-    }
-
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T09: %.3f ms\n", (float)( GetRunningMicroSecs()  - start_Time  ) / 1e3 );
-    start_Time = GetRunningMicroSecs();
-#endif
-
-    // Add modules PADs poly contourns
-    // /////////////////////////////////////////////////////////////////////////
-    if( GetFlag( FL_RENDER_OPENGL_COPPER_THICKNESS )
-            && ( m_render_engine == RENDER_ENGINE::OPENGL_LEGACY ) )
-    {
-        for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
-        {
-            const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
-
-            wxASSERT( m_layers_poly.find( curr_layer_id ) != m_layers_poly.end() );
-
-            SHAPE_POLY_SET *layerPoly = m_layers_poly[curr_layer_id];
-
-            // ADD PADS
-            for( auto module : m_board->Modules() )
-            {
-                // Construct polys
-                // /////////////////////////////////////////////////////////////
-
-                // Note: NPTH pads are not drawn on copper layers when the pad
-                // has same shape as its hole
-                transformPadsShapesWithClearanceToPolygon( module->Pads(),
-                                                           curr_layer_id,
-                                                           *layerPoly,
-                                                           0,
-                                                           true );
-
-                // Micro-wave modules may have items on copper layers
-                module->TransformGraphicTextWithClearanceToPolygonSet(
-                        curr_layer_id, *layerPoly, 0 );
-
-                transformGraphicModuleEdgeToPolygonSet( module, curr_layer_id, *layerPoly );
-            }
-        }
-    }
-
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T10: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time  ) / 1e3 );
-    start_Time = GetRunningMicroSecs();
-#endif
-
-    // Add graphic item on copper layers to object containers
-    // /////////////////////////////////////////////////////////////////////////
-    for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
-    {
-        const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
-
-        wxASSERT( m_layers_container2D.find( curr_layer_id ) != m_layers_container2D.end() );
-
-        CBVHCONTAINER2D *layerContainer = m_layers_container2D[curr_layer_id];
-
-        // ADD GRAPHIC ITEMS ON COPPER LAYERS (texts)
-        for( auto item : m_board->Drawings() )
-        {
-            if( !item->IsOnLayer( curr_layer_id ) )
-                continue;
-
-            switch( item->Type() )
-            {
-            case PCB_LINE_T:
-            {
-                AddShapeWithClearanceToContainer( (DRAWSEGMENT*)item,
-                                                  layerContainer,
-                                                  curr_layer_id,
-                                                  0 );
-            }
-            break;
-
-            case PCB_TEXT_T:
-                AddShapeWithClearanceToContainer( (TEXTE_PCB*) item,
-                                                  layerContainer,
-                                                  curr_layer_id,
-                                                  0 );
-            break;
-
-            case PCB_DIMENSION_T:
-                AddShapeWithClearanceToContainer( (DIMENSION*) item,
-                                                  layerContainer,
-                                                  curr_layer_id,
-                                                  0 );
-            break;
-
-            default:
-                wxLogTrace( m_logTrace,
-                            wxT( "createLayers: item type: %d not implemented" ),
-                            item->Type() );
-            break;
-            }
-        }
-    }
-
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T11: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time  ) / 1e3 );
-    start_Time = GetRunningMicroSecs();
-#endif
 
-    // Add graphic item on copper layers to poly contourns
+    // Build the layers which were not kept, each layer and copper zone as a job
     // /////////////////////////////////////////////////////////////////////////
-    if( GetFlag( FL_RENDER_OPENGL_COPPER_THICKNESS )
-            && ( m_render_engine == RENDER_ENGINE::OPENGL_LEGACY ) )
-    {
-        for( unsigned int lIdx = 0; lIdx < layer_id.size(); ++lIdx )
-        {
-            const PCB_LAYER_ID curr_layer_id = layer_id[lIdx];
-
-            wxASSERT( m_layers_poly.find( curr_layer_id ) != m_layers_poly.end() );
-
-            SHAPE_POLY_SET *layerPoly = m_layers_poly[curr_layer_id];
+    if( aStatusTextReporter )
+        aStatusTextReporter->Report( _( "Create layers" ) );
 
-            // ADD GRAPHIC ITEMS ON COPPER LAYERS (texts)
-            for( auto item : m_board->Drawings() )
-            {
-                if( !item->IsOnLayer( curr_layer_id ) )
-                    continue;
+    std::vector< std::function<void()> > jobs;
 
-                switch( item->Type() )
-                {
-                case PCB_LINE_T:
-                    ( (DRAWSEGMENT*) item )->TransformShapeWithClearanceToPolygon( *layerPoly, 0 );
-                    break;
-
-                case PCB_TEXT_T:
-                    ( (TEXTE_PCB*) item )->TransformShapeWithClearanceToPolygonSet( *layerPoly, 0 );
-                    break;
-
-                default:
-                    wxLogTrace( m_logTrace, wxT( "createLayers: item type: %d not implemented" ),
-                            item->Type() );
-                    break;
-                }
-            }
-        }
-    }
+    for( PCB_LAYER_ID layer : copperLayersToBuild )
+        jobs.emplace_back( [this, layer, &trackList]() { createCopperLayer( layer, trackList ); } );
 
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T12: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time  ) / 1e3 );
-    start_Time = GetRunningMicroSecs();
-#endif
+    for( PCB_LAYER_ID layer : techLayersToBuild )
+        jobs.emplace_back( [this, layer]() { createTechLayer( layer ); } );
 
     if( GetFlag( FL_ZONE ) )
     {
-        if( aStatusTextReporter )
-            aStatusTextReporter->Report( _( "Create zones" ) );
-
-        // Add zones objects
-        // /////////////////////////////////////////////////////////////////////
-        std::atomic<size_t> nextZone( 0 );
-        std::atomic<size_t> threadsFinished( 0 );
-
-        size_t parallelThreadCount = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
-        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-        {
-            std::thread t = std::thread( [&]()
-            {
-                for( size_t areaId = nextZone.fetch_add( 1 );
-                            areaId < static_cast<size_t>( m_board->GetAreaCount() );
-                            areaId = nextZone.fetch_add( 1 ) )
-                {
-                    const ZONE_CONTAINER* zone = m_board->GetArea( areaId );
-
-                    if( zone == nullptr )
-                        break;
-
-                    auto layerContainer = m_layers_container2D.find( zone->GetLayer() );
-
-                    if( layerContainer != m_layers_container2D.end() )
-                        AddSolidAreasShapesToContainer( zone, layerContainer->second,
-                                                        zone->GetLayer() );
-                }
-
-                threadsFinished++;
-            } );
-
-            t.detach();
-        }
-
-        while( threadsFinished < parallelThreadCount )
-            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
-
-    }
-
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "fill zones T13: %.3f ms\n", (float)( GetRunningMicroSecs()  - start_Time  ) / 1e3 );
-    start_Time = GetRunningMicroSecs();
-#endif
-
-    if( GetFlag( FL_ZONE ) && GetFlag( FL_RENDER_OPENGL_COPPER_THICKNESS )
-            && ( m_render_engine == RENDER_ENGINE::OPENGL_LEGACY ) )
-    {
-        // ADD COPPER ZONES
         for( int ii = 0; ii < m_board->GetAreaCount(); ++ii )
         {
             const ZONE_CONTAINER* zone = m_board->GetArea( ii );
 
-            if( zone == nullptr )
-                break;
+            if( std::find( copperLayersToBuild.begin(), copperLayersToBuild.end(),
+                           zone->GetLayer() ) == copperLayersToBuild.end() )
+                continue;
 
-            auto layerContainer = m_layers_poly.find( zone->GetLayer() );
+            CBVHCONTAINER2D* layerContainer = m_layers_container2D[zone->GetLayer()];
 
-            if( layerContainer != m_layers_poly.end() )
-                zone->TransformSolidAreasShapesToPolygonSet( *layerContainer->second );
+            jobs.emplace_back( [this, zone, layerContainer]()
+                               {
+                                   AddSolidAreasShapesToContainer( zone, layerContainer,
+                                                                   zone->GetLayer() );
+                               } );
         }
     }
 
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T14: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time  ) / 1e3 );
-    start_Time = GetRunningMicroSecs();
-#endif
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                   jobs.size() );
+    std::atomic<size_t> nextJob( 0 );
+    std::vector<std::future<size_t>> returns( parallelThreadCount );
 
-    // Simplify layer polygons
-    // /////////////////////////////////////////////////////////////////////////
+    auto build_lambda = [&jobs, &nextJob]() -> size_t
+    {
+        for( size_t i = nextJob++; i < jobs.size(); i = nextJob++ )
+            jobs[i]();
 
-    if( aStatusTextReporter )
-        aStatusTextReporter->Report( _( "Simplifying copper layers polygons" ) );
+        return 1;
+    };
 
-    if( GetFlag( FL_RENDER_OPENGL_COPPER_THICKNESS )
-            && ( m_render_engine == RENDER_ENGINE::OPENGL_LEGACY ) )
+    if( parallelThreadCount <= 1 )
+        build_lambda();
+    else
     {
-        std::atomic<size_t> nextItem( 0 );
-        std::atomic<size_t> threadsFinished( 0 );
-
-        size_t parallelThreadCount = std::min<size_t>(
-                std::max<size_t>( std::thread::hardware_concurrency(), 2 ),
-                layer_id.size() );
         for( size_t ii = 0; ii < parallelThreadCount; ++ii )
-        {
-            std::thread t = std::thread( [&nextItem, &threadsFinished, &layer_id, this]()
-            {
-                for( size_t i = nextItem.fetch_add( 1 );
-                            i < layer_id.size();
-                            i = nextItem.fetch_add( 1 ) )
-                {
-                    auto layerPoly = m_layers_poly.find( layer_id[i] );
-
-                    if( layerPoly != m_layers_poly.end() )
-                        // This will make a union of all added contours
-                        layerPoly->second->Simplify( SHAPE_POLY_SET::PM_FAST );
-                }
-
-                threadsFinished++;
-            } );
-
-            t.detach();
-        }
+            returns[ii] = std::async( std::launch::async, build_lambda );
 
-        while( threadsFinished < parallelThreadCount )
-            std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+        // Finalize the threads
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii].wait();
     }
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T15: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time ) / 1e3 );
-    start_Time = GetRunningMicroSecs();
+    unsigned stats_endLayersTime = GetRunningMicroSecs();
+    printf( "T09: %.3f ms (%zu layers built, %zu kept)\n",
+            (float)( stats_endLayersTime - start_Time ) / 1e3,
+            copperLayersToBuild.size() + techLayersToBuild.size(),
+            layerHashes.size() - copperLayersToBuild.size() - techLayersToBuild.size() );
+    start_Time = stats_endLayersTime;
 #endif
 
     // Simplify holes polygon contours
@@ -863,12 +1135,6 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
         }
     }
 
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    printf( "T16: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time ) / 1e3 );
-#endif
-    // End Build Copper layers
-
-
     // This will make a union of all added contourns
     m_through_inner_holes_poly.Simplify( SHAPE_POLY_SET::PM_FAST );
     m_through_outer_holes_poly.Simplify( SHAPE_POLY_SET::PM_FAST );
@@ -877,208 +1143,9 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     //m_through_inner_holes_vias_poly.Simplify( SHAPE_POLY_SET::PM_FAST ); // Not in use
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
-    unsigned stats_endCopperLayersTime = GetRunningMicroSecs();
-#endif
-
-    // Build Tech layers
-    // Based on: https://github.com/KiCad/kicad-source-mirror/blob/master/3d-viewer/3d_draw.cpp#L1059
-    // /////////////////////////////////////////////////////////////////////////
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    unsigned stats_startTechLayersTime = GetRunningMicroSecs();
-#endif
-
-    if( aStatusTextReporter )
-        aStatusTextReporter->Report( _( "Build Tech layers" ) );
-
-    // draw graphic items, on technical layers
-    static const PCB_LAYER_ID teckLayerList[] = {
-            B_Adhes,
-            F_Adhes,
-            B_Paste,
-            F_Paste,
-            B_SilkS,
-            F_SilkS,
-            B_Mask,
-            F_Mask,
-
-            // Aux Layers
-            Dwgs_User,
-            Cmts_User,
-            Eco1_User,
-            Eco2_User,
-            Edge_Cuts,
-            Margin
-        };
-
-    // User layers are not drawn here, only technical layers
-
-    for( LSEQ seq = LSET::AllNonCuMask().Seq( teckLayerList, arrayDim( teckLayerList ) );
-         seq;
-         ++seq )
-    {
-        const PCB_LAYER_ID curr_layer_id = *seq;
-
-        if( !Is3DLayerEnabled( curr_layer_id ) )
-                    continue;
-
-        CBVHCONTAINER2D *layerContainer = new CBVHCONTAINER2D;
-        m_layers_container2D[curr_layer_id] = layerContainer;
-
-        SHAPE_POLY_SET *layerPoly = new SHAPE_POLY_SET;
-        m_layers_poly[curr_layer_id] = layerPoly;
-
-        // Add drawing objects
-        // /////////////////////////////////////////////////////////////////////
-        for( auto item : m_board->Drawings() )
-        {
-            if( !item->IsOnLayer( curr_layer_id ) )
-                continue;
-
-            switch( item->Type() )
-            {
-            case PCB_LINE_T:
-                AddShapeWithClearanceToContainer( (DRAWSEGMENT*)item,
-                                                  layerContainer,
-                                                  curr_layer_id,
-                                                  0 );
-                break;
-
-            case PCB_TEXT_T:
-                AddShapeWithClearanceToContainer( (TEXTE_PCB*) item,
-                                                  layerContainer,
-                                                  curr_layer_id,
-                                                  0 );
-                break;
-
-            case PCB_DIMENSION_T:
-                AddShapeWithClearanceToContainer( (DIMENSION*) item,
-                                                  layerContainer,
-                                                  curr_layer_id,
-                                                  0 );
-                break;
-
-            default:
-                break;
-            }
-        }
-
-
-        // Add drawing contours
-        // /////////////////////////////////////////////////////////////////////
-        for( auto item : m_board->Drawings() )
-        {
-            if( !item->IsOnLayer( curr_layer_id ) )
-                continue;
-
-            switch( item->Type() )
-            {
-            case PCB_LINE_T:
-                ( (DRAWSEGMENT*) item )->TransformShapeWithClearanceToPolygon( *layerPoly, 0 );
-                break;
-
-            case PCB_TEXT_T:
-                ( (TEXTE_PCB*) item )->TransformShapeWithClearanceToPolygonSet( *layerPoly, 0 );
-                break;
-
-            default:
-                break;
-            }
-        }
-
-
-        // Add modules tech layers - objects
-        // /////////////////////////////////////////////////////////////////////
-        for( auto module : m_board->Modules() )
-        {
-            if( (curr_layer_id == F_SilkS) || (curr_layer_id == B_SilkS) )
-            {
-                int     linewidth = g_DrawDefaultLineThickness;
-
-                for( auto pad : module->Pads() )
-                {
-                    if( !pad->IsOnLayer( curr_layer_id ) )
-                        continue;
-
-                    buildPadShapeThickOutlineAsSegments( pad, layerContainer, linewidth );
-                }
-            }
-            else
-            {
-                AddPadsShapesWithClearanceToContainer(
-                        module, layerContainer, curr_layer_id, 0, false );
-            }
-
-            AddGraphicsShapesWithClearanceToContainer( module, layerContainer, curr_layer_id, 0 );
-        }
-
-
-        // Add modules tech layers - contours
-        // /////////////////////////////////////////////////////////////////////
-        for( auto module : m_board->Modules() )
-        {
-            if( (curr_layer_id == F_SilkS) || (curr_layer_id == B_SilkS) )
-            {
-                const int linewidth = g_DrawDefaultLineThickness;
-
-                for( auto pad : module->Pads() )
-                {
-                    if( !pad->IsOnLayer( curr_layer_id ) )
-                        continue;
-
-                    buildPadShapeThickOutlineAsPolygon( pad, *layerPoly, linewidth );
-                }
-            }
-            else
-            {
-                transformPadsShapesWithClearanceToPolygon(
-                        module->Pads(), curr_layer_id, *layerPoly, 0, false );
-            }
-
-            // On tech layers, use a poor circle approximation, only for texts (stroke font)
-            module->TransformGraphicTextWithClearanceToPolygonSet( curr_layer_id, *layerPoly, 0 );
-
-            // Add the remaining things with dynamic seg count for circles
-            transformGraphicModuleEdgeToPolygonSet( module, curr_layer_id, *layerPoly );
-        }
-
-
-        // Draw non copper zones
-        // /////////////////////////////////////////////////////////////////////
-        if( GetFlag( FL_ZONE ) )
-        {
-            for( int ii = 0; ii < m_board->GetAreaCount(); ++ii )
-            {
-                ZONE_CONTAINER* zone = m_board->GetArea( ii );
-
-                if( !zone->IsOnLayer( curr_layer_id ) )
-                    continue;
-
-                AddSolidAreasShapesToContainer( zone,
-                                                layerContainer,
-                                                curr_layer_id );
-            }
-
-            for( int ii = 0; ii < m_board->GetAreaCount(); ++ii )
-            {
-                ZONE_CONTAINER* zone = m_board->GetArea( ii );
-
-                if( !zone->IsOnLayer( curr_layer_id ) )
-                    continue;
-
-                zone->TransformSolidAreasShapesToPolygonSet( *layerPoly );
-            }
-        }
-
-        // This will make a union of all added contours
-        layerPoly->Simplify( SHAPE_POLY_SET::PM_FAST );
-    }
-    // End Build Tech layers
-
-#ifdef PRINT_STATISTICS_3D_VIEWER
-    unsigned stats_endTechLayersTime = GetRunningMicroSecs();
+    printf( "T10: %.3f ms\n", (float)( GetRunningMicroSecs() - start_Time ) / 1e3 );
 #endif
 
-
     // Build BVH for holes and vias
     // /////////////////////////////////////////////////////////////////////////
 
@@ -1102,23 +1169,23 @@ void CINFO3D_VISU::createLayers( REPORTER *aStatusTextReporter )
     }
 
     // We only need the Solder mask to initialize the BVH
-    // because..?
-    if( (CBVHCONTAINER2D *)m_layers_container2D[B_Mask] )
-        ((CBVHCONTAINER2D *)m_layers_container2D[B_Mask])->BuildBVH();
+    // because..?  Kept layers already have theirs.
+    for( PCB_LAYER_ID layer : techLayersToBuild )
+    {
+        if( ( layer == B_Mask ) || ( layer == F_Mask ) )
+            m_layers_container2D[layer]->BuildBVH();
+    }
 
-    if( (CBVHCONTAINER2D *)m_layers_container2D[F_Mask] )
-        ((CBVHCONTAINER2D *)m_layers_container2D[F_Mask])->BuildBVH();
+    m_layers_hash = layerHashes;
 
 #ifdef PRINT_STATISTICS_3D_VIEWER
     unsigned stats_endHolesBVHTime = GetRunningMicroSecs();
 
     printf( "CINFO3D_VISU::createLayers times\n" );
-    printf( "  Copper Layers:          %.3f ms\n",
-            (float)( stats_endCopperLayersTime  - stats_startCopperLayersTime  ) / 1e3 );
+    printf( "  Layers:                 %.3f ms\n",
+            (float)( stats_endLayersTime        - stats_startCopperLayersTime  ) / 1e3 );
     printf( "  Holes BVH creation:     %.3f ms\n",
             (float)( stats_endHolesBVHTime      - stats_startHolesBVHTime      ) / 1e3 );
-    printf( "  Tech Layers:            %.3f ms\n",
-            (float)( stats_endTechLayersTime    - stats_startTechLayersTime    ) / 1e3 );
     printf( "Statistics:\n" );
     printf( "  m_stats_nr_tracks                   %u\n", m_stats_nr_tracks );
     printf( "  m_stats_nr_vias                     %u\n", m_stats_nr_vias );
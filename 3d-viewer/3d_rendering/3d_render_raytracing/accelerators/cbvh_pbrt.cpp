@@ -67,12 +67,22 @@
  */
 
 #include "cbvh_pbrt.h"
+#include "../shapes3D/ctriangle.h"
 #include "../../../3d_fastmath.h"
 #include <boost/range/algorithm/nth_element.hpp>
 #include <boost/range/algorithm/partition.hpp>
+#include <algorithm>
 #include <cstdlib>
+#include <cstring>
+#include <limits>
 #include <vector>
 
+// SSE2 is always available on x86-64, the scalar versions are used elsewhere
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+#define BVH_USE_SSE
+#include <emmintrin.h>
+#endif
+
 #include <stack>
 #include <wx/debug.h>
 
@@ -304,6 +314,11 @@ CBVH_PBRT::CBVH_PBRT( const CGENERICCONTAINER &aObjectContainer,
 
     wxASSERT( offset == (unsigned int)totalNodes );
 
+    // Single rays are traced on a four-wide copy of the tree, ray packets still use the
+    // binary one, which the hit info refers to (m_acc_node_info)
+    m_nodes4.reserve( totalNodes / 3 + 1 );
+    collapseBVH4( 0 );
+
 #ifdef PRINT_STATISTICS_3D_VIEWER
     uint32_t treeBytes = totalNodes * sizeof( LinearBVHNode ) + sizeof( *this ) +
                          m_primitives.size() * sizeof( m_primitives[0] ) +
@@ -1132,67 +1147,460 @@ int CBVH_PBRT::flattenBVHTree( BVHBuildNode *node, uint32_t *offset )
 }
 
 
+int CBVH_PBRT::addLeafTriangles( const LinearBVHNode &aLeaf )
+{
+    if( aLeaf.nPrimitives > 4 )
+        return -1;
+
+    TRIANGLE4 triangles;
+
+    memset( &triangles, 0, sizeof( triangles ) );
+
+    for( int i = 0; i < aLeaf.nPrimitives; ++i )
+    {
+        const COBJECT *obj = m_primitives[aLeaf.primitivesOffset + i];
+
+        if( obj->GetObjectType() != OBJECT3D_TYPE::TRIANGLE )
+            continue;
+
+        const CTRIANGLE *triangle = static_cast<const CTRIANGLE *>( obj );
+        const SFVEC3F   &v0 = triangle->GetVertex( 0 );
+        const SFVEC3F    e1 = triangle->GetVertex( 1 ) - v0;
+        const SFVEC3F    e2 = triangle->GetVertex( 2 ) - v0;
+
+        for( int axis = 0; axis < 3; ++axis )
+        {
+            triangles.v0[axis][i] = v0[axis];
+            triangles.e1[axis][i] = e1[axis];
+            triangles.e2[axis][i] = e2[axis];
+        }
+
+        triangles.mask |= 1 << i;
+    }
+
+    if( triangles.mask == 0 )
+        return -1;
+
+    m_triangles4.push_back( triangles );
+
+    return m_triangles4.size() - 1;
+}
+
+
+int CBVH_PBRT::collapseBVH4( int aNodeNum )
+{
+    // Gather the (up to four) grandchildren of the node, keeping the leaves found on the way
+    int children[4];
+    int nChildren = 0;
+
+    const LinearBVHNode &node = m_nodes[aNodeNum];
+
+    if( node.nPrimitives > 0 )
+    {
+        // Only for a root leaf
+        children[nChildren++] = aNodeNum;
+    }
+    else
+    {
+        const int pair[2] = { aNodeNum + 1, node.secondChildOffset };
+
+        for( int child : pair )
+        {
+            if( m_nodes[child].nPrimitives > 0 )
+            {
+                children[nChildren++] = child;
+            }
+            else
+            {
+                children[nChildren++] = child + 1;
+                children[nChildren++] = m_nodes[child].secondChildOffset;
+            }
+        }
+    }
+
+    const int myOffset = m_nodes4.size();
+
+    m_nodes4.emplace_back();
+    m_nodes4[myOffset].mask = ( 1 << nChildren ) - 1;
+
+    for( int i = 0; i < 4; ++i )
+    {
+        // m_nodes4 grows with the recursion, so do not keep a reference to the node
+        if( i >= nChildren )
+        {
+            // An empty box at infinity.  It can still be "hit" by a ray without maximum
+            // distance, so the lane is also left out of the mask of the node
+            for( int axis = 0; axis < 3; ++axis )
+            {
+                m_nodes4[myOffset].boundsMin[axis][i] = std::numeric_limits<float>::infinity();
+                m_nodes4[myOffset].boundsMax[axis][i] = std::numeric_limits<float>::infinity();
+            }
+
+            m_nodes4[myOffset].childOffset[i] = -1;
+            m_nodes4[myOffset].triangles[i] = -1;
+            m_nodes4[myOffset].nPrimitives[i] = 0;
+
+            continue;
+        }
+
+        const LinearBVHNode &child = m_nodes[children[i]];
+
+        for( int axis = 0; axis < 3; ++axis )
+        {
+            m_nodes4[myOffset].boundsMin[axis][i] = child.bounds.Min()[axis];
+            m_nodes4[myOffset].boundsMax[axis][i] = child.bounds.Max()[axis];
+        }
+
+        if( child.nPrimitives > 0 )
+        {
+            const int triangles = addLeafTriangles( child );
+
+            m_nodes4[myOffset].childOffset[i] = children[i];
+            m_nodes4[myOffset].triangles[i] = triangles;
+            m_nodes4[myOffset].nPrimitives[i] = child.nPrimitives;
+        }
+        else
+        {
+            const int childOffset = collapseBVH4( children[i] );
+
+            m_nodes4[myOffset].childOffset[i] = childOffset;
+            m_nodes4[myOffset].triangles[i] = -1;
+            m_nodes4[myOffset].nPrimitives[i] = 0;
+        }
+    }
+
+    return myOffset;
+}
+
+
+/// Tolerance of the triangle filter, which must never discard a triangle that the
+/// (differently computed) CTRIANGLE intersection would hit
+#define TRIANGLE4_EPSILON 1e-4f
+
+#ifdef BVH_USE_SSE
+
+/**
+ * @brief intersectBounds4 - test a ray against the four children bounds of a node
+ * @param aNode: the node
+ * @param aRay: the ray
+ * @param aMaxT: the distance of the nearest hit so far
+ * @param aTNear: returns the entry distance of each child
+ * @return the mask of the children hit nearer than aMaxT (unused lanes are never set)
+ */
+static inline int intersectBounds4( const LinearBVH4Node &aNode, const RAY &aRay,
+                                    float aMaxT, float *aTNear )
+{
+    __m128 tNear = _mm_setzero_ps();
+    __m128 tFar  = _mm_set1_ps( aMaxT );
+
+    // Rounding compensation of the far distance, as in PBRT
+    const __m128 farScale = _mm_set1_ps( 1.0f + 2.0f * 3.0f * 0.5f * FLT_EPSILON );
+
+    for( int axis = 0; axis < 3; ++axis )
+    {
+        const __m128 org = _mm_set1_ps( aRay.m_Origin[axis] );
+        const __m128 inv = _mm_set1_ps( aRay.m_InvDir[axis] );
+
+        const __m128 t0 = _mm_mul_ps( _mm_sub_ps( _mm_loadu_ps( aNode.boundsMin[axis] ), org ),
+                                      inv );
+        const __m128 t1 = _mm_mul_ps( _mm_sub_ps( _mm_loadu_ps( aNode.boundsMax[axis] ), org ),
+                                      inv );
+
+        // _mm_max_ps / _mm_min_ps return the second operand on a NaN, so a ray lying in
+        // a slab plane keeps the current range
+        tNear = _mm_max_ps( _mm_min_ps( t0, t1 ), tNear );
+        tFar  = _mm_min_ps( _mm_mul_ps( _mm_max_ps( t0, t1 ), farScale ), tFar );
+    }
+
+    _mm_storeu_ps( aTNear, tNear );
+
+    return _mm_movemask_ps( _mm_cmple_ps( tNear, tFar ) ) & aNode.mask;
+}
+
+
+/**
+ * @brief intersectTriangle4 - Moller-Trumbore test of a ray against four triangles
+ * @return the mask of the triangles which may be hit nearer than aMaxT
+ */
+static inline int intersectTriangle4( const TRIANGLE4 &aTriangles, const RAY &aRay,
+                                      float aMaxT )
+{
+    const __m128 dx = _mm_set1_ps( aRay.m_Dir.x );
+    const __m128 dy = _mm_set1_ps( aRay.m_Dir.y );
+    const __m128 dz = _mm_set1_ps( aRay.m_Dir.z );
+
+    const __m128 e1x = _mm_loadu_ps( aTriangles.e1[0] );
+    const __m128 e1y = _mm_loadu_ps( aTriangles.e1[1] );
+    const __m128 e1z = _mm_loadu_ps( aTriangles.e1[2] );
+
+    const __m128 e2x = _mm_loadu_ps( aTriangles.e2[0] );
+    const __m128 e2y = _mm_loadu_ps( aTriangles.e2[1] );
+    const __m128 e2z = _mm_loadu_ps( aTriangles.e2[2] );
+
+    // p = d x e2
+    const __m128 px = _mm_sub_ps( _mm_mul_ps( dy, e2z ), _mm_mul_ps( dz, e2y ) );
+    const __m128 py = _mm_sub_ps( _mm_mul_ps( dz, e2x ), _mm_mul_ps( dx, e2z ) );
+    const __m128 pz = _mm_sub_ps( _mm_mul_ps( dx, e2y ), _mm_mul_ps( dy, e2x ) );
+
+    const __m128 det = _mm_add_ps( _mm_add_ps( _mm_mul_ps( e1x, px ), _mm_mul_ps( e1y, py ) ),
+                                   _mm_mul_ps( e1z, pz ) );
+    const __m128 invDet = _mm_div_ps( _mm_set1_ps( 1.0f ), det );
+
+    // s = o - v0
+    const __m128 sx = _mm_sub_ps( _mm_set1_ps( aRay.m_Origin.x ),
+                                  _mm_loadu_ps( aTriangles.v0[0] ) );
+    const __m128 sy = _mm_sub_ps( _mm_set1_ps( aRay.m_Origin.y ),
+                                  _mm_loadu_ps( aTriangles.v0[1] ) );
+    const __m128 sz = _mm_sub_ps( _mm_set1_ps( aRay.m_Origin.z ),
+                                  _mm_loadu_ps( aTriangles.v0[2] ) );
+
+    const __m128 u = _mm_mul_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( sx, px ),
+                                                         _mm_mul_ps( sy, py ) ),
+                                             _mm_mul_ps( sz, pz ) ),
+                                 invDet );
+
+    // q = s x e1
+    const __m128 qx = _mm_sub_ps( _mm_mul_ps( sy, e1z ), _mm_mul_ps( sz, e1y ) );
+    const __m128 qy = _mm_sub_ps( _mm_mul_ps( sz, e1x ), _mm_mul_ps( sx, e1z ) );
+    const __m128 qz = _mm_sub_ps( _mm_mul_ps( sx, e1y ), _mm_mul_ps( sy, e1x ) );
+
+    const __m128 v = _mm_mul_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( dx, qx ),
+                                                         _mm_mul_ps( dy, qy ) ),
+                                             _mm_mul_ps( dz, qz ) ),
+                                 invDet );
+
+    const __m128 t = _mm_mul_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( e2x, qx ),
+                                                         _mm_mul_ps( e2y, qy ) ),
+                                             _mm_mul_ps( e2z, qz ) ),
+                                 invDet );
+
+    // Only the lanes proven to miss are rejected, so NaN (degenerated) lanes are kept
+    const __m128 minusEps = _mm_set1_ps( -TRIANGLE4_EPSILON );
+
+    __m128 reject = _mm_cmplt_ps( u, minusEps );
+
+    reject = _mm_or_ps( reject, _mm_cmplt_ps( v, minusEps ) );
+    reject = _mm_or_ps( reject, _mm_cmpgt_ps( _mm_add_ps( u, v ),
+                                              _mm_set1_ps( 1.0f + TRIANGLE4_EPSILON ) ) );
+    reject = _mm_or_ps( reject, _mm_cmplt_ps( t, minusEps ) );
+    reject = _mm_or_ps( reject, _mm_cmpgt_ps( t, _mm_set1_ps( aMaxT *
+                                                              ( 1.0f + TRIANGLE4_EPSILON ) ) ) );
+
+    return ~_mm_movemask_ps( reject ) & 0xF;
+}
+
+#else
+
+static inline int intersectBounds4( const LinearBVH4Node &aNode, const RAY &aRay,
+                                    float aMaxT, float *aTNear )
+{
+    const float farScale = 1.0f + 2.0f * 3.0f * 0.5f * FLT_EPSILON;
+    int mask = 0;
+
+    for( int i = 0; i < 4; ++i )
+    {
+        if( !( aNode.mask & ( 1 << i ) ) )
+            continue;
+
+        float tNear = 0.0f;
+        float tFar  = aMaxT;
+
+        for( int axis = 0; axis < 3; ++axis )
+        {
+            const float t0 = ( aNode.boundsMin[axis][i] - aRay.m_Origin[axis] ) *
+                             aRay.m_InvDir[axis];
+            const float t1 = ( aNode.boundsMax[axis][i] - aRay.m_Origin[axis] ) *
+                             aRay.m_InvDir[axis];
+
+            // Written so a NaN keeps the current range, like the SSE version
+            const float tMin = ( t0 < t1 ) ? t0 : t1;
+            const float tMax = ( ( t0 > t1 ) ? t0 : t1 ) * farScale;
+
+            tNear = ( tMin > tNear ) ? tMin : tNear;
+            tFar  = ( tMax < tFar ) ? tMax : tFar;
+        }
+
+        aTNear[i] = tNear;
+
+        if( tNear <= tFar )
+            mask |= 1 << i;
+    }
+
+    return mask;
+}
+
+
+static inline int intersectTriangle4( const TRIANGLE4 &aTriangles, const RAY &aRay,
+                                      float aMaxT )
+{
+    int mask = 0;
+
+    for( int i = 0; i < 4; ++i )
+    {
+        const SFVEC3F v0( aTriangles.v0[0][i], aTriangles.v0[1][i], aTriangles.v0[2][i] );
+        const SFVEC3F e1( aTriangles.e1[0][i], aTriangles.e1[1][i], aTriangles.e1[2][i] );
+        const SFVEC3F e2( aTriangles.e2[0][i], aTriangles.e2[1][i], aTriangles.e2[2][i] );
+
+        const SFVEC3F p = glm::cross( aRay.m_Dir, e2 );
+        const float invDet = 1.0f / glm::dot( e1, p );
+        const SFVEC3F s = aRay.m_Origin - v0;
+        const float u = glm::dot( s, p ) * invDet;
+        const SFVEC3F q = glm::cross( s, e1 );
+        const float v = glm::dot( aRay.m_Dir, q ) * invDet;
+        const float t = glm::dot( e2, q ) * invDet;
+
+        if( ( u < -TRIANGLE4_EPSILON ) || ( v < -TRIANGLE4_EPSILON )
+          || ( ( u + v ) > 1.0f + TRIANGLE4_EPSILON )
+          || ( t < -TRIANGLE4_EPSILON ) || ( t > aMaxT * ( 1.0f + TRIANGLE4_EPSILON ) ) )
+            continue;
+
+        mask |= 1 << i;
+    }
+
+    return mask;
+}
+
+#endif
+
+
+bool CBVH_PBRT::intersectLeaf( int aNodeNum, int aTriangles, const RAY &aRay,
+                               HITINFO &aHitInfo ) const
+{
+    const LinearBVHNode &leaf = m_nodes[aNodeNum];
+    int skip = 0;
+
+    if( aTriangles >= 0 )
+    {
+        const TRIANGLE4 &triangles = m_triangles4[aTriangles];
+
+        skip = triangles.mask & ~intersectTriangle4( triangles, aRay, aHitInfo.m_tHit );
+    }
+
+    bool hit = false;
+
+    for( int i = 0; i < leaf.nPrimitives; ++i )
+    {
+        if( ( i < 4 ) && ( skip & ( 1 << i ) ) )
+            continue;
+
+        if( m_primitives[leaf.primitivesOffset + i]->Intersect( aRay, aHitInfo ) )
+        {
+            aHitInfo.m_acc_node_info = aNodeNum;
+            hit = true;
+        }
+    }
+
+    return hit;
+}
+
+
+bool CBVH_PBRT::intersectLeafP( int aNodeNum, int aTriangles, const RAY &aRay,
+                                float aMaxDistance ) const
+{
+    const LinearBVHNode &leaf = m_nodes[aNodeNum];
+    int skip = 0;
+
+    if( aTriangles >= 0 )
+    {
+        const TRIANGLE4 &triangles = m_triangles4[aTriangles];
+
+        skip = triangles.mask & ~intersectTriangle4( triangles, aRay, aMaxDistance );
+    }
+
+    for( int i = 0; i < leaf.nPrimitives; ++i )
+    {
+        if( ( i < 4 ) && ( skip & ( 1 << i ) ) )
+            continue;
+
+        const COBJECT *obj = m_primitives[leaf.primitivesOffset + i];
+
+        if( obj->GetMaterial()->GetCastShadows() )
+            if( obj->IntersectP( aRay, aMaxDistance ) )
+                return true;
+    }
+
+    return false;
+}
+
+
 #define MAX_TODOS 64
 
+/// Each four-wide node visited pushes up to three children more than it pops
+#define MAX_TODOS4 ( 3 * MAX_TODOS / 2 + 4 )
+
+struct BVH4_TODO
+{
+    int     nodeNum;
+    float   tNear;
+};
+
+
 bool CBVH_PBRT::Intersect( const RAY &aRay, HITINFO &aHitInfo ) const
 {
-    if( !m_nodes )
+    if( m_nodes4.empty() )
         return false;
 
     bool hit = false;
 
     // Follow ray through BVH nodes to find primitive intersections
-    int todoOffset = 0, nodeNum = 0;
-    int todo[MAX_TODOS];
+    int todoOffset = 0;
+    BVH4_TODO todo[MAX_TODOS4];
 
-    while( true )
+    todo[todoOffset++] = { 0, 0.0f };
+
+    while( todoOffset > 0 )
     {
-        const LinearBVHNode *node = &m_nodes[nodeNum];
+        const BVH4_TODO current = todo[--todoOffset];
 
-        wxASSERT( todoOffset < MAX_TODOS );
+        // A nearer hit may have been found since the node was pushed
+        if( current.tNear >= aHitInfo.m_tHit )
+            continue;
 
-        // Check ray against BVH node
-        float hitBox = 0.0f;
+        const LinearBVH4Node &node = m_nodes4[current.nodeNum];
 
-        const bool hitted = node->bounds.Intersect( aRay, &hitBox );
+        float tNear[4];
+        int   mask = intersectBounds4( node, aRay, aHitInfo.m_tHit, tNear );
 
-        if( hitted && (hitBox < aHitInfo.m_tHit) )
-        {
-            if( node->nPrimitives > 0 )
-            {
-                // Intersect ray with primitives in leaf BVH node
-                for( int i = 0; i < node->nPrimitives; ++i )
-                {
-                    if( m_primitives[node->primitivesOffset + i]->Intersect( aRay,
-                                                                             aHitInfo ) )
-                    {
-                        aHitInfo.m_acc_node_info = nodeNum;
-                        hit = true;
-                    }
-                }
-            }
-            else
-            {
-                // Put far BVH node on _todo_ stack, advance to near node
-                if( aRay.m_dirIsNeg[node->axis] )
-                {
-                    todo[todoOffset++] = nodeNum + 1;
-                    nodeNum = node->secondChildOffset;
-                }
-                else
-                {
-                    todo[todoOffset++] = node->secondChildOffset;
-                    nodeNum = nodeNum + 1;
-                }
+        // Sort the children hit from near to far
+        int order[4];
+        int nHits = 0;
 
+        for( int i = 0; i < 4; ++i )
+        {
+            if( !( mask & ( 1 << i ) ) )
                 continue;
-            }
+
+            int j = nHits++;
+
+            for( ; ( j > 0 ) && ( tNear[order[j - 1]] > tNear[i] ); --j )
+                order[j] = order[j - 1];
+
+            order[j] = i;
         }
 
-        if( todoOffset == 0 )
-            break;
+        // Intersect the leaves first, as they shrink the distance to search, then put the
+        // interior children on the stack with the nearest on top
+        int interior[4];
+        int nInterior = 0;
 
-        nodeNum = todo[--todoOffset];
+        for( int k = 0; k < nHits; ++k )
+        {
+            const int i = order[k];
+
+            if( node.nPrimitives[i] == 0 )
+                interior[nInterior++] = i;
+            else if( tNear[i] < aHitInfo.m_tHit )
+                hit |= intersectLeaf( node.childOffset[i], node.triangles[i], aRay, aHitInfo );
+        }
+
+        wxASSERT( todoOffset + nInterior <= MAX_TODOS4 );
+
+        while( nInterior > 0 )
+        {
+            const int i = interior[--nInterior];
+
+            todo[todoOffset++] = { node.childOffset[i], tNear[i] };
+        }
     }
 
     return hit;
@@ -1268,60 +1676,40 @@ bool CBVH_PBRT::Intersect( const RAY &aRay,
 
 bool CBVH_PBRT::IntersectP( const RAY &aRay, float aMaxDistance ) const
 {
-    if( !m_nodes )
+    if( m_nodes4.empty() )
         return false;
 
-    // Follow ray through BVH nodes to find primitive intersections
-    int todoOffset = 0, nodeNum = 0;
-    int todo[MAX_TODOS];
+    // Any hit will do, so the children are visited in their order
+    int todoOffset = 0;
+    int todo[MAX_TODOS4];
 
-    while( true )
-    {
-        const LinearBVHNode *node = &m_nodes[nodeNum];
-
-        wxASSERT( todoOffset < MAX_TODOS );
+    todo[todoOffset++] = 0;
 
-        // Check ray against BVH node
-        float hitBox = 0.0f;
+    while( todoOffset > 0 )
+    {
+        const LinearBVH4Node &node = m_nodes4[todo[--todoOffset]];
 
-        const bool hitted = node->bounds.Intersect( aRay, &hitBox );
+        float tNear[4];
+        const int mask = intersectBounds4( node, aRay, aMaxDistance, tNear );
 
-        if( hitted && (hitBox < aMaxDistance) )
+        for( int i = 0; i < 4; ++i )
         {
-            if( node->nPrimitives > 0 )
-            {
-                // Intersect ray with primitives in leaf BVH node
-                for( int i = 0; i < node->nPrimitives; ++i )
-                {
-                    const COBJECT *obj = m_primitives[node->primitivesOffset + i];
+            if( !( mask & ( 1 << i ) ) )
+                continue;
 
-                    if( obj->GetMaterial()->GetCastShadows() )
-                        if( obj->IntersectP( aRay, aMaxDistance ) )
-                            return true;
-                }
+            if( node.nPrimitives[i] > 0 )
+            {
+                if( intersectLeafP( node.childOffset[i], node.triangles[i], aRay,
+                                    aMaxDistance ) )
+                    return true;
             }
             else
             {
-                // Put far BVH node on _todo_ stack, advance to near node
-                if( aRay.m_dirIsNeg[node->axis] )
-                {
-                    todo[todoOffset++] = nodeNum + 1;
-                    nodeNum = node->secondChildOffset;
-                }
-                else
-                {
-                    todo[todoOffset++] = node->secondChildOffset;
-                    nodeNum = nodeNum + 1;
-                }
+                wxASSERT( todoOffset < MAX_TODOS4 );
 
-                continue;
+                todo[todoOffset++] = node.childOffset[i];
             }
         }
-
-        if( todoOffset == 0 )
-            break;
-
-        nodeNum = todo[--todoOffset];
     }
 
     return false;
@@ -73,6 +73,7 @@
 #include "caccelerator.h"
 #include <cstdint>
 #include <list>
+#include <vector>
 
 // Forward Declarations
 struct BVHBuildNode;
@@ -98,6 +99,37 @@ struct LinearBVHNode
 };
 
 
+/**
+ * A node of the four-wide BVH, made by collapsing two levels of the binary tree.  The bounds
+ * of its children are stored by axis so a ray is tested against the four boxes at once.
+ */
+struct LinearBVH4Node
+{
+    float    boundsMin[3][4];
+    float    boundsMax[3][4];
+
+    int      childOffset[4];  ///< interior: LinearBVH4Node index, leaf: LinearBVHNode index
+    int      triangles[4];    ///< leaf: index of its TRIANGLE4, -1 if none
+    uint16_t nPrimitives[4];  ///< 0 -> interior child (or unused if childOffset < 0)
+
+    uint8_t  mask;            ///< lanes holding a child
+};
+
+
+/**
+ * The triangles of a leaf with up to four primitives, stored by lane for the four-wide
+ * ray / triangle test used to skip the primitives a ray cannot hit.
+ */
+struct TRIANGLE4
+{
+    float    v0[3][4];
+    float    e1[3][4];
+    float    e2[3][4];
+
+    uint8_t  mask;            ///< lanes holding a triangle
+};
+
+
 enum class SPLITMETHOD
 {
     MIDDLE,
@@ -151,12 +183,31 @@ private:
     int flattenBVHTree( BVHBuildNode *node,
                         uint32_t *offset );
 
+    /**
+     * @brief collapseBVH4 - build the four-wide node of a binary node
+     * @param aNodeNum: the index of the binary node in m_nodes
+     * @return the index of the created node in m_nodes4
+     */
+    int collapseBVH4( int aNodeNum );
+
+    int addLeafTriangles( const LinearBVHNode &aLeaf );
+
+    bool intersectLeaf( int aNodeNum, int aTriangles, const RAY &aRay,
+                        HITINFO &aHitInfo ) const;
+
+    bool intersectLeafP( int aNodeNum, int aTriangles, const RAY &aRay,
+                         float aMaxDistance ) const;
+
     // BVH Private Data
     const int           m_maxPrimsInNode;
     SPLITMETHOD         m_splitMethod;
     CONST_VECTOR_OBJECT m_primitives;
     LinearBVHNode       *m_nodes;
 
+    // Four-wide layout of m_nodes, used to trace single rays
+    std::vector<LinearBVH4Node> m_nodes4;
+    std::vector<TRIANGLE4>      m_triangles4;
+
     std::list<void *> m_addresses_pointer_to_mm_free;
 
     // Partition traversal
@@ -1255,6 +1255,24 @@ void C3D_RENDER_RAYTRACING::add_3D_vias_and_pads_to_container()
 
 void C3D_RENDER_RAYTRACING::load_3D_models()
 {
+    // Offscreen renders may run without any 3D model cache
+    if( !m_settings.Get3DCacheManager() )
+        return;
+
+    // Load all the model files at once, so they are parsed in parallel
+    std::vector<wxString> modelFiles;
+
+    for( auto module : m_settings.GetBoard()->Modules() )
+    {
+        if( m_settings.ShouldModuleBeDisplayed( (MODULE_ATTR_T)module->GetAttributes() ) )
+        {
+            for( const MODULE_3D_SETTINGS& model : module->Models() )
+                modelFiles.push_back( model.m_Filename );
+        }
+    }
+
+    m_settings.Get3DCacheManager()->LoadModels( modelFiles );
+
     // Go for all modules
     for( auto module : m_settings.GetBoard()->Modules() )
     {
@@ -34,6 +34,8 @@
 #include <climits>
 #include <thread>
 
+#include <wx/image.h>
+
 #include "c3d_render_raytracing.h"
 #include "mortoncodes.h"
 #include "../ccolorrgb.h"
@@ -166,6 +168,7 @@ bool C3D_RENDER_RAYTRACING::Redraw(
         // revert to preview mode the first time the Redraw is called
         m_oldWindowsSize = m_windowSize;
         initialize_block_positions();
+        opengl_init_pbo();
     }
 
     std::unique_ptr<BUSY_INDICATOR> busy = CreateBusyIndicator();
@@ -192,6 +195,7 @@ bool C3D_RENDER_RAYTRACING::Redraw(
         requestRedraw = true;
 
         initialize_block_positions();
+        opengl_init_pbo();
     }
 
 
@@ -299,6 +303,88 @@ bool C3D_RENDER_RAYTRACING::Redraw(
 }
 
 
+bool C3D_RENDER_RAYTRACING::RenderOffscreen( const wxSize &aSize, wxImage &aImage,
+                                             REPORTER* aStatusTextReporter,
+                                             REPORTER* aWarningTextReporter )
+{
+    wxCHECK_MSG( ( aSize.x > 0 ) && ( aSize.y > 0 ), false, wxT( "Invalid image size" ) );
+
+    if( m_reloadRequested )
+    {
+        if( aStatusTextReporter )
+            aStatusTextReporter->Report( _( "Loading..." ) );
+
+        reload( aStatusTextReporter, aWarningTextReporter );
+    }
+
+    // The traced area is the window size reduced to whole ray packets, so grow the window
+    // until it covers the image, which is then cropped from the center of the traced area.
+    const wxSize windowSize = m_windowSize;
+
+    m_windowSize = aSize;
+
+    while( true )
+    {
+        initialize_block_positions();
+
+        if( ( m_realBufferSize.x >= (unsigned int)aSize.x ) &&
+            ( m_realBufferSize.y >= (unsigned int)aSize.y ) )
+            break;
+
+        if( m_realBufferSize.x < (unsigned int)aSize.x )
+            m_windowSize.x += RAYPACKET_DIM;
+
+        if( m_realBufferSize.y < (unsigned int)aSize.y )
+            m_windowSize.y += RAYPACKET_DIM;
+    }
+
+    // The on screen buffers must be reinitialized by the next Redraw()
+    m_oldWindowsSize = wxSize( -1, -1 );
+
+    m_settings.CameraGet().SetCurWindowSize( m_windowSize );
+
+    std::vector<GLubyte> buffer( m_realBufferSize.x * m_realBufferSize.y * 4 );
+
+    // Restart and run the progressive render up to the end, as Redraw() would do
+    m_rt_render_state = RT_RENDER_STATE_MAX;
+
+    do
+    {
+        render( buffer.data(), aStatusTextReporter );
+    } while( m_rt_render_state != RT_RENDER_STATE_FINISH );
+
+    // Back to the on screen size, if any (the camera too, as the image was rendered with it)
+    m_windowSize = windowSize;
+
+    if( ( m_windowSize.x > 0 ) && ( m_windowSize.y > 0 ) )
+        m_settings.CameraGet().SetCurWindowSize( m_windowSize );
+
+    // The buffer is stored bottom-up, as expected by glDrawPixels
+    if( !aImage.Create( aSize.x, aSize.y, false ) )
+        return false;
+
+    const unsigned int x0 = ( m_realBufferSize.x - aSize.x ) / 2;
+    const unsigned int y0 = ( m_realBufferSize.y - aSize.y ) / 2;
+    unsigned char *dst = aImage.GetData();
+
+    for( unsigned int y = 0; y < (unsigned int)aSize.y; ++y )
+    {
+        const unsigned int srcY = m_realBufferSize.y - 1 - ( y0 + y );
+        const GLubyte *src = &buffer[ ( srcY * m_realBufferSize.x + x0 ) * 4 ];
+
+        for( unsigned int x = 0; x < (unsigned int)aSize.x; ++x )
+        {
+            *dst++ = src[0];
+            *dst++ = src[1];
+            *dst++ = src[2];
+            src += 4;
+        }
+    }
+
+    return true;
+}
+
+
 void C3D_RENDER_RAYTRACING::render( GLubyte *ptrPBO , REPORTER *aStatusTextReporter )
 {
     if( (m_rt_render_state == RT_RENDER_STATE_FINISH) ||
@@ -2154,6 +2240,4 @@ void C3D_RENDER_RAYTRACING::initialize_block_positions()
     // Create m_shader buffer
     delete[] m_shaderBuffer;
     m_shaderBuffer = new SFVEC3F[m_realBufferSize.x * m_realBufferSize.y];
-
-    opengl_init_pbo();
 }
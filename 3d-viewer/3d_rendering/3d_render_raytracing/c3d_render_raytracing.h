@@ -47,6 +47,8 @@ typedef std::vector< CBLINN_PHONG_MATERIAL > MODEL_MATERIALS;
 /// Maps a S3DMODEL pointer with a created CBLINN_PHONG_MATERIAL vector
 typedef std::map< const S3DMODEL * , MODEL_MATERIALS > MAP_MODEL_MATERIALS;
 
+class wxImage;
+
 typedef enum
 {
     RT_RENDER_STATE_TRACING = 0,
@@ -70,6 +72,20 @@ public:
 
     int GetWaitForEditingTimeOut() override;
 
+    /**
+     * @brief RenderOffscreen - Render the full quality image, with all the render passes,
+     * without using OpenGL, so it can be used without a canvas (batch or headless renders).
+     * The tracing is done by blocks using all the cores, like the on screen render.
+     * @param aSize: the size of the image, in pixels
+     * @param aImage: the image to create
+     * @param aStatusTextReporter: a pointer to the status progress reporter
+     * @param aWarningTextReporter: a pointer to the warning reporter
+     * @return true if the image was rendered
+     */
+    bool RenderOffscreen( const wxSize &aSize, wxImage &aImage,
+                          REPORTER* aStatusTextReporter = NULL,
+                          REPORTER* aWarningTextReporter = NULL );
+
 private:
     bool initializeOpenGL();
     void initializeNewWindowSize();
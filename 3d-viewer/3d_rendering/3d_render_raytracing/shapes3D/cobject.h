@@ -62,6 +62,8 @@ public:
     void SetMaterial( const CMATERIAL *aMaterial ) { m_material = aMaterial; }
     const CMATERIAL *GetMaterial() const { return m_material; }
 
+    OBJECT3D_TYPE GetObjectType() const { return m_obj_type; }
+
     virtual SFVEC3F GetDiffuseColor( const HITINFO &aHitInfo ) const = 0;
 
     virtual ~COBJECT() {}
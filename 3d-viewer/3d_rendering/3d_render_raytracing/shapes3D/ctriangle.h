@@ -63,6 +63,8 @@ public:
 
     void SetUV( const SFVEC2F &aUV1, const SFVEC2F &aUV2, const SFVEC2F &aUV3 );
 
+    const SFVEC3F &GetVertex( unsigned int aIndex ) const { return m_vertex[aIndex]; }
+
     // Imported from COBJECT
     bool Intersect( const RAY &aRay, HITINFO &aHitInfo ) const override;
     bool IntersectP(const RAY &aRay , float aMaxDistance ) const override;
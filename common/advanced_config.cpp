@@ -87,6 +87,39 @@ static const wxChar RealtimeConnectivity[] = wxT( "RealtimeConnectivity" );
  */
 static const wxChar CoroutineStackSize[] = wxT( "CoroutineStackSize" );
 
+/**
+ * In Pcbnew, the auto save formats the board in memory, then writes the file from another
+ * thread, so a slow disk does not stall the editor.  Set it to false to write the auto save
+ * file as a normal save does.
+ */
+static const wxChar BackgroundAutoSave[] = wxT( "BackgroundAutoSave" );
+
+/**
+ * In Pcbnew, save the filled polygons of the zones in the compact (filled_polygon_data ...)
+ * blocks instead of the (filled_polygon (pts (xy ...) ...)) lists.  The files are smaller and
+ * load faster, but cannot be read by the versions of KiCad not knowing filled_polygon_data.
+ */
+static const wxChar CompressZoneFills[] = wxT( "CompressZoneFills" );
+
+/**
+ * In Pcbnew, do not read the filled polygons of the zones when opening a board, and fill the
+ * zones again once the board is shown.
+ */
+static const wxChar SkipZoneFillsOnLoad[] = wxT( "SkipZoneFillsOnLoad" );
+
+/**
+ * In Pcbnew, keep the zone fills in a zone-fill-cache folder next to the board file, and reuse
+ * them when a zone is filled again with the same outline, settings and surrounding items.
+ */
+static const wxChar ZoneFillCache[] = wxT( "ZoneFillCache" );
+
+/**
+ * Record the profiled scopes (zone fill, DRC, connectivity, redraws, board files, router) and
+ * write them when closing an application, in a <application>-trace-<process id>.json file of
+ * the temporary folder, which can be opened in chrome://tracing.
+ */
+static const wxChar EnableProfiling[] = wxT( "EnableProfiling" );
+
 } // namespace KEYS
 
 
@@ -168,6 +201,11 @@ ADVANCED_CFG::ADVANCED_CFG()
     m_EnableUsePinFunction = false;
     m_realTimeConnectivity = true;
     m_coroutineStackSize = AC_STACK::default_stack;
+    m_backgroundAutoSave = true;
+    m_compressZoneFills = false;
+    m_skipZoneFillsOnLoad = false;
+    m_zoneFillCache = false;
+    m_enableProfiling = false;
 
     loadFromConfigFile();
 }
@@ -214,6 +252,21 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
                                                &m_coroutineStackSize, AC_STACK::default_stack,
                                                AC_STACK::min_stack, AC_STACK::max_stack ) );
 
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::BackgroundAutoSave,
+                                                &m_backgroundAutoSave, true ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::CompressZoneFills,
+                                                &m_compressZoneFills, false ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::SkipZoneFillsOnLoad,
+                                                &m_skipZoneFillsOnLoad, false ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ZoneFillCache,
+                                                &m_zoneFillCache, false ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::EnableProfiling,
+                                                &m_enableProfiling, false ) );
+
     wxConfigLoadSetups( &aCfg, configParams );
 
     dumpCfg( configParams );
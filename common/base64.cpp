@@ -110,22 +110,28 @@ namespace base64
     }
 
 
-    void decode(const std::vector<uint8_t>& aInput, std::vector<uint8_t>& aOutput )
+    bool decode( const std::vector<uint8_t>& aInput, std::vector<uint8_t>& aOutput )
     {
         size_t end = ( aInput.size() / 4 ) * 4;
         size_t decode_size = decode_length( aInput.size() );
 
         if( !decode_size )
-            return;
+            return aInput.empty();
 
-        aOutput.reserve( decode_size );
+        for( uint8_t c : aInput )
+        {
+            if( c & 0x80 || DECODE_BASE64[c] == E )
+                return false;
+        }
+
+        aOutput.reserve( aOutput.size() + decode_size );
 
-        for( size_t i = 0; i < end; i++ )
+        for( size_t i = 0; i < end; i += 4 )
         {
-            unsigned value = ( DECODE_BASE64[aInput[i] & 0x7F] << 18 ) |
-                             ( DECODE_BASE64[aInput[i + 1] & 0x7F] << 12 ) |
-                             ( DECODE_BASE64[aInput[i + 2] & 0x7F] << 6 ) |
-                               DECODE_BASE64[aInput[i + 3] & 0x7F];
+            unsigned value = ( DECODE_BASE64[aInput[i]] << 18 ) |
+                             ( DECODE_BASE64[aInput[i + 1]] << 12 ) |
+                             ( DECODE_BASE64[aInput[i + 2]] << 6 ) |
+                               DECODE_BASE64[aInput[i + 3]];
 
             aOutput.emplace_back( ( value >> 16 ) & 0xff );
             aOutput.emplace_back( ( value >> 8 ) & 0xff );
@@ -136,12 +142,12 @@ namespace base64
 
         if( remainder )
         {
-            unsigned value = ( ( DECODE_BASE64[aInput[end] & 0x7F] ) << 6 ) |
-                             ( DECODE_BASE64[aInput[end + 1] & 0x7F] );
+            unsigned value = ( DECODE_BASE64[aInput[end]] << 6 ) |
+                               DECODE_BASE64[aInput[end + 1]];
 
             if( remainder == 3 )
             {
-                value = ( value << 6 ) | ( DECODE_BASE64[aInput[end + 2] & 0x7F] );
+                value = ( value << 6 ) | DECODE_BASE64[aInput[end + 2]];
                 value >>= 2;
 
                 aOutput.emplace_back( ( value >> 8 ) & 0xff );
@@ -150,8 +156,11 @@ namespace base64
             {
                 value >>= 4;
             }
-            aOutput[0] = value & 0xff ;
+
+            aOutput.emplace_back( value & 0xff );
         }
+
+        return true;
     }
 
 } // base64
@@ -28,7 +28,8 @@
 #include <commit.h>
 #include <base_struct.h>
 
-COMMIT::COMMIT()
+COMMIT::COMMIT() :
+    m_hasTransforms( false )
 {
 }
 
@@ -87,6 +88,44 @@ COMMIT& COMMIT::Stage( EDA_ITEM* aItem, CHANGE_TYPE aChangeType )
 }
 
 
+COMMIT& COMMIT::ModifyForRotate( EDA_ITEM* aItem, const wxPoint& aCentre, double aAngle )
+{
+    COMMIT_LINE* entry = stageTransform( aItem, CHT_ROTATE, aCentre );
+
+    if( entry )
+        entry->m_transformAngle = aAngle;
+
+    return *this;
+}
+
+
+COMMIT& COMMIT::ModifyForFlip( EDA_ITEM* aItem, const wxPoint& aCentre, bool aFlipLeftRight )
+{
+    COMMIT_LINE* entry = stageTransform( aItem, CHT_FLIP, aCentre );
+
+    if( entry )
+        entry->m_flipLeftRight = aFlipLeftRight;
+
+    return *this;
+}
+
+
+COMMIT::COMMIT_LINE* COMMIT::stageTransform( EDA_ITEM* aItem, CHANGE_TYPE aTransform,
+                                             const wxPoint& aCentre )
+{
+    size_t count = m_changes.size();
+
+    Stage( aItem, CHT_MODIFY | aTransform );
+
+    // A new entry is added at the end, an item already modified keeps its entry
+    if( m_changes.size() == count )
+        return nullptr;
+
+    m_changes.back().m_transformPoint = aCentre;
+    return &m_changes.back();
+}
+
+
 COMMIT& COMMIT::Stage( std::vector<EDA_ITEM*>& container, CHANGE_TYPE aChangeType )
 {
     for( EDA_ITEM* item : container )
@@ -155,6 +194,17 @@ COMMIT& COMMIT::createModified( EDA_ITEM* aItem, EDA_ITEM* aCopy, int aExtraFlag
     if( entryIt != m_changedItems.end() )
     {
         delete aCopy;
+
+        // The item is changed by more than a move, a rotation or a flip, so its copy is needed
+        // to undo the change (only several moves add up to a single move)
+        if( m_hasTransforms )
+        {
+            COMMIT_LINE* entry = findEntry( parent );
+
+            if( entry && !( ( entry->m_type & CHT_MOVE ) && ( aExtraFlags & CHT_MOVE ) ) )
+                entry->m_type = CHANGE_TYPE( entry->m_type & ~CHT_TRANSFORM );
+        }
+
         return *this; // item has been already modified once
     }
 
@@ -182,6 +232,9 @@ void COMMIT::makeEntry( EDA_ITEM* aItem, CHANGE_TYPE aType, EDA_ITEM* aCopy )
     ent.m_type = aType;
     ent.m_copy = aCopy;
 
+    if( aType & CHT_TRANSFORM )
+        m_hasTransforms = true;
+
     m_changedItems.insert( aItem );
     m_changes.push_back( ent );
 }
@@ -24,10 +24,14 @@
  */
 
 #include <macros.h>             // FROM_UTF8()
+#include <wx/filename.h>
 #include <wx/stdpaths.h>
+#include <wx/utils.h>
 
 #include <kiface_i.h>
 #include <pgm_base.h>
+#include <profile.h>
+#include <richio.h>
 #include <systemdirsappend.h>
 
 #include <common.h>
@@ -92,12 +96,32 @@ bool KIFACE_I::start_common( int aCtlBits )
     m_bm.Init();
     setSearchPaths( &m_bm.m_search, m_id );
 
+    // Read the setting from the main thread, before the first profiled scope
+    PROF_TRACE::IsEnabled();
+
     return true;
 }
 
 
 void KIFACE_I::end_common()
 {
+    // Each KIFACE has its own profiled scopes: write them when it ends
+    if( PROF_TRACE::IsEnabled() )
+    {
+        wxFileName fn( wxFileName::GetTempDir(),
+                       wxString::Format( wxT( "%s-trace-%lu" ), Name(), wxGetProcessId() ),
+                       wxT( "json" ) );
+
+        try
+        {
+            PROF_TRACE::WriteChromeTrace( fn.GetFullPath() );
+        }
+        catch( const IO_ERROR& )
+        {
+            // The application is closing: there is nobody left to report the error to
+        }
+    }
+
     m_bm.End();
 }
 
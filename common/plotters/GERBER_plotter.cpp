@@ -99,10 +99,53 @@ void GERBER_PLOTTER::SetGerberCoordinatesFormat( int aResolution, bool aUseInche
 }
 
 
+/**
+ * Write the decimal text of aValue at aBuffer, like the %d format of printf.
+ * @return the end of the written text, which is not null terminated
+ */
+static char* formatInt( char* aBuffer, int aValue )
+{
+    unsigned int value = aValue < 0 ? 0U - (unsigned int) aValue : (unsigned int) aValue;
+    char         digits[10];
+    int          count = 0;
+
+    do
+    {
+        digits[count++] = '0' + value % 10;
+        value /= 10;
+    } while( value );
+
+    if( aValue < 0 )
+        *aBuffer++ = '-';
+
+    while( count )
+        *aBuffer++ = digits[--count];
+
+    return aBuffer;
+}
+
+
 void GERBER_PLOTTER::emitDcode( const DPOINT& pt, int dcode )
 {
+    // This is written for each vertex of each polygon (zones can have millions of them),
+    // so build "X%dY%dD%02d*\n" by hand instead of parsing the format in fprintf
+    char  buffer[48];
+    char* text = buffer;
 
-    fprintf( outputFile, "X%dY%dD%02d*\n", KiROUND( pt.x ), KiROUND( pt.y ), dcode );
+    *text++ = 'X';
+    text = formatInt( text, KiROUND( pt.x ) );
+    *text++ = 'Y';
+    text = formatInt( text, KiROUND( pt.y ) );
+    *text++ = 'D';
+
+    if( dcode >= 0 && dcode < 10 )
+        *text++ = '0';
+
+    text = formatInt( text, dcode );
+    *text++ = '*';
+    *text++ = '\n';
+
+    fwrite( buffer, 1, text - buffer, outputFile );
 }
 
 void GERBER_PLOTTER::ClearAllAttributes()
@@ -190,7 +233,7 @@ bool GERBER_PLOTTER::StartPlot()
     // Create a temporary filename to store gerber file
     // note tmpfile() does not work under Vista and W7 in user mode
     m_workFilename = filename + wxT(".tmp");
-    workFile   = wxFopen( m_workFilename, wxT( "wt" ));
+    workFile   = openPlotFile( m_workFilename, wxT( "wt" ) );
     outputFile = workFile;
     wxASSERT( outputFile );
 
@@ -256,7 +299,7 @@ bool GERBER_PLOTTER::EndPlot()
     fflush( outputFile );
 
     fclose( workFile );
-    workFile   = wxFopen( m_workFilename, wxT( "rt" ));
+    workFile   = openPlotFile( m_workFilename, wxT( "rt" ) );
     wxASSERT( workFile );
     outputFile = finalFile;
 
@@ -271,9 +314,18 @@ bool GERBER_PLOTTER::EndPlot()
         {
             writeApertureList();
             fputs( "G04 APERTURE END LIST*\n", outputFile );
+            break;
         }
     }
 
+    // The aperture list is in the header: copy the rest of the file (the plotted items)
+    // by blocks, not line by line
+    std::vector<char> block( 256 * 1024 );
+    size_t            blockSize;
+
+    while( ( blockSize = fread( block.data(), 1, block.size(), workFile ) ) > 0 )
+        fwrite( block.data(), 1, blockSize, outputFile );
+
     fclose( workFile );
     fclose( finalFile );
     ::wxRemoveFile( m_workFilename );
@@ -313,18 +365,14 @@ void GERBER_PLOTTER::SetCurrentLineWidth( int width, void* aData )
 int GERBER_PLOTTER::GetOrCreateAperture( const wxSize& aSize,
                         APERTURE::APERTURE_TYPE aType, int aApertureAttribute )
 {
-    int last_D_code = 9;
-
     // Search an existing aperture
-    for( int idx = 0; idx < (int)m_apertures.size(); ++idx )
-    {
-        APERTURE* tool = &m_apertures[idx];
-        last_D_code = tool->m_DCode;
+    auto key = std::make_tuple( (int) aType, aSize.x, aSize.y, aApertureAttribute );
+    auto it = m_apertureIndex.find( key );
 
-        if( (tool->m_Type == aType) && (tool->m_Size == aSize) &&
-            (tool->m_ApertureAttribute == aApertureAttribute) )
-            return idx;
-    }
+    if( it != m_apertureIndex.end() )
+        return it->second;
+
+    int last_D_code = m_apertures.empty() ? 9 : m_apertures.back().m_DCode;
 
     // Allocate a new aperture
     APERTURE new_tool;
@@ -334,6 +382,7 @@ int GERBER_PLOTTER::GetOrCreateAperture( const wxSize& aSize,
     new_tool.m_ApertureAttribute = aApertureAttribute;
 
     m_apertures.push_back( new_tool );
+    m_apertureIndex[ key ] = m_apertures.size() - 1;
 
     return m_apertures.size() - 1;
 }
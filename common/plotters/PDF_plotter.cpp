@@ -54,7 +54,7 @@ bool PDF_PLOTTER::OpenFile( const wxString& aFullFilename )
     wxASSERT( !outputFile );
 
     // Open the PDF file in binary mode
-    outputFile = wxFopen( filename, wxT( "wb" ) );
+    outputFile = openPlotFile( filename, wxT( "wb" ) );
 
     if( outputFile == NULL )
         return false ;
@@ -498,7 +498,7 @@ int PDF_PLOTTER::startPdfStream(int handle)
 
     // Open a temporary file to accumulate the stream
     workFilename = filename + wxT(".tmp");
-    workFile = wxFopen( workFilename, wxT( "w+b" ));
+    workFile = openPlotFile( workFilename, wxT( "w+b" ) );
     wxASSERT( workFile );
     return handle;
 }
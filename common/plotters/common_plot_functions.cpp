@@ -22,6 +22,8 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <mutex>
+
 #include <fctsys.h>
 #include <base_struct.h>
 #include <plotter.h>
@@ -71,6 +73,12 @@ void PlotWorkSheet( PLOTTER* plotter, const TITLE_BLOCK& aTitleBlock,
         plotColor = COLOR4D( RED );
 
     plotter->SetColor( plotColor );
+
+    // The worksheet items are built by the page layout model, which is shared: serialize the
+    // plots of the frame reference made by concurrent plots
+    static std::mutex worksheetMutex;
+    std::lock_guard<std::mutex> lock( worksheetMutex );
+
     WS_DRAW_ITEM_LIST drawList;
 
     // Print only a short filename, if aFilename is the full filename
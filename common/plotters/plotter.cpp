@@ -87,7 +87,7 @@ bool PLOTTER::OpenFile( const wxString& aFullFilename )
 
     // Open the file in text mode (not suitable for all plotters
     // but only for most of them
-    outputFile = wxFopen( filename, wxT( "wt" ) );
+    outputFile = openPlotFile( filename, wxT( "wt" ) );
 
     if( outputFile == NULL )
         return false ;
@@ -96,6 +96,18 @@ bool PLOTTER::OpenFile( const wxString& aFullFilename )
 }
 
 
+FILE* PLOTTER::openPlotFile( const wxString& aFullFilename, const wxChar* aMode )
+{
+    FILE* file = wxFopen( aFullFilename, aMode );
+
+    // Let the C library allocate (and free on fclose) a buffer much larger than BUFSIZ
+    if( file )
+        setvbuf( file, NULL, _IOFBF, 256 * 1024 );
+
+    return file;
+}
+
+
 DPOINT PLOTTER::userToDeviceCoordinates( const wxPoint& aCoordinate )
 {
     wxPoint pos = aCoordinate - plotOffset;
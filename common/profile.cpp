@@ -0,0 +1,216 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <profile.h>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <wx/utils.h>
+
+#include <advanced_config.h>
+#include <common.h>
+#include <richio.h>
+
+
+namespace
+{
+
+/// The ring buffer of the scopes of a thread
+struct THREAD_EVENTS
+{
+    std::mutex                     m_lock;     // the thread records while the trace is written
+    std::vector<PROF_TRACE::EVENT> m_events;
+    size_t                         m_next = 0; // the next event to overwrite, once full
+    bool                           m_inUse = false;
+};
+
+
+struct REGISTRY
+{
+    std::mutex                                  m_lock;
+    std::vector<std::unique_ptr<THREAD_EVENTS>> m_buffers;
+    unsigned                                    m_threadCount = 0;
+    PROF_TRACE::CLOCK::time_point               m_origin = PROF_TRACE::CLOCK::now();
+};
+
+
+REGISTRY& registry()
+{
+    // Never destroyed: the threads still running at exit may record scopes
+    static REGISTRY* registry = new REGISTRY;
+    return *registry;
+}
+
+
+/**
+ * The buffer of the current thread, taken from the registry at its first scope and given
+ * back when the thread ends.  The threads of std::async are short lived: the next thread
+ * reuses the buffer, keeping its events, instead of adding a new one.
+ */
+struct THREAD_BUFFER
+{
+    THREAD_EVENTS* m_events = nullptr;
+    unsigned       m_thread = 0;
+
+    THREAD_EVENTS& Get()
+    {
+        if( m_events )
+            return *m_events;
+
+        REGISTRY&                   reg = registry();
+        std::lock_guard<std::mutex> lock( reg.m_lock );
+
+        m_thread = ++reg.m_threadCount;
+
+        for( const std::unique_ptr<THREAD_EVENTS>& buffer : reg.m_buffers )
+        {
+            if( !buffer->m_inUse )
+            {
+                m_events = buffer.get();
+                break;
+            }
+        }
+
+        if( !m_events )
+        {
+            reg.m_buffers.emplace_back( new THREAD_EVENTS );
+            m_events = reg.m_buffers.back().get();
+            m_events->m_events.reserve( PROF_TRACE::MaxEventsPerThread );
+        }
+
+        m_events->m_inUse = true;
+        return *m_events;
+    }
+
+    ~THREAD_BUFFER()
+    {
+        if( m_events )
+        {
+            std::lock_guard<std::mutex> lock( registry().m_lock );
+            m_events->m_inUse = false;
+        }
+    }
+};
+
+
+thread_local THREAD_BUFFER t_buffer;
+
+
+uint64_t nanoseconds( PROF_TRACE::CLOCK::duration aDuration )
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>( aDuration ).count();
+}
+
+}
+
+
+bool PROF_TRACE::IsEnabled()
+{
+    static const bool enabled = ADVANCED_CFG::GetCfg().m_enableProfiling;
+    return enabled;
+}
+
+
+void PROF_TRACE::Record( const char* aName, int64_t aArg, CLOCK::time_point aStart,
+                         CLOCK::time_point aEnd )
+{
+    THREAD_EVENTS& buffer = t_buffer.Get();
+    EVENT          event;
+
+    event.m_name = aName;
+    event.m_arg = aArg;
+    event.m_start = nanoseconds( aStart - registry().m_origin );
+    event.m_duration = nanoseconds( aEnd - aStart );
+    event.m_thread = t_buffer.m_thread;
+
+    std::lock_guard<std::mutex> lock( buffer.m_lock );
+
+    if( buffer.m_events.size() < MaxEventsPerThread )
+    {
+        buffer.m_events.push_back( event );
+    }
+    else
+    {
+        buffer.m_events[buffer.m_next] = event;
+        buffer.m_next = ( buffer.m_next + 1 ) % MaxEventsPerThread;
+    }
+}
+
+
+void PROF_TRACE::WriteChromeTrace( const wxString& aFileName )
+{
+    REGISTRY&          reg = registry();
+    std::vector<EVENT> events;
+
+    {
+        std::lock_guard<std::mutex> lock( reg.m_lock );
+
+        for( const std::unique_ptr<THREAD_EVENTS>& buffer : reg.m_buffers )
+        {
+            std::lock_guard<std::mutex> bufferLock( buffer->m_lock );
+            events.insert( events.end(), buffer->m_events.begin(), buffer->m_events.end() );
+        }
+    }
+
+    std::sort( events.begin(), events.end(),
+               []( const EVENT& aFirst, const EVENT& aSecond )
+               {
+                   return aFirst.m_start < aSecond.m_start;
+               } );
+
+    LOCALE_IO            toggle;    // the JSON numbers need a '.' as decimal separator
+    FILE_OUTPUTFORMATTER out( aFileName );
+    unsigned long        pid = wxGetProcessId();
+
+    out.Print( 0, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [" );
+
+    for( size_t ii = 0; ii < events.size(); ++ii )
+    {
+        const EVENT& event = events[ii];
+        std::string  name;
+
+        for( const char* c = event.m_name; *c; ++c )
+        {
+            if( *c == '"' || *c == '\\' )
+                name += '\\';
+
+            name += *c;
+        }
+
+        // The times of the trace events are in microseconds
+        out.Print( 0, "%s\n{\"name\": \"%s\", \"cat\": \"kicad\", \"ph\": \"X\", "
+                   "\"ts\": %.3f, \"dur\": %.3f, \"pid\": %lu, \"tid\": %u",
+                   ii ? "," : "", name.c_str(), event.m_start / 1e3, event.m_duration / 1e3,
+                   pid, event.m_thread );
+
+        if( event.m_arg != NoArg )
+            out.Print( 0, ", \"args\": {\"value\": %lld}", (long long) event.m_arg );
+
+        out.Print( 0, "}" );
+    }
+
+    out.Print( 0, "\n]}\n" );
+}
@@ -0,0 +1,119 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <slab_allocator.h>
+
+#include <mutex>
+#include <new>
+
+
+namespace
+{
+
+const size_t Granularity = 16;
+const size_t SizeClassCount = SLAB_ALLOCATOR::MaxObjectSize / Granularity;
+
+
+struct FREE_OBJECT
+{
+    FREE_OBJECT* m_next;
+};
+
+
+struct SIZE_CLASS
+{
+    FREE_OBJECT* m_free = nullptr;     // the released objects
+    char*        m_next = nullptr;     // the unused part of the current slab
+    char*        m_end = nullptr;
+};
+
+
+struct SLABS
+{
+    std::mutex m_lock;
+    SIZE_CLASS m_classes[SizeClassCount];
+};
+
+
+SLABS& slabs()
+{
+    // Never destroyed: objects may still be released during the static destruction at exit
+    static SLABS* slabs = new SLABS;
+    return *slabs;
+}
+
+}
+
+
+void* SLAB_ALLOCATOR::Allocate( size_t aSize )
+{
+    if( aSize == 0 || aSize > MaxObjectSize )
+        return ::operator new( aSize );
+
+    size_t      objectSize = ( aSize + Granularity - 1 ) / Granularity * Granularity;
+    SLABS&      allSlabs = slabs();
+    SIZE_CLASS& sizeClass = allSlabs.m_classes[objectSize / Granularity - 1];
+
+    std::lock_guard<std::mutex> lock( allSlabs.m_lock );
+
+    if( FREE_OBJECT* object = sizeClass.m_free )
+    {
+        sizeClass.m_free = object->m_next;
+        return object;
+    }
+
+    if( sizeClass.m_next + objectSize > sizeClass.m_end || !sizeClass.m_next )
+    {
+        // The end of the previous slab, too small for an object, is lost
+        sizeClass.m_next = static_cast<char*>( ::operator new( SlabSize ) );
+        sizeClass.m_end = sizeClass.m_next + SlabSize;
+    }
+
+    void* object = sizeClass.m_next;
+    sizeClass.m_next += objectSize;
+
+    return object;
+}
+
+
+void SLAB_ALLOCATOR::Free( void* aPtr, size_t aSize )
+{
+    if( !aPtr )
+        return;
+
+    if( aSize == 0 || aSize > MaxObjectSize )
+    {
+        ::operator delete( aPtr );
+        return;
+    }
+
+    size_t      objectSize = ( aSize + Granularity - 1 ) / Granularity * Granularity;
+    SLABS&      allSlabs = slabs();
+    SIZE_CLASS& sizeClass = allSlabs.m_classes[objectSize / Granularity - 1];
+
+    std::lock_guard<std::mutex> lock( allSlabs.m_lock );
+
+    FREE_OBJECT* object = static_cast<FREE_OBJECT*>( aPtr );
+    object->m_next = sizeClass.m_free;
+    sizeClass.m_free = object;
+}
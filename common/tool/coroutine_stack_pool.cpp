@@ -0,0 +1,160 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <tool/coroutine_stack_pool.h>
+
+#include <new>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+
+COROUTINE_STACK_POOL& COROUTINE_STACK_POOL::Instance()
+{
+    // Never destroyed: coroutines may still release their stacks during the static
+    // destruction at exit
+    static COROUTINE_STACK_POOL* pool = new COROUTINE_STACK_POOL;
+    return *pool;
+}
+
+
+COROUTINE_STACK_POOL::COROUTINE_STACK_POOL() :
+    m_mappedCount( 0 )
+{
+}
+
+
+COROUTINE_STACK_POOL::~COROUTINE_STACK_POOL()
+{
+    for( const STACK& stack : m_free )
+        unmap( stack );
+}
+
+
+size_t COROUTINE_STACK_POOL::pageSize()
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo( &info );
+    return info.dwPageSize;
+#else
+    long size = sysconf( _SC_PAGESIZE );
+    return size > 0 ? size : 4096;
+#endif
+}
+
+
+COROUTINE_STACK_POOL::STACK COROUTINE_STACK_POOL::Acquire( size_t aSize )
+{
+    {
+        std::lock_guard<std::mutex> lock( m_lock );
+
+        for( auto it = m_free.begin(); it != m_free.end(); ++it )
+        {
+            if( it->m_size >= aSize )
+            {
+                STACK stack = *it;
+                m_free.erase( it );
+                return stack;
+            }
+        }
+
+        m_mappedCount++;
+    }
+
+    return map( aSize );
+}
+
+
+void COROUTINE_STACK_POOL::Release( const STACK& aStack )
+{
+    if( !aStack.m_mapping )
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock( m_lock );
+
+        if( m_free.size() < MaxFreeStacks )
+        {
+            m_free.push_back( aStack );
+            return;
+        }
+    }
+
+    unmap( aStack );
+}
+
+
+size_t COROUTINE_STACK_POOL::GetFreeCount() const
+{
+    std::lock_guard<std::mutex> lock( m_lock );
+    return m_free.size();
+}
+
+
+COROUTINE_STACK_POOL::STACK COROUTINE_STACK_POOL::map( size_t aSize )
+{
+    const size_t page = pageSize();
+    STACK        stack;
+
+    stack.m_size = ( aSize + page - 1 ) / page * page;
+    stack.m_mappingSize = stack.m_size + page;
+
+#ifdef _WIN32
+    stack.m_mapping = VirtualAlloc( nullptr, stack.m_mappingSize, MEM_COMMIT | MEM_RESERVE,
+                                    PAGE_READWRITE );
+
+    if( !stack.m_mapping )
+        throw std::bad_alloc();
+
+    DWORD oldProtect;
+    VirtualProtect( stack.m_mapping, page, PAGE_NOACCESS, &oldProtect );
+#else
+    stack.m_mapping = mmap( nullptr, stack.m_mappingSize, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANON, -1, 0 );
+
+    if( stack.m_mapping == MAP_FAILED )
+        throw std::bad_alloc();
+
+    // The stacks grow down: the guard page is the first page of the mapping
+    mprotect( stack.m_mapping, page, PROT_NONE );
+#endif
+
+    stack.m_bottom = static_cast<char*>( stack.m_mapping ) + page;
+
+    return stack;
+}
+
+
+void COROUTINE_STACK_POOL::unmap( const STACK& aStack )
+{
+#ifdef _WIN32
+    VirtualFree( aStack.m_mapping, 0, MEM_RELEASE );
+#else
+    munmap( aStack.m_mapping, aStack.m_mappingSize );
+#endif
+}
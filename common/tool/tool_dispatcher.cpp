@@ -142,6 +142,8 @@ void TOOL_DISPATCHER::ResetState()
 {
     for( BUTTON_STATE* st : m_buttons )
         st->Reset();
+
+    m_pendingMotion = NULLOPT;
 }
 
 
@@ -237,6 +239,9 @@ bool TOOL_DISPATCHER::handleMouseButton( wxEvent& aEvent, int aIndex, bool aMoti
 
     if( evt )
     {
+        // Keep the order of the events: the waiting motion goes first
+        dispatchPendingMotion();
+
         evt->SetMousePosition( isClick ? st->downPosition : m_lastMousePos );
         m_toolMgr->ProcessEvent( *evt );
 
@@ -460,8 +465,24 @@ void TOOL_DISPATCHER::DispatchWxEvent( wxEvent& aEvent )
 
     bool handled = false;
 
-    if( evt )
+    // The tools only need the last position of the mouse: a motion event is dispatched once
+    // the events already waiting in the queue are handled, and the motion events received
+    // meanwhile replace it.  This way the tools do not lag behind the cursor when they are
+    // slower to update than the motion events come.
+    if( evt && evt->IsMotion() )
+    {
+        bool scheduled = !!m_pendingMotion;
+
+        m_pendingMotion = evt;
+
+        if( !scheduled )
+            CallAfter( &TOOL_DISPATCHER::dispatchPendingMotion );
+    }
+    else if( evt )
     {
+        // Keep the order of the events: the waiting motion goes first
+        dispatchPendingMotion();
+
         wxLogTrace( kicadTraceToolStack, "TOOL_DISPATCHER::DispatchWxEvent %s", evt->Format() );
 
         handled = m_toolMgr->ProcessEvent( *evt );
@@ -495,12 +516,28 @@ void TOOL_DISPATCHER::DispatchWxEvent( wxEvent& aEvent )
 }
 
 
+void TOOL_DISPATCHER::dispatchPendingMotion()
+{
+    if( !m_pendingMotion )
+        return;
+
+    TOOL_EVENT evt = *m_pendingMotion;
+    m_pendingMotion = NULLOPT;
+
+    wxLogTrace( kicadTraceToolStack, "TOOL_DISPATCHER::DispatchWxEvent %s", evt.Format() );
+
+    m_toolMgr->ProcessEvent( evt );
+}
+
+
 void TOOL_DISPATCHER::DispatchWxCommand( wxCommandEvent& aEvent )
 {
     OPT<TOOL_EVENT> evt = m_actions->TranslateLegacyId( aEvent.GetId() );
 
     if( evt )
     {
+        dispatchPendingMotion();
+
         wxLogTrace( kicadTraceToolStack, "TOOL_DISPATCHER::DispatchWxCommand %s", evt->Format() );
 
         m_toolMgr->ProcessEvent( *evt );
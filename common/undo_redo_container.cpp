@@ -40,6 +40,8 @@ ITEM_PICKER::ITEM_PICKER( EDA_ITEM* aItem, UNDO_REDO_T aUndoRedoStatus )
 PICKED_ITEMS_LIST::PICKED_ITEMS_LIST()
 {
     m_Status = UR_UNSPECIFIED;
+    m_TransformAngle = 0.0;
+    m_TransformFlipLeftRight = false;
 }
 
 PICKED_ITEMS_LIST::~PICKED_ITEMS_LIST()
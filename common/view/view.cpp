@@ -37,9 +37,9 @@
 #include <gal/graphics_abstraction_layer.h>
 #include <painter.h>
 
-#ifdef __WXDEBUG__
 #include <profile.h>
-#endif /* __WXDEBUG__  */
+
+#include <unordered_set>
 
 namespace KIGFX {
 
@@ -472,6 +472,24 @@ int VIEW::Query( const BOX2I& aRect, std::vector<LAYER_ITEM_PAIR>& aResult ) con
 }
 
 
+void VIEW::QueryItems( const BOX2I& aRect, std::vector<VIEW_ITEM*>& aResult ) const
+{
+    std::unordered_set<VIEW_ITEM*> found;     // items are in the R-tree of each of their layers
+
+    auto visitor =
+            [&]( VIEW_ITEM* aItem ) -> bool
+            {
+                if( found.insert( aItem ).second )
+                    aResult.push_back( aItem );
+
+                return true;
+            };
+
+    for( const VIEW_LAYER* layer : m_orderedLayers )
+        layer->items->Query( aRect, visitor );
+}
+
+
 VECTOR2D VIEW::ToWorld( const VECTOR2D& aCoord, bool aAbsolute ) const
 {
     const MATRIX3x3D& matrix = m_gal->GetScreenWorldMatrix();
@@ -1144,6 +1162,8 @@ void VIEW::ClearTargets()
 
 void VIEW::Redraw()
 {
+    PROF_SCOPE profScope( "view-redraw" );
+
 #ifdef __WXDEBUG__
     PROF_COUNTER totalRealTime;
 #endif /* __WXDEBUG__ */
@@ -1401,6 +1421,8 @@ bool VIEW::areRequiredLayersEnabled( int aLayerId ) const
 
 void VIEW::RecacheAllItems()
 {
+    PROF_SCOPE profScope( "view-recache" );
+
     BOX2I r;
 
     r.SetMaximum();
@@ -1420,6 +1442,8 @@ void VIEW::RecacheAllItems()
 
 void VIEW::UpdateItems()
 {
+    PROF_SCOPE profScope( "view-update-items" );
+
     if( m_gal->IsVisible() )
     {
         GAL_UPDATE_CONTEXT ctx( m_gal );
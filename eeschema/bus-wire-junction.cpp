@@ -293,6 +293,7 @@ bool SCH_EDIT_FRAME::BreakSegment( SCH_LINE* aSegment, const wxPoint& aPoint,
 
     RefreshItem( aSegment );
     aSegment->SetEndPoint( aPoint );
+    aScreen->Update( aSegment );
 
     if( aNewSegment )
         *aNewSegment = newSegment;
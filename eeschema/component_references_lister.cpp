@@ -33,6 +33,7 @@
 #include <wx/regex.h>
 #include <algorithm>
 #include <vector>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <fctsys.h>
@@ -219,38 +220,64 @@ int SCH_REFERENCE_LIST::GetLastReference( int aIndex, int aMinValue )
 }
 
 
-int SCH_REFERENCE_LIST::CreateFirstFreeRefId( std::vector<int>& aIdList, int aFirstValue )
+void SCH_REFERENCE_LIST::buildRegistry( PREFIX_REGISTRY& aRegistry )
 {
-    int expectedId = aFirstValue;
+    aRegistry.clear();
 
-    // We search for expected Id a value >= aFirstValue.
-    // Skip existing Id < aFirstValue
-    unsigned ii = 0;
-
-    for( ; ii < aIdList.size(); ii++ )
+    for( size_t ii = 0; ii < flatList.size(); ii++ )
     {
-        if( expectedId <= aIdList[ii] )
-            break;
+        aRegistry[ flatList[ii].GetRefStr() ].m_Members.push_back( ii );
+        registerNumber( aRegistry, ii );
     }
+}
+
+
+void SCH_REFERENCE_LIST::registerNumber( PREFIX_REGISTRY& aRegistry, size_t aIndex )
+{
+    PREFIX_INDEX& prefix = aRegistry[ flatList[aIndex].GetRefStr() ];
+    int           numRef = flatList[aIndex].m_NumRef;
+
+    // Items are never unregistered: findUnit() checks the current state of the candidates
+    prefix.m_ByNumber[ numRef ].push_back( aIndex );
+
+    if( numRef >= 0 )
+        prefix.m_InUse.insert( numRef );
+}
+
 
-    // Ids are sorted by increasing value, from aFirstValue
-    // So we search from aFirstValue the first not used value, i.e. the first hole in list.
-    for( ; ii < aIdList.size(); ii++ )
+int SCH_REFERENCE_LIST::findUnit( const PREFIX_INDEX& aPrefix, size_t aIndex, int aUnit )
+{
+    int  numRef = flatList[aIndex].m_NumRef;
+    auto it = aPrefix.m_ByNumber.find( numRef );
+
+    if( it == aPrefix.m_ByNumber.end() )
+        return -1;
+
+    for( size_t ii : it->second )
     {
-        if( expectedId != aIdList[ii] )    // This id is not yet used.
-        {
-            // Insert this free Id, in order to keep list sorted
-            aIdList.insert( aIdList.begin() + ii, expectedId );
-            return expectedId;
-        }
+        if(  ( aIndex == ii )
+          || ( flatList[ii].m_IsNew )
+          || ( flatList[ii].m_NumRef != numRef ) )
+            continue;
 
-        expectedId++;
+        if( flatList[ii].m_Unit == aUnit )
+            return (int) ii;
     }
 
-    // All existing Id are tested, and all values are found in use.
-    // So Create a new one.
-    aIdList.push_back( expectedId );
-    return expectedId;
+    return -1;
+}
+
+
+int SCH_REFERENCE_LIST::findFreeRefId( PREFIX_INDEX& aPrefix, int aMinRefId )
+{
+    // Numbers are only added while annotating, so the first free number above a given
+    // minimum never decreases and the search resumes where it stopped the last time.
+    int& candidate = aPrefix.m_NextFree.emplace( aMinRefId, aMinRefId ).first->second;
+
+    while( aPrefix.m_InUse.count( candidate ) )
+        candidate++;
+
+    return candidate;
 }
 
 
@@ -306,10 +333,31 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
     // inUseRefs keep trace of previously allocated references
     std::unordered_set<wxString> inUseRefs;
 
-    // This is the list of all Id already in use for a given reference prefix.
-    // Will be refilled for each new reference prefix.
-    std::vector<int>idList;
-    GetRefsInUse( first, idList, minRefId );
+    // The reference numbers in use and the units of each reference, by reference prefix.
+    // Updated each time a reference number is allocated, so unlike the list returned by
+    // GetRefsInUse() it does not have to be rebuilt for each new reference prefix.
+    PREFIX_REGISTRY registry;
+    buildRegistry( registry );
+
+    PREFIX_INDEX* prefix = &registry[ flatList[first].GetRefStr() ];
+
+    // The items of the list and of aLockedUnitMap by component, to find the instances of a
+    // component without scanning the lists.  Locked lists are stored in the map order.
+    std::unordered_map<SCH_COMPONENT*, std::vector<size_t>> instances;
+    std::unordered_map<SCH_COMPONENT*, std::vector<std::pair<SCH_REFERENCE*,
+                                                             SCH_REFERENCE_LIST*>>> lockedInstances;
+
+    for( size_t ii = 0; ii < flatList.size(); ii++ )
+        instances[ flatList[ii].GetComp() ].push_back( ii );
+
+    for( SCH_MULTI_UNIT_REFERENCE_MAP::value_type& pair : aLockedUnitMap )
+    {
+        for( unsigned thisRefI = 0; thisRefI < pair.second.GetCount(); ++thisRefI )
+        {
+            SCH_REFERENCE& thisRef = pair.second[thisRefI];
+            lockedInstances[ thisRef.GetComp() ].emplace_back( &thisRef, &pair.second );
+        }
+    }
 
     for( unsigned ii = 0; ii < flatList.size(); ii++ )
     {
@@ -320,21 +368,18 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
 
         // Check whether this component is in aLockedUnitMap.
         SCH_REFERENCE_LIST* lockedList = NULL;
-        for( SCH_MULTI_UNIT_REFERENCE_MAP::value_type& pair : aLockedUnitMap )
-        {
-            unsigned n_refs = pair.second.GetCount();
+        auto lockedIt = lockedInstances.find( ref_unit.GetComp() );
 
-            for( unsigned thisRefI = 0; thisRefI < n_refs; ++thisRefI )
+        if( lockedIt != lockedInstances.end() )
+        {
+            for( auto& locked : lockedIt->second )
             {
-                SCH_REFERENCE &thisRef = pair.second[thisRefI];
-
-                if( thisRef.IsSameInstance( ref_unit ) )
+                if( locked.first->IsSameInstance( ref_unit ) )
                 {
-                    lockedList = &pair.second;
+                    lockedList = locked.second;
                     break;
                 }
             }
-            if( lockedList != NULL ) break;
         }
 
         if(  ( flatList[first].CompareRef( ref_unit ) != 0 )
@@ -349,7 +394,7 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
             else
                 minRefId = aStartNumber + 1;
 
-            GetRefsInUse( first, idList, minRefId );
+            prefix = &registry[ ref_unit.GetRefStr() ];
         }
 
         // Annotation of one part per package components (trivial case).
@@ -357,8 +402,9 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
         {
             if( ref_unit.m_IsNew )
             {
-                LastReferenceNumber = CreateFirstFreeRefId( idList, minRefId );
+                LastReferenceNumber = findFreeRefId( *prefix, minRefId );
                 ref_unit.m_NumRef = LastReferenceNumber;
+                registerNumber( registry, ii );
             }
 
             ref_unit.m_Unit  = 1;
@@ -372,8 +418,9 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
 
         if( ref_unit.m_IsNew )
         {
-            LastReferenceNumber = CreateFirstFreeRefId( idList, minRefId );
+            LastReferenceNumber = findFreeRefId( *prefix, minRefId );
             ref_unit.m_NumRef = LastReferenceNumber;
+            registerNumber( registry, ii );
 
             if( !ref_unit.IsUnitsLocked() )
                 ref_unit.m_Unit = 1;
@@ -406,9 +453,9 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
                     continue;
 
                 // Find the matching component
-                for( unsigned jj = ii + 1; jj < flatList.size(); jj++ )
+                for( size_t jj : instances[ thisRef.GetComp() ] )
                 {
-                    if( ! thisRef.IsSameInstance( flatList[jj] ) )
+                    if( jj <= ii || !thisRef.IsSameInstance( flatList[jj] ) )
                         continue;
 
                     wxString ref_candidate = buildFullReference( ref_unit, thisRef.m_Unit );
@@ -422,6 +469,7 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
                         flatList[jj].m_Unit = thisRef.m_Unit;
                         flatList[jj].m_IsNew = false;
                         flatList[jj].m_Flag = 1;
+                        registerNumber( registry, jj );
                         // lock this new full reference
                         inUseRefs.insert( ref_candidate );
                         break;
@@ -440,22 +488,23 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
                 if( ref_unit.m_Unit == Unit )
                     continue;
 
-                int found = FindUnit( ii, Unit );
+                int found = findUnit( *prefix, ii, Unit );
 
                 if( found >= 0 )
                     continue; // this unit exists for this reference (unit already annotated)
 
                 // Search a component to annotate ( same prefix, same value, not annotated)
-                for( unsigned jj = ii + 1; jj < flatList.size(); jj++ )
+                auto start = std::upper_bound( prefix->m_Members.begin(),
+                                               prefix->m_Members.end(), (size_t) ii );
+
+                for( auto it = start; it != prefix->m_Members.end(); ++it )
                 {
+                    size_t jj = *it;
                     auto& cmp_unit = flatList[jj];
 
                     if( cmp_unit.m_Flag )    // already tested
                         continue;
 
-                    if( cmp_unit.CompareRef( ref_unit ) != 0 )
-                        continue;
-
                     if( cmp_unit.CompareValue( ref_unit ) != 0 )
                         continue;
 
@@ -477,6 +526,7 @@ void SCH_REFERENCE_LIST::Annotate( bool aUseSheetNum, int aSheetIntervalId, int
                         cmp_unit.m_Unit   = Unit;
                         cmp_unit.m_Flag   = 1;
                         cmp_unit.m_IsNew  = false;
+                        registerNumber( registry, jj );
                         break;
                     }
                 }
@@ -42,7 +42,7 @@
 
 #include <connection_graph.h>
 
-bool CONNECTION_SUBGRAPH::ResolveDrivers( bool aCreateMarkers )
+bool CONNECTION_SUBGRAPH::ResolveDrivers( std::vector<SCH_MARKER*>* aMarkers )
 {
     PRIORITY               highest_priority = PRIORITY::INVALID;
     std::vector<SCH_ITEM*> candidates;
@@ -134,7 +134,7 @@ bool CONNECTION_SUBGRAPH::ResolveDrivers( bool aCreateMarkers )
     else
         m_driver_connection = nullptr;
 
-    if( aCreateMarkers && m_multiple_drivers )
+    if( aMarkers && m_multiple_drivers )
     {
         // First check if all the candidates are actually the same
         bool same = true;
@@ -175,15 +175,15 @@ bool CONNECTION_SUBGRAPH::ResolveDrivers( bool aCreateMarkers )
             marker->SetErrorLevel( MARKER_BASE::MARKER_SEVERITY_WARNING );
             marker->SetData( ERCE_DRIVER_CONFLICT, p0, msg, p1 );
 
-            m_sheet.LastScreen()->Append( marker );
+            aMarkers->push_back( marker );
 
-            // If aCreateMarkers is true, then this is part of ERC check, so we
+            // If aMarkers is set, then this is part of ERC check, so we
             // should return false even if the driver was assigned
             return false;
         }
     }
 
-    return aCreateMarkers || ( m_driver != nullptr );
+    return aMarkers || ( m_driver != nullptr );
 }
 
 
@@ -1884,48 +1884,114 @@ std::vector<const CONNECTION_SUBGRAPH*> CONNECTION_GRAPH::GetBusesNeedingMigrati
 
 int CONNECTION_GRAPH::RunERC( const ERC_SETTINGS& aSettings, bool aCreateMarkers )
 {
+    // Subgraphs are checked in parallel.  Each subgraph collects its own markers, and they
+    // are added to the screens afterwards in subgraph order, so the result is the same as a
+    // serial run whatever the thread scheduling.
+    std::vector<std::vector<SCH_MARKER*>> markers( m_subgraphs.size() );
+    std::vector<int>                      errors( m_subgraphs.size(), 0 );
+
+    // SCH_COMPONENT::GetRef() adds missing references on the fly; make sure it won't have to
+    // do so from the worker threads when building marker messages.
+    SCH_SHEET_LIST sheets( g_RootSheet );
+
+    for( const SCH_SHEET_PATH& sheet : sheets )
+    {
+        for( auto item : sheet.LastScreen()->Items().OfType( SCH_COMPONENT_T ) )
+            static_cast<SCH_COMPONENT*>( item )->GetRef( &sheet );
+    }
+
+    // We don't want to spin up a new thread for fewer than 4 subgraphs (overhead costs)
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+            ( m_subgraphs.size() + 3 ) / 4 );
+
+    auto run_parallel = [&]( auto aCheck )
+    {
+        std::atomic<size_t> nextSubgraph( 0 );
+        std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+        auto check_lambda = [&]() -> size_t
+        {
+            for( size_t ii = nextSubgraph++; ii < m_subgraphs.size(); ii = nextSubgraph++ )
+                aCheck( ii, m_subgraphs[ii], aCreateMarkers ? &markers[ii] : nullptr );
+
+            return 1;
+        };
+
+        if( parallelThreadCount <= 1 )
+            check_lambda();
+        else
+        {
+            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+                returns[ii] = std::async( std::launch::async, check_lambda );
+
+            // Finalize the threads
+            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+                returns[ii].wait();
+        }
+    };
+
+    // Driver resolution updates the subgraph, and the label checks below read the drivers of
+    // neighbouring subgraphs, so it must be finished for all subgraphs before they start.
+    if( aSettings.check_bus_driver_conflicts )
+    {
+        run_parallel( [&]( size_t aIdx, CONNECTION_SUBGRAPH* aSubgraph,
+                           std::vector<SCH_MARKER*>* aMarkers )
+                      {
+                          if( !aSubgraph->ResolveDrivers( aMarkers ) )
+                              errors[aIdx]++;
+                      } );
+    }
+
+    run_parallel( [&]( size_t aIdx, CONNECTION_SUBGRAPH* aSubgraph,
+                       std::vector<SCH_MARKER*>* aMarkers )
+                  {
+                      // Graph is supposed to be up-to-date before calling RunERC()
+                      wxASSERT( !aSubgraph->m_dirty );
+
+                      /**
+                       * NOTE:
+                       *
+                       * We could check that labels attached to bus subgraphs follow the
+                       * proper format (i.e. actually define a bus).
+                       *
+                       * This check doesn't need to be here right now because labels
+                       * won't actually be connected to bus wires if they aren't in the right
+                       * format due to their TestDanglingEnds() implementation.
+                       */
+
+                      if( aSettings.check_bus_to_net_conflicts &&
+                          !ercCheckBusToNetConflicts( aSubgraph, aMarkers ) )
+                          errors[aIdx]++;
+
+                      if( aSettings.check_bus_entry_conflicts &&
+                          !ercCheckBusToBusEntryConflicts( aSubgraph, aMarkers ) )
+                          errors[aIdx]++;
+
+                      if( aSettings.check_bus_to_bus_conflicts &&
+                          !ercCheckBusToBusConflicts( aSubgraph, aMarkers ) )
+                          errors[aIdx]++;
+
+                      // The following checks are always performed since they don't currently
+                      // have an option exposed to the user
+
+                      if( !ercCheckNoConnects( aSubgraph, aMarkers ) )
+                          errors[aIdx]++;
+
+                      if( !ercCheckLabels( aSubgraph, aMarkers,
+                                           aSettings.check_unique_global_labels ) )
+                          errors[aIdx]++;
+                  } );
+
     int error_count = 0;
 
-    for( auto&& subgraph : m_subgraphs )
+    for( size_t ii = 0; ii < m_subgraphs.size(); ++ii )
     {
-        // Graph is supposed to be up-to-date before calling RunERC()
-        wxASSERT( !subgraph->m_dirty );
+        SCH_SCREEN* screen = m_subgraphs[ii]->m_sheet.LastScreen();
+
+        for( SCH_MARKER* marker : markers[ii] )
+            screen->Append( marker );
 
-        /**
-         * NOTE:
-         *
-         * We could check that labels attached to bus subgraphs follow the
-         * proper format (i.e. actually define a bus).
-         *
-         * This check doesn't need to be here right now because labels
-         * won't actually be connected to bus wires if they aren't in the right
-         * format due to their TestDanglingEnds() implementation.
-         */
-
-        if( aSettings.check_bus_driver_conflicts &&
-            !subgraph->ResolveDrivers( aCreateMarkers ) )
-            error_count++;
-
-        if( aSettings.check_bus_to_net_conflicts &&
-            !ercCheckBusToNetConflicts( subgraph, aCreateMarkers ) )
-            error_count++;
-
-        if( aSettings.check_bus_entry_conflicts &&
-            !ercCheckBusToBusEntryConflicts( subgraph, aCreateMarkers ) )
-            error_count++;
-
-        if( aSettings.check_bus_to_bus_conflicts &&
-            !ercCheckBusToBusConflicts( subgraph, aCreateMarkers ) )
-            error_count++;
-
-        // The following checks are always performed since they don't currently
-        // have an option exposed to the user
-
-        if( !ercCheckNoConnects( subgraph, aCreateMarkers ) )
-            error_count++;
-
-        if( !ercCheckLabels( subgraph, aCreateMarkers, aSettings.check_unique_global_labels ) )
-            error_count++;
+        error_count += errors[ii];
     }
 
     return error_count;
@@ -1933,11 +1999,10 @@ int CONNECTION_GRAPH::RunERC( const ERC_SETTINGS& aSettings, bool aCreateMarkers
 
 
 bool CONNECTION_GRAPH::ercCheckBusToNetConflicts( const CONNECTION_SUBGRAPH* aSubgraph,
-                                                  bool aCreateMarkers )
+                                                  std::vector<SCH_MARKER*>* aMarkers )
 {
     wxString msg;
     auto sheet = aSubgraph->m_sheet;
-    auto screen = sheet.LastScreen();
 
     SCH_ITEM* net_item = nullptr;
     SCH_ITEM* bus_item = nullptr;
@@ -1977,7 +2042,7 @@ bool CONNECTION_GRAPH::ercCheckBusToNetConflicts( const CONNECTION_SUBGRAPH* aSu
 
     if( net_item && bus_item )
     {
-        if( aCreateMarkers )
+        if( aMarkers )
         {
             msg.Printf( _( "%s and %s are graphically connected but cannot"
                            " electrically connect because one is a bus and"
@@ -1992,7 +2057,7 @@ bool CONNECTION_GRAPH::ercCheckBusToNetConflicts( const CONNECTION_SUBGRAPH* aSu
                              net_item->GetPosition(), msg,
                              bus_item->GetPosition() );
 
-            screen->Append( marker );
+            aMarkers->push_back( marker );
         }
 
         return false;
@@ -2003,11 +2068,10 @@ bool CONNECTION_GRAPH::ercCheckBusToNetConflicts( const CONNECTION_SUBGRAPH* aSu
 
 
 bool CONNECTION_GRAPH::ercCheckBusToBusConflicts( const CONNECTION_SUBGRAPH* aSubgraph,
-                                                  bool aCreateMarkers )
+                                                  std::vector<SCH_MARKER*>* aMarkers )
 {
     wxString msg;
     auto sheet = aSubgraph->m_sheet;
-    auto screen = sheet.LastScreen();
 
     SCH_ITEM* label = nullptr;
     SCH_ITEM* port = nullptr;
@@ -2058,7 +2122,7 @@ bool CONNECTION_GRAPH::ercCheckBusToBusConflicts( const CONNECTION_SUBGRAPH* aSu
 
         if( !match )
         {
-            if( aCreateMarkers )
+            if( aMarkers )
             {
                 msg.Printf( _( "%s and %s are graphically connected but do "
                                "not share any bus members" ),
@@ -2072,7 +2136,7 @@ bool CONNECTION_GRAPH::ercCheckBusToBusConflicts( const CONNECTION_SUBGRAPH* aSu
                                  label->GetPosition(), msg,
                                  port->GetPosition() );
 
-                screen->Append( marker );
+                aMarkers->push_back( marker );
             }
 
             return false;
@@ -2084,12 +2148,11 @@ bool CONNECTION_GRAPH::ercCheckBusToBusConflicts( const CONNECTION_SUBGRAPH* aSu
 
 
 bool CONNECTION_GRAPH::ercCheckBusToBusEntryConflicts( const CONNECTION_SUBGRAPH* aSubgraph,
-                                                       bool aCreateMarkers )
+                                                       std::vector<SCH_MARKER*>* aMarkers )
 {
     wxString msg;
     bool conflict = false;
     auto sheet = aSubgraph->m_sheet;
-    auto screen = sheet.LastScreen();
 
     SCH_BUS_WIRE_ENTRY* bus_entry = nullptr;
     SCH_ITEM* bus_wire = nullptr;
@@ -2150,7 +2213,7 @@ bool CONNECTION_GRAPH::ercCheckBusToBusEntryConflicts( const CONNECTION_SUBGRAPH
 
     if( conflict )
     {
-        if( aCreateMarkers )
+        if( aMarkers )
         {
             msg.Printf( _( "%s (%s) is connected to %s (%s) but is not a member of the bus" ),
                         bus_entry->GetSelectMenuText( m_frame->GetUserUnits() ),
@@ -2165,7 +2228,7 @@ bool CONNECTION_GRAPH::ercCheckBusToBusEntryConflicts( const CONNECTION_SUBGRAPH
                              bus_entry->GetPosition(), msg,
                              bus_entry->GetPosition() );
 
-            screen->Append( marker );
+            aMarkers->push_back( marker );
         }
 
         return false;
@@ -2177,11 +2240,10 @@ bool CONNECTION_GRAPH::ercCheckBusToBusEntryConflicts( const CONNECTION_SUBGRAPH
 
 // TODO(JE) Check sheet pins here too?
 bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph,
-                                           bool aCreateMarkers )
+                                           std::vector<SCH_MARKER*>* aMarkers )
 {
     wxString msg;
     auto sheet = aSubgraph->m_sheet;
-    auto screen = sheet.LastScreen();
 
     if( aSubgraph->m_no_connect != nullptr )
     {
@@ -2216,7 +2278,7 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph,
 
         if( pin && has_invalid_items )
         {
-            if( aCreateMarkers )
+            if( aMarkers )
             {
                 wxPoint pos = pin->GetTransformedPosition();
 
@@ -2229,7 +2291,7 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph,
                 marker->SetErrorLevel( MARKER_BASE::MARKER_SEVERITY_WARNING );
                 marker->SetData( ERCE_NOCONNECT_CONNECTED, pos, msg, pos );
 
-                screen->Append( marker );
+                aMarkers->push_back( marker );
             }
 
             return false;
@@ -2237,7 +2299,7 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph,
 
         if( !has_other_items )
         {
-            if( aCreateMarkers )
+            if( aMarkers )
             {
                 wxPoint pos = aSubgraph->m_no_connect->GetPosition();
 
@@ -2248,7 +2310,7 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph,
                 marker->SetErrorLevel( MARKER_BASE::MARKER_SEVERITY_WARNING );
                 marker->SetData( ERCE_NOCONNECT_NOT_CONNECTED, pos, msg, pos );
 
-                screen->Append( marker );
+                aMarkers->push_back( marker );
             }
 
             return false;
@@ -2300,7 +2362,7 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph,
 
         if( pin && !has_other_connections && pin->GetType() != ELECTRICAL_PINTYPE::PT_NC )
         {
-            if( aCreateMarkers )
+            if( aMarkers )
             {
                 wxPoint pos = pin->GetTransformedPosition();
 
@@ -2313,7 +2375,7 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph,
                 marker->SetErrorLevel( MARKER_BASE::MARKER_SEVERITY_WARNING );
                 marker->SetData( ERCE_PIN_NOT_CONNECTED, pos, msg, pos );
 
-                screen->Append( marker );
+                aMarkers->push_back( marker );
             }
 
             return false;
@@ -2325,7 +2387,8 @@ bool CONNECTION_GRAPH::ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph,
 
 
 bool CONNECTION_GRAPH::ercCheckLabels( const CONNECTION_SUBGRAPH* aSubgraph,
-                                       bool aCreateMarkers, bool aCheckGlobalLabels )
+                                       std::vector<SCH_MARKER*>* aMarkers,
+                                       bool aCheckGlobalLabels )
 {
     // Label connection rules:
     // Local labels are flagged if they don't connect to any pins and don't have a no-connect
@@ -2403,9 +2466,8 @@ bool CONNECTION_GRAPH::ercCheckLabels( const CONNECTION_SUBGRAPH* aSubgraph,
 
     if( !has_other_connections )
     {
-        if( aCreateMarkers )
+        if( aMarkers )
         {
-            SCH_SCREEN* screen = aSubgraph->m_sheet.LastScreen();
             wxPoint pos = text->GetPosition();
             auto marker = new SCH_MARKER();
 
@@ -2420,7 +2482,7 @@ bool CONNECTION_GRAPH::ercCheckLabels( const CONNECTION_SUBGRAPH* aSubgraph,
             marker->SetErrorLevel( MARKER_BASE::MARKER_SEVERITY_WARNING );
             marker->SetData( type, pos, msg, pos );
 
-            screen->Append( marker );
+            aMarkers->push_back( marker );
         }
 
         return false;
@@ -38,6 +38,7 @@
 
 class SCH_EDIT_FRAME;
 class SCH_HIERLABEL;
+class SCH_MARKER;
 class SCH_PIN;
 class SCH_SHEET_PIN;
 
@@ -85,10 +86,10 @@ public:
      * If multiple possible drivers exist, picks one according to the priority.
      * If multiple "winners" exist, returns false and sets m_driver to nullptr.
      *
-     * @param aCreateMarkers controls whether ERC markers should be added for conflicts
+     * @param aMarkers receives ERC markers for conflicts, or nullptr to create no markers
      * @return true if m_driver was set, or false if a conflict occurred
      */
-    bool ResolveDrivers( bool aCreateMarkers = false );
+    bool ResolveDrivers( std::vector<SCH_MARKER*>* aMarkers = nullptr );
 
     /**
      * Returns the fully-qualified net name for this subgraph (if one exists)
@@ -254,6 +255,9 @@ public:
      *
      * Precondition: graph is up-to-date
      *
+     * Subgraphs are checked on all available cores; markers are added to the
+     * screens in subgraph order once all checks are done.
+     *
      * @param aSettings is used to control which tests to run
      * @param aCreateMarkers controls whether error markers are created
      * @return the number of errors found
@@ -404,11 +408,11 @@ private:
      * For example, a net wire connected to a bus port/pin, or vice versa
      *
      * @param  aSubgraph      is the subgraph to examine
-     * @param  aCreateMarkers controls whether error markers are created
+     * @param  aMarkers       receives the error markers, or nullptr to create no markers
      * @return                true for no errors, false for errors
      */
     bool ercCheckBusToNetConflicts( const CONNECTION_SUBGRAPH* aSubgraph,
-                                    bool aCreateMarkers );
+                                    std::vector<SCH_MARKER*>* aMarkers );
 
     /**
      * Checks one subgraph for conflicting connections between two bus items
@@ -418,11 +422,11 @@ private:
      * sheet pin
      *
      * @param  aSubgraph      is the subgraph to examine
-     * @param  aCreateMarkers controls whether error markers are created
+     * @param  aMarkers       receives the error markers, or nullptr to create no markers
      * @return                true for no errors, false for errors
      */
     bool ercCheckBusToBusConflicts( const CONNECTION_SUBGRAPH* aSubgraph,
-                                    bool aCreateMarkers );
+                                    std::vector<SCH_MARKER*>* aMarkers );
 
     /**
      * Checks one subgraph for conflicting bus entry to bus connections
@@ -434,11 +438,11 @@ private:
      * "USB.DP" but someone might accidentally just enter "DP"
      *
      * @param  aSubgraph      is the subgraph to examine
-     * @param  aCreateMarkers controls whether error markers are created
+     * @param  aMarkers       receives the error markers, or nullptr to create no markers
      * @return                true for no errors, false for errors
      */
     bool ercCheckBusToBusEntryConflicts( const CONNECTION_SUBGRAPH* aSubgraph,
-                                         bool aCreateMarkers );
+                                         std::vector<SCH_MARKER*>* aMarkers );
 
     /**
      * Checks one subgraph for proper presence or absence of no-connect symbols
@@ -447,11 +451,11 @@ private:
      * A pin without a no-connect symbol should have at least one connection
      *
      * @param  aSubgraph      is the subgraph to examine
-     * @param  aCreateMarkers controls whether error markers are created
+     * @param  aMarkers       receives the error markers, or nullptr to create no markers
      * @return                true for no errors, false for errors
      */
     bool ercCheckNoConnects( const CONNECTION_SUBGRAPH* aSubgraph,
-                             bool aCreateMarkers );
+                             std::vector<SCH_MARKER*>* aMarkers );
 
     /**
      * Checks one subgraph for proper connection of labels
@@ -459,12 +463,12 @@ private:
      * Labels should be connected to something
      *
      * @param  aSubgraph      is the subgraph to examine
-     * @param  aCreateMarkers controls whether error markers are created
+     * @param  aMarkers       receives the error markers, or nullptr to create no markers
      * @param  aCheckGlobalLabels is true if global labels should be checked for loneliness
      * @return                true for no errors, false for errors
      */
-    bool ercCheckLabels( const CONNECTION_SUBGRAPH* aSubgraph, bool aCreateMarkers,
-                         bool aCheckGlobalLabels );
+    bool ercCheckLabels( const CONNECTION_SUBGRAPH* aSubgraph,
+                         std::vector<SCH_MARKER*>* aMarkers, bool aCheckGlobalLabels );
 
 };
 
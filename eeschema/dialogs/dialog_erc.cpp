@@ -23,6 +23,10 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
+#include <atomic>
+#include <future>
+#include <thread>
+
 #include <fctsys.h>
 #include <gestfich.h>
 #include <pgm_base.h>
@@ -517,89 +521,118 @@ void DIALOG_ERC::TestErc( REPORTER& aReporter )
     // Reset the connection type indicator
     objectsConnectedList->ResetConnectionsType();
 
-    unsigned lastItemIdx = 0;
-    unsigned nextItemIdx = 0;
-    int MinConn    = NOC;
-
     // Check that a pin appears in only one net.  This check is necessary because multi-unit
     // components that have shared pins could be wired to different nets.
     std::unordered_map<wxString, wxString> pin_to_net_map;
 
     // The netlist generated by SCH_EDIT_FRAME::BuildNetListBase is sorted by net number, which
-    // means we can group netlist items into ranges that live in the same net. The range from
-    // nextItem to the current item (exclusive) needs to be checked against the current item.
-    // The lastItem variable is used as a helper to pass the last item's number from one loop
-    // iteration to the next, which simplifies the initial pass.
+    // means we can group netlist items into ranges that live in the same net.  Each range holds
+    // the first item and one past the last item of a net.
+    std::vector<std::pair<unsigned, unsigned>> netRanges;
+
+    // The pin markers of this first pass, by item, to be added with the markers of their net
+    ERC_MARKER_LIST unitNetMarkers( objectsConnectedList->size(), { nullptr, nullptr } );
+
     for( unsigned itemIdx = 0; itemIdx < objectsConnectedList->size(); itemIdx++ )
     {
         auto item = objectsConnectedList->GetItem( itemIdx );
-        auto lastItem = objectsConnectedList->GetItem( lastItemIdx );
-
-        auto lastNet = lastItem->GetNet();
-        auto net = item->GetNet();
 
-        wxASSERT_MSG( lastNet <= net, wxT( "Netlist not correctly ordered" ) );
-
-        if( lastNet != net )
+        if( netRanges.empty()
+                || objectsConnectedList->GetItemNet( netRanges.back().first ) != item->GetNet() )
         {
-            // New net found:
-            MinConn      = NOC;
-            nextItemIdx = itemIdx;
+            wxASSERT_MSG( netRanges.empty()
+                          || objectsConnectedList->GetItemNet( netRanges.back().first )
+                                     < item->GetNet(),
+                          wxT( "Netlist not correctly ordered" ) );
+
+            netRanges.emplace_back( itemIdx, itemIdx );
         }
 
-        switch( item->m_Type )
-        {
-        // These items do not create erc problems
-        case NETLIST_ITEM::ITEM_UNSPECIFIED:
-        case NETLIST_ITEM::SEGMENT:
-        case NETLIST_ITEM::BUS:
-        case NETLIST_ITEM::JUNCTION:
-        case NETLIST_ITEM::LABEL:
-        case NETLIST_ITEM::BUSLABELMEMBER:
-        case NETLIST_ITEM::PINLABEL:
-        case NETLIST_ITEM::GLOBBUSLABELMEMBER:
-            break;
+        netRanges.back().second = itemIdx + 1;
 
         // TODO(JE) Port this to the new system
-        case NETLIST_ITEM::PIN:
+        // Check if this pin has appeared before on a different net
+        if( item->m_Type == NETLIST_ITEM::PIN && item->m_Link )
         {
-            // Check if this pin has appeared before on a different net
-            if( item->m_Link )
+            auto ref = item->GetComponentParent()->GetRef( &item->m_SheetPath );
+            wxString pin_name = ref + "_" + item->m_PinNum;
+
+            if( pin_to_net_map.count( pin_name ) == 0 )
+            {
+                pin_to_net_map[pin_name] = item->GetNetName();
+            }
+            else if( pin_to_net_map[pin_name] != item->GetNetName() )
             {
-                auto ref = item->GetComponentParent()->GetRef( &item->m_SheetPath );
-                wxString pin_name = ref + "_" + item->m_PinNum;
+                SCH_MARKER* marker = new SCH_MARKER();
+
+                marker->SetData( ERCE_DIFFERENT_UNIT_NET, item->m_Start,
+                                 wxString::Format( _( "Pin %s on %s is connected to both %s and %s" ),
+                                                   item->m_PinNum,
+                                                   ref,
+                                                   pin_to_net_map[pin_name],
+                                                   item->GetNetName() ),
+                                                   item->m_Start );
+                marker->SetMarkerType( MARKER_BASE::MARKER_ERC );
+                marker->SetErrorLevel( MARKER_BASE::MARKER_SEVERITY_ERROR );
+
+                unitNetMarkers[itemIdx] = { item->m_SheetPath.LastScreen(), marker };
+            }
+        }
+    }
 
-                if( pin_to_net_map.count( pin_name ) == 0 )
-                {
-                    pin_to_net_map[pin_name] = item->GetNetName();
-                }
-                else if( pin_to_net_map[pin_name] != item->GetNetName() )
+    // Look for ERC problems between pins.  TestOthersItems() only modifies items of the net
+    // it tests, so nets are tested in parallel.  Each net collects its own markers, which are
+    // added to the screens in net order afterwards to keep the result deterministic.  The
+    // markers of a pin connected to several nets are added just before the other markers of
+    // the pin, as when the nets were tested in the first pass.
+    std::vector<ERC_MARKER_LIST> netMarkers( netRanges.size() );
+    std::atomic<size_t> nextNet( 0 );
+
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+            ( netRanges.size() + 15 ) / 16 );
+
+    auto test_lambda = [&]() -> size_t
+    {
+        for( size_t netIdx = nextNet++; netIdx < netRanges.size(); netIdx = nextNet++ )
+        {
+            unsigned first = netRanges[netIdx].first;
+            int      minConn = NOC;
+
+            for( unsigned itemIdx = first; itemIdx < netRanges[netIdx].second; itemIdx++ )
+            {
+                // Only pins can create erc problems here
+                if( objectsConnectedList->GetItemType( itemIdx ) == NETLIST_ITEM::PIN )
                 {
-                    SCH_MARKER* marker = new SCH_MARKER();
-
-                    marker->SetData( ERCE_DIFFERENT_UNIT_NET, item->m_Start,
-                                     wxString::Format( _( "Pin %s on %s is connected to both %s and %s" ),
-                                                       item->m_PinNum,
-                                                       ref,
-                                                       pin_to_net_map[pin_name],
-                                                       item->GetNetName() ),
-                                                       item->m_Start );
-                    marker->SetMarkerType( MARKER_BASE::MARKER_ERC );
-                    marker->SetErrorLevel( MARKER_BASE::MARKER_SEVERITY_ERROR );
-
-                    item->m_SheetPath.LastScreen()->Append( marker );
+                    if( unitNetMarkers[itemIdx].second )
+                        netMarkers[netIdx].push_back( unitNetMarkers[itemIdx] );
+
+                    TestOthersItems( objectsConnectedList.get(), itemIdx, first, &minConn,
+                                     &netMarkers[netIdx] );
                 }
             }
-
-            // Look for ERC problems between pins:
-            TestOthersItems( objectsConnectedList.get(), itemIdx, nextItemIdx, &MinConn );
-            break;
-        }
-        default:
-        break;
         }
 
-        lastItemIdx = itemIdx;
+        return 1;
+    };
+
+    if( parallelThreadCount <= 1 )
+        test_lambda();
+    else
+    {
+        std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, test_lambda );
+
+        // Finalize the threads
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii].wait();
+    }
+
+    for( const ERC_MARKER_LIST& markers : netMarkers )
+    {
+        for( const auto& entry : markers )
+            entry.first->Append( entry.second );
     }
 
     // Test similar labels (i;e. labels which are identical when
@@ -319,7 +319,8 @@ int TestMultiunitFootprints( SCH_SHEET_LIST& aSheetList )
 }
 
 
-void Diagnose( NETLIST_OBJECT* aNetItemRef, NETLIST_OBJECT* aNetItemTst, int aMinConn, int aDiag )
+void Diagnose( NETLIST_OBJECT* aNetItemRef, NETLIST_OBJECT* aNetItemTst, int aMinConn, int aDiag,
+               ERC_MARKER_LIST* aMarkers )
 {
     SCH_MARKER*     marker = NULL;
     SCH_SCREEN*     screen;
@@ -333,7 +334,11 @@ void Diagnose( NETLIST_OBJECT* aNetItemRef, NETLIST_OBJECT* aNetItemTst, int aMi
     marker->SetMarkerType( MARKER_BASE::MARKER_ERC );
     marker->SetErrorLevel( MARKER_BASE::MARKER_SEVERITY_WARNING );
     screen = aNetItemRef->m_SheetPath.LastScreen();
-    screen->Append( marker );
+
+    if( aMarkers )
+        aMarkers->emplace_back( screen, marker );
+    else
+        screen->Append( marker );
 
     wxString msg;
 
@@ -394,7 +399,7 @@ void Diagnose( NETLIST_OBJECT* aNetItemRef, NETLIST_OBJECT* aNetItemTst, int aMi
 
 
 void TestOthersItems( NETLIST_OBJECT_LIST* aList, unsigned aNetItemRef, unsigned aNetStart,
-                      int* aMinConnexion )
+                      int* aMinConnexion, ERC_MARKER_LIST* aMarkers )
 {
     unsigned netItemTst = aNetStart;
     ELECTRICAL_PINTYPE jj;
@@ -468,7 +473,7 @@ void TestOthersItems( NETLIST_OBJECT_LIST* aList, unsigned aNetItemRef, unsigned
                 }
 
                 if( seterr )
-                    Diagnose( aList->GetItem( aNetItemRef ), NULL, local_minconn, WAR );
+                    Diagnose( aList->GetItem( aNetItemRef ), NULL, local_minconn, WAR, aMarkers );
 
                 *aMinConnexion = DRV;   // inhibiting other messages of this
                                        // type for the net.
@@ -515,7 +520,7 @@ void TestOthersItems( NETLIST_OBJECT_LIST* aList, unsigned aNetItemRef, unsigned
                     if( aList->GetConnectionType( netItemTst ) == NET_CONNECTION::UNCONNECTED )
                     {
                         Diagnose( aList->GetItem( aNetItemRef ), aList->GetItem( netItemTst ), 0,
-                                erc );
+                                erc, aMarkers );
                         aList->SetConnectionType(
                                 netItemTst, NET_CONNECTION::NOCONNECT_SYMBOL_PRESENT );
                     }
@@ -30,11 +30,18 @@
 #ifndef _ERC_H
 #define _ERC_H
 
+#include <vector>
+
 
 class NETLIST_OBJECT;
 class NETLIST_OBJECT_LIST;
+class SCH_MARKER;
+class SCH_SCREEN;
 class SCH_SHEET_LIST;
 
+/// ERC markers waiting to be added to their screens, used by checks run on worker threads
+typedef std::vector<std::pair<SCH_SCREEN*, SCH_MARKER*>> ERC_MARKER_LIST;
+
 /* For ERC markers: error types (used in diags, and to set the color):
 */
 enum errortype
@@ -94,9 +101,11 @@ bool WriteDiagnosticERC( EDA_UNITS aUnits, const wxString& aFullFileName );
  * Performs ERC testing and creates an ERC marker to show the ERC problem for aNetItemRef
  * or between aNetItemRef and aNetItemTst.
  *  if MinConn < 0: this is an error on labels
+ * @param aMarkers = if not null, the marker is stored here instead of being added to
+ * its screen
  */
 void Diagnose( NETLIST_OBJECT* NetItemRef, NETLIST_OBJECT* NetItemTst,
-                      int MinConnexion, int Diag );
+                      int MinConnexion, int Diag, ERC_MARKER_LIST* aMarkers = nullptr );
 
 /**
  * Perform ERC testing for electrical conflicts between \a NetItemRef and other items
@@ -106,10 +115,13 @@ void Diagnose( NETLIST_OBJECT* NetItemRef, NETLIST_OBJECT* NetItemTst,
  * @param aNetStart = index in list of net objects of the first item
  * @param aMinConnexion = a pointer to a variable to store the minimal connection
  * found( NOD, DRV, NPI, NET_NC)
+ * @param aMarkers = if not null, markers are stored here instead of being added to
+ * their screens.  Only items of the tested net are modified, so different nets can
+ * then be tested concurrently.
  */
 void TestOthersItems( NETLIST_OBJECT_LIST* aList,
                              unsigned aNetItemRef, unsigned aNetStart,
-                             int* aMinConnexion );
+                             int* aMinConnexion, ERC_MARKER_LIST* aMarkers = nullptr );
 
 /**
  * Function TestDuplicateSheetNames( )
@@ -227,6 +227,9 @@ void SCH_EDIT_FRAME::SelectUnit( SCH_COMPONENT* aComponent, int aUnit )
     aComponent->ClearFlags();
     aComponent->SetFlags( savedFlags ); // Restore m_Flag modified by SetUnit()
 
+    // The unit's pins are at other positions
+    GetScreen()->Update( aComponent );
+
     if( !aComponent->GetEditFlags() )   // No command in progress: update schematic
     {
         if( m_autoplaceFields )
@@ -276,6 +279,7 @@ void SCH_EDIT_FRAME::ConvertPart( SCH_COMPONENT* aComponent )
         // The alternate symbol may cause a change in the connection status so test the
         // connections so the connection indicators are drawn correctly.
         aComponent->UpdatePins();
+        GetScreen()->Update( aComponent );
         TestDanglingEnds();
         aComponent->ClearFlags();
         aComponent->SetFlags( savedFlags );   // Restore m_Flags (modified by SetConvert())
@@ -197,18 +197,12 @@ void NETLIST_EXPORTER_GENERIC::addComponentFields( XNODE* xcomp, SCH_COMPONENT*
 }
 
 
-XNODE* NETLIST_EXPORTER_GENERIC::makeComponents()
+void NETLIST_EXPORTER_GENERIC::collectComponents( SCH_SHEET_LIST& aSheetList,
+        std::vector<std::pair<SCH_COMPONENT*, size_t>>& aList )
 {
-    XNODE*      xcomps = node( "components" );
-
     m_ReferencesAlreadyFound.Clear();
 
-    SCH_SHEET_LIST sheetList( g_RootSheet );
-
-    // Output is xml, so there is no reason to remove spaces from the field values.
-    // And XML element names need not be translated to various languages.
-
-    for( unsigned i = 0;  i < sheetList.size();  i++ )
+    for( unsigned i = 0;  i < aSheetList.size();  i++ )
     {
 
         auto cmp = []( const SCH_COMPONENT* a, const SCH_COMPONENT* b ) {
@@ -217,7 +211,7 @@ XNODE* NETLIST_EXPORTER_GENERIC::makeComponents()
 
         std::set<SCH_COMPONENT*, decltype( cmp )> ordered_components( cmp );
 
-        for( auto item : sheetList[i].LastScreen()->Items().OfType( SCH_COMPONENT_T ) )
+        for( auto item : aSheetList[i].LastScreen()->Items().OfType( SCH_COMPONENT_T ) )
         {
             auto comp = static_cast<SCH_COMPONENT*>( item );
             auto test = ordered_components.insert( comp );
@@ -235,45 +229,67 @@ XNODE* NETLIST_EXPORTER_GENERIC::makeComponents()
 
         for( auto item : ordered_components )
         {
-            SCH_COMPONENT* comp = findNextComponent( item, &sheetList[i] );
+            SCH_COMPONENT* comp = findNextComponent( item, &aSheetList[i] );
+
+            if( comp )
+                aList.emplace_back( comp, i );
+        }
+    }
+}
 
-            if( !comp )
-                continue;
 
-            XNODE* xcomp;  // current component being constructed
+XNODE* NETLIST_EXPORTER_GENERIC::makeComponent( SCH_COMPONENT* aComp, SCH_SHEET_PATH* aSheet )
+{
+    XNODE* xcomp = node( "comp" );
 
-            // Output the component's elements in order of expected access frequency.
-            // This may not always look best, but it will allow faster execution
-            // under XSL processing systems which do sequential searching within
-            // an element.
+    // Output the component's elements in order of expected access frequency.
+    // This may not always look best, but it will allow faster execution
+    // under XSL processing systems which do sequential searching within
+    // an element.
 
-            xcomps->AddChild( xcomp = node( "comp" ) );
-            xcomp->AddAttribute( "ref", comp->GetRef( &sheetList[i] ) );
+    xcomp->AddAttribute( "ref", aComp->GetRef( aSheet ) );
 
-            addComponentFields( xcomp, comp, &sheetList[i] );
+    addComponentFields( xcomp, aComp, aSheet );
 
-            XNODE*  xlibsource;
-            xcomp->AddChild( xlibsource = node( "libsource" ) );
+    XNODE*  xlibsource;
+    xcomp->AddChild( xlibsource = node( "libsource" ) );
 
-            // "logical" library name, which is in anticipation of a better search
-            // algorithm for parts based on "logical_lib.part" and where logical_lib
-            // is merely the library name minus path and extension.
-            if( comp->GetPartRef() )
-                xlibsource->AddAttribute( "lib", comp->GetPartRef()->GetLibId().GetLibNickname() );
+    // "logical" library name, which is in anticipation of a better search
+    // algorithm for parts based on "logical_lib.part" and where logical_lib
+    // is merely the library name minus path and extension.
+    if( aComp->GetPartRef() )
+        xlibsource->AddAttribute( "lib", aComp->GetPartRef()->GetLibId().GetLibNickname() );
 
-            // We only want the symbol name, not the full LIB_ID.
-            xlibsource->AddAttribute( "part", comp->GetLibId().GetLibItemName() );
+    // We only want the symbol name, not the full LIB_ID.
+    xlibsource->AddAttribute( "part", aComp->GetLibId().GetLibItemName() );
 
-            xlibsource->AddAttribute( "description", comp->GetDescription() );
+    xlibsource->AddAttribute( "description", aComp->GetDescription() );
 
-            XNODE* xsheetpath;
+    XNODE* xsheetpath;
 
-            xcomp->AddChild( xsheetpath = node( "sheetpath" ) );
-            xsheetpath->AddAttribute( "names", sheetList[i].PathHumanReadable() );
-            xsheetpath->AddAttribute( "tstamps", sheetList[i].Path() );
-            xcomp->AddChild( node( "tstamp", comp->m_Uuid.AsString() ) );
-        }
-    }
+    xcomp->AddChild( xsheetpath = node( "sheetpath" ) );
+    xsheetpath->AddAttribute( "names", aSheet->PathHumanReadable() );
+    xsheetpath->AddAttribute( "tstamps", aSheet->Path() );
+    xcomp->AddChild( node( "tstamp", aComp->m_Uuid.AsString() ) );
+
+    return xcomp;
+}
+
+
+XNODE* NETLIST_EXPORTER_GENERIC::makeComponents()
+{
+    XNODE*      xcomps = node( "components" );
+
+    SCH_SHEET_LIST sheetList( g_RootSheet );
+    std::vector<std::pair<SCH_COMPONENT*, size_t>> components;
+
+    // Output is xml, so there is no reason to remove spaces from the field values.
+    // And XML element names need not be translated to various languages.
+
+    collectComponents( sheetList, components );
+
+    for( const auto& entry : components )
+        xcomps->AddChild( makeComponent( entry.first, &sheetList[entry.second] ) );
 
     return xcomps;
 }
@@ -521,87 +537,31 @@ XNODE* NETLIST_EXPORTER_GENERIC::makeListOfNets( bool aUseGraph )
 
     if( aUseGraph )
     {
-        wxASSERT( m_graph );
-        int code = 0;
-
-        for( const auto& it : m_graph->GetNetMap() )
-        {
-            bool     added     = false;
-            wxString net_name  = it.first.first;
-            auto     subgraphs = it.second;
+        std::vector<NET_RECORD> records;
 
-            // Code starts at 1
-            code++;
+        resolveNets( records );
 
-            XNODE* xnode;
-            std::vector<std::pair<SCH_PIN*, SCH_SHEET_PATH>> sorted_items;
-
-            for( auto subgraph : subgraphs )
-            {
-                auto sheet = subgraph->m_sheet;
-
-                for( auto item : subgraph->m_items )
-                    if( item->Type() == SCH_PIN_T )
-                        sorted_items.emplace_back(
-                                std::make_pair( static_cast<SCH_PIN*>( item ), sheet ) );
-            }
-
-            // Netlist ordering: Net name, then ref des, then pin name
-            std::sort( sorted_items.begin(), sorted_items.end(), [] ( auto a, auto b ) {
-                        auto ref_a = a.first->GetParentComponent()->GetRef( &a.second );
-                        auto ref_b = b.first->GetParentComponent()->GetRef( &b.second );
-
-                        if( ref_a == ref_b )
-                            return a.first->GetNumber() < b.first->GetNumber();
-
-                        return ref_a < ref_b;
-                    } );
-
-            // Some duplicates can exist, for example on multi-unit parts with duplicated
-            // pins across units.  If the user connects the pins on each unit, they will
-            // appear on separate subgraphs.  Remove those here:
-            sorted_items.erase( std::unique( sorted_items.begin(), sorted_items.end(),
-                    [] ( auto a, auto b ) {
-                        auto ref_a = a.first->GetParentComponent()->GetRef( &a.second );
-                        auto ref_b = b.first->GetParentComponent()->GetRef( &b.second );
+        for( const NET_RECORD& record : records )
+        {
+            // Nets holding only power symbols and virtual components are not output
+            if( record.m_Nodes.empty() )
+                continue;
 
-                        return ref_a == ref_b && a.first->GetNumber() == b.first->GetNumber();
-                    } ), sorted_items.end() );
+            xnets->AddChild( xnet = node( "net" ) );
+            netCodeTxt.Printf( "%d", record.m_Code );
+            xnet->AddAttribute( "code", netCodeTxt );
+            xnet->AddAttribute( "name", record.m_Name );
 
-            for( const auto& pair : sorted_items )
+            for( const NET_NODE& netNode : record.m_Nodes )
             {
-                SCH_PIN* pin = pair.first;
-                SCH_SHEET_PATH sheet = pair.second;
-
-                auto refText = pin->GetParentComponent()->GetRef( &sheet );
-                const auto& pinText = pin->GetNumber();
-
-                // Skip power symbols and virtual components
-                if( refText[0] == wxChar( '#' ) )
-                    continue;
-
-                if( !added )
-                {
-                    xnets->AddChild( xnet = node( "net" ) );
-                    netCodeTxt.Printf( "%d", code );
-                    xnet->AddAttribute( "code", netCodeTxt );
-                    xnet->AddAttribute( "name", net_name );
-
-                    added = true;
-                }
+                XNODE* xnode;
 
                 xnet->AddChild( xnode = node( "node" ) );
-                xnode->AddAttribute( "ref", refText );
-                xnode->AddAttribute( "pin", pinText );
-
-                wxString pinName;
-
-                if( pin->GetName() != "~" ) //  ~ is a char used to code empty strings in libs.
-                    pinName = pin->GetName();
-
-                if( !pinName.IsEmpty() )
-                    xnode->AddAttribute( "pinfunction", pinName );
+                xnode->AddAttribute( "ref", netNode.m_Ref );
+                xnode->AddAttribute( "pin", netNode.m_Pin );
 
+                if( !netNode.m_PinFunction.IsEmpty() )
+                    xnode->AddAttribute( "pinfunction", netNode.m_PinFunction );
             }
         }
     }
@@ -655,6 +615,94 @@ XNODE* NETLIST_EXPORTER_GENERIC::makeListOfNets( bool aUseGraph )
 }
 
 
+void NETLIST_EXPORTER_GENERIC::primeReferences( SCH_SHEET_LIST& aSheetList )
+{
+    for( unsigned i = 0;  i < aSheetList.size();  i++ )
+    {
+        for( auto item : aSheetList[i].LastScreen()->Items().OfType( SCH_COMPONENT_T ) )
+            static_cast<SCH_COMPONENT*>( item )->GetRef( &aSheetList[i] );
+    }
+}
+
+
+void NETLIST_EXPORTER_GENERIC::resolveNet( const NET_MAP::value_type& aNet, int aCode,
+                                           NET_RECORD& aRecord )
+{
+    aRecord.m_Code = aCode;
+    aRecord.m_Name = aNet.first.first;
+    aRecord.m_Nodes.clear();
+
+    for( auto subgraph : aNet.second )
+    {
+        SCH_SHEET_PATH& sheet = subgraph->m_sheet;
+
+        for( auto item : subgraph->m_items )
+        {
+            if( item->Type() != SCH_PIN_T )
+                continue;
+
+            SCH_PIN* pin = static_cast<SCH_PIN*>( item );
+            NET_NODE netNode;
+
+            netNode.m_Ref = pin->GetParentComponent()->GetRef( &sheet );
+            netNode.m_Pin = pin->GetNumber();
+
+            if( pin->GetName() != "~" ) //  ~ is a char used to code empty strings in libs.
+                netNode.m_PinFunction = pin->GetName();
+
+            aRecord.m_Nodes.push_back( std::move( netNode ) );
+        }
+    }
+
+    // Netlist ordering: Net name, then ref des, then pin name.  The sort is stable so the
+    // pin kept below does not depend on the (thread dependent) subgraph order.
+    std::stable_sort( aRecord.m_Nodes.begin(), aRecord.m_Nodes.end(),
+            [] ( const NET_NODE& a, const NET_NODE& b ) {
+                if( a.m_Ref == b.m_Ref )
+                    return a.m_Pin < b.m_Pin;
+
+                return a.m_Ref < b.m_Ref;
+            } );
+
+    // Some duplicates can exist, for example on multi-unit parts with duplicated
+    // pins across units.  If the user connects the pins on each unit, they will
+    // appear on separate subgraphs.  Remove those here:
+    aRecord.m_Nodes.erase( std::unique( aRecord.m_Nodes.begin(), aRecord.m_Nodes.end(),
+            [] ( const NET_NODE& a, const NET_NODE& b ) {
+                return a.m_Ref == b.m_Ref && a.m_Pin == b.m_Pin;
+            } ), aRecord.m_Nodes.end() );
+
+    // Skip power symbols and virtual components
+    aRecord.m_Nodes.erase( std::remove_if( aRecord.m_Nodes.begin(), aRecord.m_Nodes.end(),
+            [] ( const NET_NODE& a ) {
+                return a.m_Ref[0] == wxChar( '#' );
+            } ), aRecord.m_Nodes.end() );
+}
+
+
+void NETLIST_EXPORTER_GENERIC::resolveNets( std::vector<NET_RECORD>& aRecords )
+{
+    wxASSERT( m_graph );
+
+    SCH_SHEET_LIST sheetList( g_RootSheet );
+    std::vector<const NET_MAP::value_type*> nets;
+
+    primeReferences( sheetList );
+
+    for( const auto& it : m_graph->GetNetMap() )
+        nets.push_back( &it );
+
+    aRecords.resize( nets.size() );
+
+    // Net codes start at 1
+    parallelFor( nets.size(),
+            [&nets, &aRecords]( size_t ii )
+            {
+                resolveNet( *nets[ii], ii + 1, aRecords[ii] );
+            } );
+}
+
+
 XNODE* NETLIST_EXPORTER_GENERIC::node( const wxString& aName, const wxString& aTextualContent /* = wxEmptyString*/ )
 {
     XNODE* n = new XNODE( wxXML_ELEMENT_NODE, aName );
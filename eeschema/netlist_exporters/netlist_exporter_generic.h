@@ -28,12 +28,16 @@
 
 #include <netlist_exporter.h>
 
+#include <atomic>
+#include <future>
+#include <thread>
+
+#include <connection_graph.h>
 #include <project.h>
 #include <xnode.h>      // also nests: <wx/xml/xml.h>
 
 #include <sch_edit_frame.h>
 
-class CONNECTION_GRAPH;
 class SYMBOL_LIB_TABLE;
 
 #define GENERIC_INTERMEDIATE_NETLIST_EXT wxT( "xml" )
@@ -67,6 +71,22 @@ private:
 protected:
     CONNECTION_GRAPH*     m_graph;
 
+    /// A pin of a net, resolved to the strings written to the netlist.
+    struct NET_NODE
+    {
+        wxString m_Ref;
+        wxString m_Pin;
+        wxString m_PinFunction;
+    };
+
+    /// A net of the connection graph, resolved to the strings written to the netlist.
+    struct NET_RECORD
+    {
+        int                   m_Code;
+        wxString              m_Name;
+        std::vector<NET_NODE> m_Nodes;
+    };
+
 public:
     NETLIST_EXPORTER_GENERIC( SCH_EDIT_FRAME* aFrame,
                               NETLIST_OBJECT_LIST* aMasterList,
@@ -142,6 +162,80 @@ protected:
     XNODE* makeLibraries();
 
     void addComponentFields(  XNODE* xcomp, SCH_COMPONENT* comp, SCH_SHEET_PATH* aSheet );
+
+    /**
+     * Function makeComponent
+     * @return XNODE* - a "comp" sub-tree for a single schematic component.
+     */
+    XNODE* makeComponent( SCH_COMPONENT* aComp, SCH_SHEET_PATH* aSheet );
+
+    /**
+     * Function collectComponents
+     * fills \a aList with the components to export, in output order, and records the
+     * library parts they use.  Must be called from the main thread.
+     */
+    void collectComponents( SCH_SHEET_LIST& aSheetList,
+                            std::vector<std::pair<SCH_COMPONENT*, size_t>>& aList );
+
+    /**
+     * Function primeReferences
+     * makes sure every component has a reference stored for each sheet path it is used in.
+     * SCH_COMPONENT::GetRef() adds missing entries on the fly, so this must be called
+     * before any reference is read from worker threads.
+     */
+    void primeReferences( SCH_SHEET_LIST& aSheetList );
+
+    /**
+     * Function resolveNet
+     * fills \a aRecord with the sorted, de-duplicated pins of a connection graph net.
+     * Only reads the schematic, so it may be called from worker threads once
+     * primeReferences() has been run.
+     */
+    static void resolveNet( const NET_MAP::value_type& aNet, int aCode, NET_RECORD& aRecord );
+
+    /**
+     * Function resolveNets
+     * resolves every net of the connection graph in parallel, in net code order.
+     */
+    void resolveNets( std::vector<NET_RECORD>& aRecords );
+
+    /**
+     * Function parallelFor
+     * runs \a aFunc for every index in [0, \a aCount) using all available cores.
+     * Indices are handed out one at a time so uneven work items balance across threads.
+     */
+    template <typename FUNC>
+    static void parallelFor( size_t aCount, FUNC aFunc )
+    {
+        // Don't spin up threads for a handful of items
+        size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                ( aCount + 15 ) / 16 );
+
+        std::atomic<size_t> nextItem( 0 );
+
+        auto worker = [&nextItem, &aCount, &aFunc]() -> size_t
+        {
+            for( size_t ii = nextItem++; ii < aCount; ii = nextItem++ )
+                aFunc( ii );
+
+            return 1;
+        };
+
+        if( parallelThreadCount <= 1 )
+        {
+            worker();
+            return;
+        }
+
+        std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, worker );
+
+        // Finalize the threads; get() rethrows anything a worker threw
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii].get();
+    }
 };
 
 #endif
@@ -30,6 +30,7 @@
 #include <confirm.h>
 
 #include <sch_edit_frame.h>
+#include <richio.h>
 #include <xnode.h>
 #include <connection_graph.h>
 #include "netlist_exporter_kicad.h"
@@ -54,13 +55,159 @@ bool NETLIST_EXPORTER_KICAD::WriteNetlist( const wxString& aOutFileName, unsigne
 }
 
 
+/// Number of components or nets formatted in parallel before being written out.  This bounds
+/// the memory held by formatted text while still giving each thread enough work.
+static const size_t FORMAT_BATCH_SIZE = 1024;
+
+
 void NETLIST_EXPORTER_KICAD::Format( OUTPUTFORMATTER* aOut, int aCtl )
 {
+    wxASSERT( m_graph );
+
     // Prepare list of nets generation
     for( unsigned ii = 0; ii < m_masterList->size(); ii++ )
         m_masterList->GetItem( ii )->m_Flag = 0;
 
-    std::unique_ptr<XNODE> xroot( makeRoot( aCtl ) );
+    // The output is the same as makeRoot() followed by XNODE::Format(), but the document
+    // is streamed section by section.  The components and nets sections, which make up
+    // nearly all of a large netlist, are never built as a XNODE tree: they are formatted
+    // in parallel batches and written in order.  Every child element is preceded by a
+    // newline, which is how XNODE::Format() lays out its children.
+
+    SCH_SHEET_LIST sheetList( g_RootSheet );
+
+    primeReferences( sheetList );
+
+    aOut->Print( 0, "(export (version %s)", aOut->Quotew( "D" ).c_str() );
+
+    auto formatNode = [&]( XNODE* aNode )
+    {
+        std::unique_ptr<XNODE> xnode( aNode );
+
+        aOut->Print( 0, "\n" );
+        xnode->Format( aOut, 1 );
+    };
+
+    if( aCtl & GNL_HEADER )
+        formatNode( makeDesignHeader() );
+
+    if( aCtl & GNL_COMPONENTS )
+        formatComponents( aOut, sheetList );
+
+    if( aCtl & GNL_PARTS )
+        formatNode( makeLibParts() );
+
+    if( aCtl & GNL_LIBRARIES )
+        // must follow makeGenericLibParts()
+        formatNode( makeLibraries() );
+
+    if( aCtl & GNL_NETS )
+        formatNets( aOut );
+
+    aOut->Print( 0, ")" );
+}
+
+
+void NETLIST_EXPORTER_KICAD::formatComponents( OUTPUTFORMATTER* aOut, SCH_SHEET_LIST& aSheetList )
+{
+    std::vector<std::pair<SCH_COMPONENT*, size_t>> components;
+    std::vector<std::string>                       chunks;
+
+    collectComponents( aSheetList, components );
+
+    aOut->Print( 0, "\n" );
+    aOut->Print( 1, "(components" );
+
+    for( size_t first = 0; first < components.size(); first += FORMAT_BATCH_SIZE )
+    {
+        size_t count = std::min( FORMAT_BATCH_SIZE, components.size() - first );
+
+        chunks.assign( count, std::string() );
+
+        parallelFor( count,
+                [&]( size_t ii )
+                {
+                    const auto&            entry = components[first + ii];
+                    std::unique_ptr<XNODE> xcomp( makeComponent( entry.first,
+                                                                 &aSheetList[entry.second] ) );
+                    STRING_FORMATTER       formatter;
+
+                    formatter.Print( 0, "\n" );
+                    xcomp->Format( &formatter, 2 );
+                    chunks[ii] = formatter.GetString();
+                } );
+
+        for( const std::string& chunk : chunks )
+            aOut->Print( 0, "%s", chunk.c_str() );
+    }
+
+    aOut->Print( 0, ")" );
+}
+
+
+void NETLIST_EXPORTER_KICAD::formatNets( OUTPUTFORMATTER* aOut )
+{
+    std::vector<const NET_MAP::value_type*> nets;
+    std::vector<std::string>                chunks;
+
+    m_LibParts.clear();     // same state as after makeListOfNets()
+
+    for( const auto& it : m_graph->GetNetMap() )
+        nets.push_back( &it );
+
+    aOut->Print( 0, "\n" );
+    aOut->Print( 1, "(nets" );
+
+    for( size_t first = 0; first < nets.size(); first += FORMAT_BATCH_SIZE )
+    {
+        size_t count = std::min( FORMAT_BATCH_SIZE, nets.size() - first );
+
+        chunks.assign( count, std::string() );
+
+        parallelFor( count,
+                [&]( size_t ii )
+                {
+                    NET_RECORD       record;
+                    STRING_FORMATTER formatter;
+
+                    // Net codes start at 1
+                    resolveNet( *nets[first + ii], (int) ( first + ii + 1 ), record );
+
+                    // Nets holding only power symbols and virtual components are not output
+                    if( record.m_Nodes.empty() )
+                        return;
+
+                    wxString netCodeTxt = wxString::Format( "%d", record.m_Code );
+
+                    formatter.Print( 0, "\n" );
+                    formatter.Print( 2, "(net (code %s) (name %s)",
+                                     formatter.Quotew( netCodeTxt ).c_str(),
+                                     formatter.Quotew( record.m_Name ).c_str() );
+
+                    for( const NET_NODE& netNode : record.m_Nodes )
+                    {
+                        formatter.Print( 0, "\n" );
+                        formatter.Print( 3, "(node (ref %s) (pin %s)",
+                                         formatter.Quotew( netNode.m_Ref ).c_str(),
+                                         formatter.Quotew( netNode.m_Pin ).c_str() );
+
+                        if( !netNode.m_PinFunction.IsEmpty() )
+                            formatter.Print( 0, " (pinfunction %s)",
+                                             formatter.Quotew( netNode.m_PinFunction ).c_str() );
+
+                        formatter.Print( 0, ")" );
+                    }
+
+                    formatter.Print( 0, ")" );
+                    chunks[ii] = formatter.GetString();
+                } );
+
+        for( const std::string& chunk : chunks )
+        {
+            if( !chunk.empty() )
+                aOut->Print( 0, "%s", chunk.c_str() );
+        }
+    }
 
-    xroot->Format( aOut, 0 );
+    aOut->Print( 0, ")" );
 }
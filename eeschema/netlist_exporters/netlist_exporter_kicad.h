@@ -59,6 +59,20 @@ public:
      * @throw IO_ERROR if any problems.
      */
     void Format( OUTPUTFORMATTER* aOutputFormatter, int aCtl );
+
+private:
+    /**
+     * Function formatComponents
+     * streams the "components" section, formatting components in parallel batches.
+     */
+    void formatComponents( OUTPUTFORMATTER* aOut, SCH_SHEET_LIST& aSheetList );
+
+    /**
+     * Function formatNets
+     * streams the "nets" section straight from the connection graph net map, formatting
+     * nets in parallel batches.
+     */
+    void formatNets( OUTPUTFORMATTER* aOut );
 };
 
 #endif
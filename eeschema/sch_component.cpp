@@ -49,6 +49,7 @@
 #include <dialogs/dialog_schematic_find.h>
 
 #include <wx/tokenzr.h>
+#include <boost/functional/hash.hpp>
 #include <iostream>
 #include <cctype>
 
@@ -179,6 +180,8 @@ SCH_COMPONENT::SCH_COMPONENT( const SCH_COMPONENT& aComponent ) :
     if( aComponent.m_part )
         m_part.reset( new LIB_PART( *aComponent.m_part.get() ) );
 
+    m_partHash = aComponent.m_partHash;
+
     const_cast<KIID&>( m_Uuid ) = aComponent.m_Uuid;
 
     m_transform = aComponent.m_transform;
@@ -222,6 +225,10 @@ void SCH_COMPONENT::Init( const wxPoint& pos )
     }
 
     m_prefix = wxString( wxT( "U" ) );
+
+    m_pinsPart    = nullptr;
+    m_pinsConvert = 0;
+    m_partHash    = 0;
     m_isInNetlist = true;
 }
 
@@ -255,8 +262,8 @@ void SCH_COMPONENT::SetLibId( const LIB_ID& aLibId, PART_LIBS* aLibs )
         else
         {
             m_part.reset();
-            m_pins.clear();
-            m_pinMap.clear();
+            m_partHash = 0;
+            UpdatePins();
         }
     }
 }
@@ -296,6 +303,7 @@ void SCH_COMPONENT::SetLibId( const LIB_ID& aLibId, SYMBOL_LIB_TABLE* aSymLibTab
     }
 
     m_part.reset( symbol.release() );
+    m_partHash = 0;
     UpdatePins();
 }
 
@@ -330,6 +338,7 @@ bool SCH_COMPONENT::Resolve( PART_LIBS* aLibs )
     {
         std::unique_ptr< LIB_PART > flattenedPart = part->Flatten();
         flattenedPart->SetParent();
+        m_partHash = HashPart( *flattenedPart );
         m_part.reset( flattenedPart.release() );
         UpdatePins();
         return true;
@@ -339,7 +348,10 @@ bool SCH_COMPONENT::Resolve( PART_LIBS* aLibs )
 }
 
 
-bool SCH_COMPONENT::Resolve( SYMBOL_LIB_TABLE& aLibTable, PART_LIB* aCacheLib )
+// Helper function, used by SCH_COMPONENT::Resolve and SCH_COMPONENT::ResolveAll, to load
+// the flattened library symbol of a component
+static std::unique_ptr< LIB_PART > loadPart( const LIB_ID& aLibId, SYMBOL_LIB_TABLE& aLibTable,
+                                             PART_LIB* aCacheLib )
 {
     std::unique_ptr< LIB_PART > part;
 
@@ -353,9 +365,9 @@ bool SCH_COMPONENT::Resolve( SYMBOL_LIB_TABLE& aLibTable, PART_LIB* aCacheLib )
         // LIB_TABLE_BASE::LoadSymbol() throws an IO_ERROR if the the library nickname
         // is not found in the table so check if the library still exists in the table
         // before attempting to load the symbol.
-        if( m_lib_id.IsValid() && aLibTable.HasLibrary( m_lib_id.GetLibNickname() ) )
+        if( aLibId.IsValid() && aLibTable.HasLibrary( aLibId.GetLibNickname() ) )
         {
-            LIB_PART* tmp = aLibTable.LoadSymbol( m_lib_id );
+            LIB_PART* tmp = aLibTable.LoadSymbol( aLibId );
 
             if( tmp )
             {
@@ -368,11 +380,11 @@ bool SCH_COMPONENT::Resolve( SYMBOL_LIB_TABLE& aLibTable, PART_LIB* aCacheLib )
         // format is implemented.
         if( !part && aCacheLib )
         {
-            wxString libId = m_lib_id.Format().wx_str();
+            wxString libId = aLibId.Format().wx_str();
             libId.Replace( ":", "_" );
             wxLogTrace( traceSymbolResolver,
                         "Library symbol %s not found falling back to cache library.",
-                        m_lib_id.Format().wx_str() );
+                        aLibId.Format().wx_str() );
             LIB_PART* tmp = aCacheLib->FindPart( libId );
 
             if( tmp )
@@ -383,25 +395,49 @@ bool SCH_COMPONENT::Resolve( SYMBOL_LIB_TABLE& aLibTable, PART_LIB* aCacheLib )
         }
 
         if( part )
-        {
-            m_part.reset( part.release() );
-            UpdatePins();
-            return true;
-        }
+            return part;
     }
     catch( const IO_ERROR& ioe )
     {
         wxLogTrace( traceSymbolResolver, "I/O error %s resolving library symbol %s", ioe.What(),
-                    m_lib_id.Format().wx_str() );
+                    aLibId.Format().wx_str() );
     }
 
     wxLogTrace( traceSymbolResolver, "Cannot resolve library symbol %s",
-                m_lib_id.Format().wx_str() );
+                aLibId.Format().wx_str() );
+
+    return nullptr;
+}
 
-    m_part.reset();
-    UpdatePins();     // This will clear the pin map and library symbol pin pointers.
 
-    return false;
+bool SCH_COMPONENT::Resolve( SYMBOL_LIB_TABLE& aLibTable, PART_LIB* aCacheLib )
+{
+    std::unique_ptr< LIB_PART > part = loadPart( m_lib_id, aLibTable, aCacheLib );
+
+    m_partHash = part ? HashPart( *part ) : 0;
+    m_part.reset( part.release() );
+    UpdatePins();     // This will clear the pin map and library symbol pin pointers if not found.
+
+    return m_part != nullptr;
+}
+
+
+size_t SCH_COMPONENT::HashPart( LIB_PART& aPart )
+{
+    // The legacy library format holds everything but the documentation, which is not used
+    // by the pins and the bounding box but is displayed from the component's copy.
+    STRING_FORMATTER formatter;
+
+    SCH_LEGACY_PLUGIN::FormatPart( &aPart, formatter );
+
+    size_t hash = std::hash<std::string>()( formatter.GetString() );
+
+    boost::hash_combine( hash, aPart.GetDescription().ToStdString() );
+    boost::hash_combine( hash, aPart.GetKeyWords().ToStdString() );
+    boost::hash_combine( hash, aPart.GetDocFileName().ToStdString() );
+
+    // 0 means an unknown hash
+    return hash ? hash : 1;
 }
 
 
@@ -426,29 +462,34 @@ void SCH_COMPONENT::ResolveAll(
     // sort it by lib part. Cmp will be grouped by same lib part.
     std::sort( aComponents.begin(), aComponents.end(), sort_by_libid );
 
-    LIB_ID curr_libid;
+    unsigned ii = 0;
 
-    for( unsigned ii = 0; ii < aComponents.size(); ++ii )
+    while( ii < aComponents.size() )
     {
-        SCH_COMPONENT* cmp = aComponents[ii];
-        curr_libid = cmp->m_lib_id;
-        cmp->Resolve( aLibTable, aCacheLib );
-        cmp->UpdatePins();
+        LIB_ID   curr_libid = aComponents[ii]->m_lib_id;
+        unsigned last = ii + 1;
 
-        // Propagate the m_part pointer to other members using the same lib_id
-        for( unsigned jj = ii + 1; jj < aComponents.size(); ++jj )
-        {
-            SCH_COMPONENT* next_cmp = aComponents[jj];
+        while( last < aComponents.size() && aComponents[last]->m_lib_id == curr_libid )
+            ++last;
 
-            if( curr_libid != next_cmp->m_lib_id )
-                break;
+        // Load the symbol once for all the components using this lib_id.  Components whose
+        // copy has the same content keep it, so their pins and bounding box are unchanged.
+        std::unique_ptr< LIB_PART > part = loadPart( curr_libid, aLibTable, aCacheLib );
+        size_t                      hash = part ? HashPart( *part ) : 0;
 
-            if( cmp->m_part )
-                next_cmp->m_part.reset( new LIB_PART( *cmp->m_part.get() ) );
+        for( ; ii < last; ++ii )
+        {
+            SCH_COMPONENT* cmp = aComponents[ii];
 
-            next_cmp->UpdatePins();
+            if( part && cmp->m_part && cmp->m_partHash == hash )
+            {
+                cmp->RefreshPins();
+                continue;
+            }
 
-            ii = jj;
+            cmp->m_part.reset( part ? new LIB_PART( *part ) : nullptr );
+            cmp->m_partHash = hash;
+            cmp->UpdatePins();
         }
     }
 }
@@ -458,6 +499,8 @@ void SCH_COMPONENT::UpdatePins()
 {
     m_pins.clear();
     m_pinMap.clear();
+    m_pinsPart    = m_part.get();
+    m_pinsConvert = m_convert;
 
     if( m_part )
     {
@@ -480,6 +523,18 @@ void SCH_COMPONENT::UpdatePins()
 }
 
 
+bool SCH_COMPONENT::RefreshPins()
+{
+    // m_part is only replaced while the previous symbol is alive, and each replacement
+    // rebuilds the pins, so an unchanged pointer means an unchanged symbol.
+    if( m_pinsPart == m_part.get() && m_pinsConvert == m_convert )
+        return false;
+
+    UpdatePins();
+    return true;
+}
+
+
 SCH_CONNECTION* SCH_COMPONENT::GetConnectionForPin( LIB_PIN* aPin, const SCH_SHEET_PATH& aSheet )
 {
     if( m_pinMap.count( aPin ) )
@@ -1004,6 +1059,8 @@ void SCH_COMPONENT::SwapData( SCH_ITEM* aItem )
     m_part.reset( part );
     UpdatePins();
 
+    std::swap( m_partHash, component->m_partHash );
+
     std::swap( m_Pos, component->m_Pos );
     std::swap( m_unit, component->m_unit );
     std::swap( m_convert, component->m_convert );
@@ -1780,6 +1837,7 @@ SCH_COMPONENT& SCH_COMPONENT::operator=( const SCH_ITEM& aItem )
         LIB_PART* libSymbol = c->m_part ? new LIB_PART( *c->m_part.get() ) : nullptr;
 
         m_part.reset( libSymbol );
+        m_partHash  = c->m_partHash;
         m_Pos       = c->m_Pos;
         m_unit      = c->m_unit;
         m_convert   = c->m_convert;
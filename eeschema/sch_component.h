@@ -116,6 +116,9 @@ private:
 
     SCH_PINS    m_pins;         ///< a SCH_PIN for every LIB_PIN (across all units)
     SCH_PIN_MAP m_pinMap;       ///< the component's pins mapped by LIB_PIN*
+    const LIB_PART* m_pinsPart; ///< the m_part the pins were built from
+    int         m_pinsConvert;  ///< the body style the pins were built for
+    size_t      m_partHash;     ///< content hash of m_part when resolved, 0 if unknown
 
     AUTOPLACED  m_fieldsAutoplaced; ///< indicates status of field autoplacement
 
@@ -231,6 +234,20 @@ public:
      */
     void UpdatePins();
 
+    /**
+     * Updates the cache of SCH_PIN objects only if the library symbol or the body style
+     * changed since it was built.
+     *
+     * @return true if the pins were rebuilt.
+     */
+    bool RefreshPins();
+
+    /**
+     * Computes the content hash of a resolved library symbol, used by ResolveAll() to
+     * keep the symbols (and the pins) of the components whose symbol did not change.
+     */
+    static size_t HashPart( LIB_PART& aPart );
+
     /**
      * Retrieves the connection for a given pin of the component
      */
@@ -985,6 +985,9 @@ void SCH_EDIT_FRAME::AddItemToScreenAndUndoList( SCH_ITEM* aItem, bool aUndoAppe
             SaveCopyInUndoList( undoItem, UR_CHANGED, aUndoAppend );     // save the parent sheet
 
             parentSheet->AddPin( (SCH_SHEET_PIN*) aItem );
+
+            // Re-index the sheet's connection points
+            screen->Update( parentSheet );
         }
         else if( aItem->Type() == SCH_FIELD_T )
         {
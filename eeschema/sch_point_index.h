@@ -0,0 +1,127 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-3.0.html
+ * or you may search the http://www.gnu.org website for the version 3 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef EESCHEMA_SCH_POINT_INDEX_H_
+#define EESCHEMA_SCH_POINT_INDEX_H_
+
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+#include <common.h>     // std::hash<wxPoint>
+#include <sch_item.h>
+
+/**
+ * EE_POINT_INDEX -
+ * Indexes schematic items by their exact connection points, as reported by
+ * SCH_ITEM::GetConnectionPoints(), so the items which may connect at a given position
+ * are found without a spatial search.  Maintained alongside the EE_RTREE by SCH_SCREEN.
+ * Non-owning.
+ *
+ * The points of an item are recorded when it is inserted, so it can be removed even after
+ * it was moved.  Like the R-tree, the index only follows an item's geometry when the item
+ * is re-inserted (see SCH_SCREEN::Update()), so results are candidates which the caller
+ * still has to test.
+ */
+class EE_POINT_INDEX
+{
+public:
+    /**
+     * Function insert()
+     * Adds an item at each of its connection points.  Items without connection points
+     * are not stored.
+     */
+    void insert( SCH_ITEM* aItem )
+    {
+        std::vector<wxPoint> points;
+
+        aItem->GetConnectionPoints( points );
+
+        if( points.empty() )
+            return;
+
+        // A component can have several pins stacked on the same position
+        std::sort( points.begin(), points.end(), std::less<wxPoint>() );
+        points.erase( std::unique( points.begin(), points.end() ), points.end() );
+
+        for( const wxPoint& point : points )
+            m_items[ point ].push_back( aItem );
+
+        m_points[ aItem ] = std::move( points );
+    }
+
+    /**
+     * Function remove()
+     * Removes an item from the points it was inserted at.
+     */
+    void remove( SCH_ITEM* aItem )
+    {
+        auto it = m_points.find( aItem );
+
+        if( it == m_points.end() )
+            return;
+
+        for( const wxPoint& point : it->second )
+        {
+            auto pointIt = m_items.find( point );
+
+            if( pointIt == m_items.end() )
+                continue;
+
+            std::vector<SCH_ITEM*>& items = pointIt->second;
+
+            items.erase( std::remove( items.begin(), items.end(), aItem ), items.end() );
+
+            if( items.empty() )
+                m_items.erase( pointIt );
+        }
+
+        m_points.erase( it );
+    }
+
+    void clear()
+    {
+        m_items.clear();
+        m_points.clear();
+    }
+
+    /**
+     * Function At()
+     * @return the items having a connection point at \a aPoint when they were inserted.
+     */
+    const std::vector<SCH_ITEM*>& At( const wxPoint& aPoint ) const
+    {
+        static const std::vector<SCH_ITEM*> empty;
+
+        auto it = m_items.find( aPoint );
+
+        return it == m_items.end() ? empty : it->second;
+    }
+
+private:
+    std::unordered_map<wxPoint, std::vector<SCH_ITEM*>> m_items;
+    std::unordered_map<SCH_ITEM*, std::vector<wxPoint>> m_points;
+};
+
+
+#endif /* EESCHEMA_SCH_POINT_INDEX_H_ */
@@ -35,6 +35,9 @@
 #include <sch_text.h>
 
 #include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
 
 class SCH_REFERENCE;
 class SCH_REFERENCE_LIST;
@@ -502,17 +505,46 @@ private:
     static bool sortByReferenceOnly( const SCH_REFERENCE& item1, const SCH_REFERENCE& item2 );
 
     /**
-     * Function CreateFirstFreeRefId
-     * searches for the first free reference number in \a aListId of reference numbers in use.
-     * This function just searches for a hole in a list of incremented numbers, this list must
-     * be sorted by increasing values and each value can be stored only once.  The new value
-     * is added to the list.
-     * @see BuildRefIdInUseList to prepare this list
-     * @param aIdList The buffer that contains the reference numbers in use.
-     * @param aFirstValue The first expected free value
-     * @return The first free (not yet used) value.
+     * PREFIX_INDEX
+     * indexes the references sharing a reference prefix, so Annotate() does not have to scan
+     * the whole list for the numbers in use and the units of a given reference.
      */
-    int CreateFirstFreeRefId( std::vector<int>& aIdList, int aFirstValue );
+    struct PREFIX_INDEX
+    {
+        std::vector<size_t>                          m_Members;   ///< Indices in flatList.
+        std::set<int>                                m_InUse;     ///< Numbers in use.
+        std::map<int, int>                           m_NextFree;  ///< Resume point of the free
+                                                                  ///< number search by min id.
+        std::unordered_map<int, std::vector<size_t>> m_ByNumber;  ///< Indices by number.
+    };
+
+    typedef std::unordered_map<std::string, PREFIX_INDEX> PREFIX_REGISTRY;
+
+    /**
+     * Function buildRegistry
+     * indexes all the items of the list by reference prefix.
+     */
+    void buildRegistry( PREFIX_REGISTRY& aRegistry );
+
+    /**
+     * Function registerNumber
+     * records the current reference number of the item at \a aIndex in the registry.  Must
+     * be called each time an item receives a reference number.
+     */
+    void registerNumber( PREFIX_REGISTRY& aRegistry, size_t aIndex );
+
+    /**
+     * Function findUnit
+     * indexed version of FindUnit().
+     */
+    int findUnit( const PREFIX_INDEX& aPrefix, size_t aIndex, int aUnit );
+
+    /**
+     * Function findFreeRefId
+     * searches for the first reference number >= \a aMinRefId not in use for a prefix.
+     * The number is not reserved until it is registered with registerNumber().
+     */
+    int findFreeRefId( PREFIX_INDEX& aPrefix, int aMinRefId );
 
     // Used for sorting static sortByTimeStamp function
     friend class BACK_ANNOTATE;
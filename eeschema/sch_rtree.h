@@ -76,9 +76,19 @@ public:
      * to remove a copy of the item will fail.
      */
     bool remove( SCH_ITEM* aItem )
+    {
+        return remove( aItem, aItem->GetBoundingBox() );
+    }
+
+    /**
+     * Function Remove()
+     * Removes an item from the tree, searching first at \a aBBox: the bounding box the
+     * item was inserted with, when the item already changed.
+     */
+    bool remove( SCH_ITEM* aItem, const EDA_RECT& aBBox )
     {
         // First, attempt to remove the item using its given BBox
-        const EDA_RECT& bbox    = aItem->GetBoundingBox();
+        const EDA_RECT& bbox    = aBBox;
         const int       type    = int( aItem->Type() );
         const int       mmin[3] = { type, bbox.GetX(), bbox.GetY() };
         const int       mmax[3] = { type, bbox.GetRight(), bbox.GetBottom() };
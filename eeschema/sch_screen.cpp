@@ -177,6 +177,7 @@ void SCH_SCREEN::Append( SCH_ITEM* aItem )
     if( aItem->Type() != SCH_SHEET_PIN_T && aItem->Type() != SCH_FIELD_T )
     {
         m_rtree.insert( aItem );
+        m_connectionPoints.insert( aItem );
         --m_modification_sync;
     }
 }
@@ -198,9 +199,14 @@ void SCH_SCREEN::Append( SCH_SCREEN* aScreen )
 void SCH_SCREEN::Clear( bool aFree )
 {
     if( aFree )
+    {
         FreeDrawList();
+    }
     else
+    {
         m_rtree.clear();
+        m_connectionPoints.clear();
+    }
 
     // Clear the project settings
     m_ScreenNumber = m_NumberOfScreens = 1;
@@ -221,6 +227,7 @@ void SCH_SCREEN::FreeDrawList()
             } );
 
     m_rtree.clear();
+    m_connectionPoints.clear();
 
     for( auto item : delete_list )
         delete item;
@@ -236,6 +243,8 @@ void SCH_SCREEN::Update( SCH_ITEM* aItem )
 
 bool SCH_SCREEN::Remove( SCH_ITEM* aItem )
 {
+    m_connectionPoints.remove( aItem );
+
     return m_rtree.remove( aItem );
 }
 
@@ -254,6 +263,7 @@ void SCH_SCREEN::DeleteItem( SCH_ITEM* aItem )
         SCH_SHEET* sheet = sheetPin->GetParent();
         wxCHECK_RET( sheet, wxT( "Sheet label parent not properly set, bad programmer!" ) );
         sheet->RemovePin( sheetPin );
+        Update( sheet );
         return;
     }
     else
@@ -300,29 +310,35 @@ std::set<SCH_ITEM*> SCH_SCREEN::MarkConnections( SCH_LINE* aSegment )
         auto test_item = to_search.top();
         to_search.pop();
 
-        for( auto item : Items().Overlapping( SCH_JUNCTION_T, test_item->GetBoundingBox() ) )
+        // Everything connected to a segment sits on one of its end points
+        for( const wxPoint& point : { test_item->GetStartPoint(), test_item->GetEndPoint() } )
         {
-            if( test_item->IsEndPoint( item->GetPosition() ) )
-                retval.insert( item );
-        }
+            for( auto item : m_connectionPoints.At( point ) )
+            {
+                if( item->Type() == SCH_JUNCTION_T )
+                {
+                    if( test_item->IsEndPoint( item->GetPosition() ) )
+                        retval.insert( item );
 
-        for( auto item : Items().Overlapping( SCH_LINE_T, test_item->GetBoundingBox() ) )
-        {
-            // Skip connecting lines on different layers (e.g. busses)
-            if( test_item->GetLayer() != item->GetLayer() )
-                continue;
+                    continue;
+                }
 
-            auto line = static_cast<SCH_LINE*>( item );
+                // Skip connecting lines on different layers (e.g. busses)
+                if( item->Type() != SCH_LINE_T || test_item->GetLayer() != item->GetLayer() )
+                    continue;
 
-            if( ( test_item->IsEndPoint( line->GetStartPoint() )
-                        && !GetPin( line->GetStartPoint(), NULL, true ) )
-                    || ( test_item->IsEndPoint( line->GetEndPoint() )
-                               && !GetPin( line->GetEndPoint(), nullptr, true ) ) )
-            {
-                auto result = retval.insert( line );
+                auto line = static_cast<SCH_LINE*>( item );
+
+                if( ( test_item->IsEndPoint( line->GetStartPoint() )
+                            && !GetPin( line->GetStartPoint(), NULL, true ) )
+                        || ( test_item->IsEndPoint( line->GetEndPoint() )
+                                   && !GetPin( line->GetEndPoint(), nullptr, true ) ) )
+                {
+                    auto result = retval.insert( line );
 
-                if( result.second )
-                    to_search.push( line );
+                    if( result.second )
+                        to_search.push( line );
+                }
             }
         }
     }
@@ -341,21 +357,35 @@ bool SCH_SCREEN::IsJunctionNeeded( const wxPoint& aPosition, bool aNew )
 
     std::vector<SCH_LINE*> lines[ sizeof( layers ) ];
 
-    for( auto item : Items().Overlapping( aPosition ) )
+    if( aNew )
+    {
+        for( auto item : Items().Overlapping( SCH_JUNCTION_T, aPosition ) )
+        {
+            if( !( item->GetEditFlags() & STRUCT_DELETED ) && item->HitTest( aPosition ) )
+                return false;
+        }
+    }
+
+    // Lines can pass through the position, so they need a spatial search
+    for( auto item : Items().Overlapping( SCH_LINE_T, aPosition ) )
     {
         if( item->GetEditFlags() & STRUCT_DELETED )
             continue;
 
-        if( aNew && ( item->Type() == SCH_JUNCTION_T ) && ( item->HitTest( aPosition ) ) )
-            return false;
-
-        if( ( item->Type() == SCH_LINE_T ) && ( item->HitTest( aPosition, 0 ) ) )
+        if( item->HitTest( aPosition, 0 ) )
         {
             if( item->GetLayer() == LAYER_WIRE )
                 lines[WIRES].push_back( (SCH_LINE*) item );
             else if( item->GetLayer() == LAYER_BUS )
                 lines[BUSSES].push_back( (SCH_LINE*) item );
         }
+    }
+
+    // Pins only connect on their exact end points
+    for( auto item : m_connectionPoints.At( aPosition ) )
+    {
+        if( item->GetEditFlags() & STRUCT_DELETED )
+            continue;
 
         if( ( ( item->Type() == SCH_COMPONENT_T ) || ( item->Type() == SCH_SHEET_T ) )
                 && ( item->IsConnected( aPosition ) ) )
@@ -498,11 +528,27 @@ void SCH_SCREEN::UpdateSymbolLinks( bool aForce )
         SYMBOL_LIB_TABLE* libs = Prj().SchSymbolLibTable();
         int mod_hash = libs->GetModifyHash();
 
+        // What the R-tree and the connection point index were built with
+        struct LINK_STATE
+        {
+            SCH_COMPONENT*  m_cmp;
+            const LIB_PART* m_part;
+            EDA_RECT        m_bbox;
+            bool            m_pinsChanged;
+        };
+
+        std::vector<LINK_STATE> states;
+
         for( auto aItem : Items().OfType( SCH_COMPONENT_T ) )
             cmps.push_back( static_cast<SCH_COMPONENT*>( aItem ) );
 
+        // Resolving only rebuilds the pins of the components whose symbol changed, so the
+        // pins must also be refreshed for the body style changes.
         for( auto cmp : cmps )
-            Remove( cmp );
+        {
+            EDA_RECT bbox = cmp->GetBoundingBox();
+            states.push_back( { cmp, cmp->GetPartRef().get(), bbox, cmp->RefreshPins() } );
+        }
 
         // Must we resolve?
         if( (m_modification_sync != mod_hash) || aForce )
@@ -511,18 +557,29 @@ void SCH_SCREEN::UpdateSymbolLinks( bool aForce )
 
             m_modification_sync = mod_hash;     // note the last mod_hash
         }
-        // Resolving will update the pin caches but we must ensure that this happens
-        // even if the libraries don't change.
-        else
+
+        // Changing the symbol may adjust the bbox and the pins of the symbol.  This re-inserts
+        // the changed items with the new bbox, without invalidating the links again.
+        int sync = m_modification_sync;
+
+        for( const LINK_STATE& state : states )
         {
-            for( auto cmp : cmps )
-                cmp->UpdatePins();
-        }
+            SCH_COMPONENT* cmp = state.m_cmp;
+            EDA_RECT       bbox = cmp->GetBoundingBox();
 
-        // Changing the symbol may adjust the bbox of the symbol.  This re-inserts the
-        // item with the new bbox
-        for( auto cmp : cmps )
+            if( !state.m_pinsChanged && cmp->GetPartRef().get() == state.m_part
+                    && bbox.GetOrigin() == state.m_bbox.GetOrigin()
+                    && bbox.GetSize() == state.m_bbox.GetSize() )
+            {
+                continue;
+            }
+
+            m_rtree.remove( cmp, state.m_bbox );
+            m_connectionPoints.remove( cmp );
             Append( cmp );
+        }
+
+        m_modification_sync = sync;
     }
 }
 
@@ -651,13 +708,15 @@ LIB_PIN* SCH_SCREEN::GetPin(
     SCH_COMPONENT*  component = NULL;
     LIB_PIN*        pin = NULL;
 
-    for( auto item : Items().Overlapping( SCH_COMPONENT_T, aPosition ) )
+    if( aEndPointOnly )
     {
-        component = static_cast<SCH_COMPONENT*>( item );
-
-        if( aEndPointOnly )
+        // Only components with a pin end point at aPosition can match
+        for( auto item : m_connectionPoints.At( aPosition ) )
         {
-            pin = NULL;
+            if( item->Type() != SCH_COMPONENT_T )
+                continue;
+
+            component = static_cast<SCH_COMPONENT*>( item );
 
             if( !component->GetPartRef() )
                 continue;
@@ -677,11 +736,16 @@ LIB_PIN* SCH_SCREEN::GetPin(
                 if(component->GetPinPhysicalPosition( pin ) == aPosition )
                     break;
             }
+
             if( pin )
                 break;
         }
-        else
+    }
+    else
+    {
+        for( auto item : Items().Overlapping( SCH_COMPONENT_T, aPosition ) )
         {
+            component = static_cast<SCH_COMPONENT*>( item );
             pin = (LIB_PIN*) component->GetDrawItem( aPosition, LIB_PIN_T );
 
             if( pin )
@@ -718,7 +782,8 @@ size_t SCH_SCREEN::CountConnectedItems( const wxPoint& aPos, bool aTestJunctions
 {
     size_t count = 0;
 
-    for( auto item : Items() )
+    // An item can only be connected at one of its connection points
+    for( auto item : m_connectionPoints.At( aPos ) )
     {
         if( ( item->Type() != SCH_JUNCTION_T || aTestJunctions ) && item->IsConnected( aPos ) )
             count++;
@@ -792,11 +857,21 @@ bool SCH_SCREEN::TestDanglingEnds( const SCH_SHEET_PATH* aPath )
 SCH_LINE* SCH_SCREEN::GetLine( const wxPoint& aPosition, int aAccuracy, int aLayer,
                                SCH_LINE_TEST_T aSearchType )
 {
-    for( auto item : Items() )
+    // A line can only end on aPosition if aPosition is one of its connection points
+    if( aSearchType == END_POINTS_ONLY_T )
     {
-        if( item->Type() != SCH_LINE_T )
-            continue;
+        for( auto item : m_connectionPoints.At( aPosition ) )
+        {
+            if( item->Type() == SCH_LINE_T && item->GetLayer() == aLayer
+                    && static_cast<SCH_LINE*>( item )->IsEndPoint( aPosition ) )
+                return static_cast<SCH_LINE*>( item );
+        }
 
+        return NULL;
+    }
+
+    for( auto item : Items().OfType( SCH_LINE_T ) )
+    {
         if( item->GetLayer() != aLayer )
             continue;
 
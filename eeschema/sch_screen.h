@@ -45,6 +45,7 @@
 #include <title_block.h>
 
 #include <lib_id.h>
+#include <sch_point_index.h>
 #include <sch_rtree.h>
 #include <sch_sheet.h>
 #include <sch_sheet_path.h>
@@ -109,6 +110,9 @@ private:
 
     EE_RTREE m_rtree;
 
+    /// Items by exact connection point, kept in sync with m_rtree
+    EE_POINT_INDEX m_connectionPoints;
+
     int m_modification_sync; ///< inequality with PART_LIBS::GetModificationHash()
                              ///< will trigger ResolveAll().
 
@@ -321,6 +325,13 @@ public:
      */
     void ClearDrawingState();
 
+    /**
+     * Count the items connected at \a aPos (see SCH_ITEM::IsConnected()).
+     *
+     * @param aPos The position to test.
+     * @param aTestJunctions Set to true to also count junctions.
+     * @return the number of connected items.
+     */
     size_t CountConnectedItems( const wxPoint& aPos, bool aTestJunctions );
 
     /**
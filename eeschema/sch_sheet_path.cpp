@@ -37,6 +37,10 @@
 #include <boost/functional/hash.hpp>
 #include <wx/filename.h>
 
+#include <atomic>
+#include <future>
+#include <thread>
+
 
 namespace std
 {
@@ -461,8 +465,58 @@ void SCH_SHEET_LIST::AnnotatePowerSymbols()
 void SCH_SHEET_LIST::GetComponents( SCH_REFERENCE_LIST& aReferences, bool aIncludePowerSymbols,
                                     bool aForceIncludeOrphanComponents )
 {
-    for( SCH_SHEET_PATHS_ITER it = begin(); it != end(); ++it )
-        (*it).GetComponents( aReferences, aIncludePowerSymbols, aForceIncludeOrphanComponents );
+    // Building a reference can update the component (missing path entries, empty value),
+    // and a component is shared by all the sheet paths of its screen.  So the sheet paths
+    // are collected in parallel by screen, each screen handling its paths sequentially.
+    std::vector<SCH_REFERENCE_LIST>   lists( size() );
+    std::vector<std::vector<size_t>>  screenPaths;
+    std::map<SCH_SCREEN*, size_t>     screenIndex;
+
+    for( size_t ii = 0; ii < size(); ii++ )
+    {
+        auto result = screenIndex.emplace( at( ii ).LastScreen(), screenPaths.size() );
+
+        if( result.second )
+            screenPaths.emplace_back();
+
+        screenPaths[ result.first->second ].push_back( ii );
+    }
+
+    size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
+                                                   screenPaths.size() );
+    std::atomic<size_t> nextScreen( 0 );
+    std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+    auto collect_lambda = [&]() -> size_t
+    {
+        for( size_t screen = nextScreen++; screen < screenPaths.size(); screen = nextScreen++ )
+        {
+            for( size_t ii : screenPaths[screen] )
+                at( ii ).GetComponents( lists[ii], aIncludePowerSymbols,
+                                        aForceIncludeOrphanComponents );
+        }
+
+        return 1;
+    };
+
+    if( parallelThreadCount <= 1 )
+        collect_lambda();
+    else
+    {
+        for( size_t ii = 0; ii < parallelThreadCount; ii++ )
+            returns[ii] = std::async( std::launch::async, collect_lambda );
+
+        // Finalize the threads
+        for( size_t ii = 0; ii < parallelThreadCount; ii++ )
+            returns[ii].wait();
+    }
+
+    // Keep the sheet path order of the sequential collection
+    for( SCH_REFERENCE_LIST& list : lists )
+    {
+        for( unsigned ii = 0; ii < list.GetCount(); ii++ )
+            aReferences.AddItem( list[ii] );
+    }
 }
 
 void SCH_SHEET_LIST::GetMultiUnitComponents( SCH_MULTI_UNIT_REFERENCE_MAP &aRefList,
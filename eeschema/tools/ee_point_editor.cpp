@@ -592,6 +592,8 @@ void EE_POINT_EDITOR::updateItem() const
             pin->SetPosition( pos );
         }
 
+        // The sheet pins are indexed with their sheet
+        m_frame->GetScreen()->Update( sheet );
         break;
     }
 
@@ -601,6 +603,7 @@ void EE_POINT_EDITOR::updateItem() const
 
         line->SetStartPoint( (wxPoint) m_editPoints->Point( LINE_START ).GetPosition() );
         line->SetEndPoint( (wxPoint) m_editPoints->Point( LINE_END ).GetPosition() );
+        m_frame->GetScreen()->Update( line );
 
         SCH_LINE* connection = (SCH_LINE*) ( m_editPoints->Point( LINE_START ).GetConnection() );
 
@@ -611,6 +614,7 @@ void EE_POINT_EDITOR::updateItem() const
             else if( connection->HasFlag( ENDPOINT ) )
                 connection->SetEndPoint( line->GetPosition() );
 
+            m_frame->GetScreen()->Update( connection );
             getView()->Update( connection, KIGFX::GEOMETRY );
         }
 
@@ -623,6 +627,7 @@ void EE_POINT_EDITOR::updateItem() const
             else if( connection->HasFlag( ENDPOINT ) )
                 connection->SetEndPoint( line->GetEndPoint() );
 
+            m_frame->GetScreen()->Update( connection );
             getView()->Update( connection, KIGFX::GEOMETRY );
         }
 
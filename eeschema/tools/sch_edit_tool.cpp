@@ -366,6 +366,24 @@ const KICAD_T rotatableItems[] = {
 };
 
 
+/**
+ * Updates the R-tree and the connection point index of \a aScreen after \a aItem was
+ * rotated or mirrored in place.  Sheet pins and fields are indexed with their parent.
+ */
+static void updateScreenIndex( SCH_SCREEN* aScreen, SCH_ITEM* aItem )
+{
+    if( aItem->Type() == SCH_SHEET_PIN_T || aItem->Type() == SCH_FIELD_T )
+    {
+        if( aItem->GetParent() )
+            aScreen->Update( static_cast<SCH_ITEM*>( aItem->GetParent() ) );
+    }
+    else
+    {
+        aScreen->Update( aItem );
+    }
+}
+
+
 int SCH_EDIT_TOOL::Rotate( const TOOL_EVENT& aEvent )
 {
     EE_SELECTION& selection = m_selectionTool->RequestSelection( rotatableItems );
@@ -482,6 +500,7 @@ int SCH_EDIT_TOOL::Rotate( const TOOL_EVENT& aEvent )
         }
 
         connections = item->IsConnectable();
+        updateScreenIndex( m_frame->GetScreen(), item );
         m_frame->RefreshItem( item );
     }
     else if( selection.GetSize() > 1 )
@@ -529,6 +548,7 @@ int SCH_EDIT_TOOL::Rotate( const TOOL_EVENT& aEvent )
             }
 
             connections |= item->IsConnectable();
+            updateScreenIndex( m_frame->GetScreen(), item );
             m_frame->RefreshItem( item );
         }
     }
@@ -670,6 +690,7 @@ int SCH_EDIT_TOOL::Mirror( const TOOL_EVENT& aEvent )
         }
 
         connections = item->IsConnectable();
+        updateScreenIndex( m_frame->GetScreen(), item );
         m_frame->RefreshItem( item );
     }
     else if( selection.GetSize() > 1 )
@@ -710,6 +731,7 @@ int SCH_EDIT_TOOL::Mirror( const TOOL_EVENT& aEvent )
             }
 
             connections |= item->IsConnectable();
+            updateScreenIndex( m_frame->GetScreen(), item );
             m_frame->RefreshItem( item );
         }
     }
@@ -957,6 +979,7 @@ int SCH_EDIT_TOOL::DoDelete( const TOOL_EVENT& aEvent )
                 SCH_SHEET*     sheet = pin->GetParent();
 
                 sheet->RemovePin( pin );
+                m_frame->GetScreen()->Update( sheet );
             }
             else
                 m_frame->RemoveFromScreen( sch_item );
@@ -445,8 +445,12 @@ int SCH_MOVE_TOOL::Main( const TOOL_EVENT& aEvent )
         {
             switch( item->Type() )
             {
-            // Moving sheet pins does not change the BBox.
+            // Moving sheet pins does not change the BBox, but changes the connection points
+            // of the sheet
             case SCH_SHEET_PIN_T:
+                if( item->GetParent() )
+                    m_frame->GetScreen()->Update( static_cast<SCH_ITEM*>( item->GetParent() ) );
+
                 break;
 
             // Moving fields should update the associated component
@@ -43,6 +43,7 @@
 
 #include <wx/log.h>
 #include <X2_gerber_attributes.h>
+#include <gerber_line_reader.h>
 #include <macros.h>
 
 /*
@@ -90,8 +91,7 @@ void X2_ATTRIBUTE::DbgListPrms()
         wxLogMessage( m_Prms.Item( ii ) );
 }
 
-bool X2_ATTRIBUTE::ParseAttribCmd( FILE* aFile, char *aBuffer, int aBuffSize, char* &aText,
-                                   int& aLineNum )
+bool X2_ATTRIBUTE::ParseAttribCmd( GERBER_LINE_READER* aReader, char* &aText, int& aLineNum )
 {
     // parse a TF, TA, TO ... command and fill m_Prms by the parameters found.
     // the "%TF" (start of command) is already read by the caller
@@ -134,9 +134,9 @@ bool X2_ATTRIBUTE::ParseAttribCmd( FILE* aFile, char *aBuffer, int aBuffSize, ch
         }
 
         // end of current line, read another one.
-        if( aBuffer && aFile )
+        if( aReader )
         {
-            if( fgets( aBuffer, aBuffSize, aFile ) == NULL )
+            if( aReader->ReadLine() == NULL )
             {
                 // end of file
                 ok = false;
@@ -144,7 +144,7 @@ bool X2_ATTRIBUTE::ParseAttribCmd( FILE* aFile, char *aBuffer, int aBuffSize, ch
             }
 
             aLineNum++;
-            aText = aBuffer;
+            aText = aReader->Line();
         }
         else
             return ok;
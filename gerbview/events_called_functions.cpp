@@ -168,24 +168,27 @@ void GERBVIEW_FRAME::Process_Special_Functions( wxCommandEvent& event )
 void GERBVIEW_FRAME::OnSelectHighlightChoice( wxCommandEvent& event )
 {
     auto settings = static_cast<KIGFX::GERBVIEW_PAINTER*>( GetCanvas()->GetView()->GetPainter() )->GetSettings();
+    wxString netName = settings->m_netHighlightString;
+    wxString component = settings->m_componentHighlightString;
+    wxString aperFunction = settings->m_attributeHighlightString;
 
     switch( event.GetId() )
     {
     case ID_GBR_AUX_TOOLBAR_PCB_CMP_CHOICE:
-        settings->m_componentHighlightString = m_SelComponentBox->GetStringSelection();
+        component = m_SelComponentBox->GetStringSelection();
         break;
 
     case ID_GBR_AUX_TOOLBAR_PCB_NET_CHOICE:
-        settings->m_netHighlightString = m_SelNetnameBox->GetStringSelection();
+        netName = m_SelNetnameBox->GetStringSelection();
         break;
 
     case ID_GBR_AUX_TOOLBAR_PCB_APERATTRIBUTES_CHOICE:
-        settings->m_attributeHighlightString = m_SelAperAttributesBox->GetStringSelection();
+        aperFunction = m_SelAperAttributesBox->GetStringSelection();
         break;
 
     }
 
-    GetCanvas()->GetView()->UpdateAllItems( KIGFX::COLOR );
+    SetHighlightStrings( netName, component, aperFunction );
     GetCanvas()->Refresh();
 }
 
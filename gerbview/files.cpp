@@ -38,6 +38,10 @@
 #include <wildcards_and_files_ext.h>
 #include <widgets/progress_reporter.h>
 
+#include <atomic>
+#include <future>
+#include <thread>
+
 // HTML Messages used more than one time:
 #define MSG_NO_MORE_LAYER\
     _( "<b>No more available free graphic layer</b> in Gerbview to load files" )
@@ -272,6 +276,92 @@ bool GERBVIEW_FRAME::loadListOfGerberAndDrillFiles( const wxString& aPath,
     // Create progress dialog (only used if more than 1 file to load
     std::unique_ptr<WX_PROGRESS_REPORTER> progress = nullptr;
 
+    if( aFilenameList.GetCount() > 1 )
+    {
+        progress = std::make_unique<WX_PROGRESS_REPORTER>( this,
+                        _( "Loading Gerber files..." ), 2, false );
+        progress->Report( _( "Reading files..." ) );
+        progress->SetMaxProgress( aFilenameList.GetCount() );
+    }
+
+    // The Gerber files are independent: read them on worker threads first.  The loop
+    // below then adds the images to the layers, in the list order.
+    std::vector<wxString> gerberFiles( aFilenameList.GetCount() );
+    std::vector<std::unique_ptr<GERBER_FILE_IMAGE>> gerberImages( aFilenameList.GetCount() );
+
+    for( unsigned ii = 0; ii < aFilenameList.GetCount(); ii++ )
+    {
+        filename = aFilenameList[ii];
+
+        if( !filename.IsAbsolute() )
+            filename.SetPath( aPath );
+
+        if( filename.FileExists() && !( aFileType && (*aFileType)[ii] == 1 ) )
+            gerberFiles[ii] = filename.GetFullPath();
+    }
+
+    std::atomic<size_t> nextFile( 0 );
+    size_t              parallelThreadCount =
+            std::min<size_t>( std::thread::hardware_concurrency(), gerberFiles.size() );
+    std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+    auto read_lambda = [&] () -> size_t
+    {
+        size_t num = 0;
+
+        for( size_t i = nextFile++; i < gerberFiles.size(); i = nextFile++ )
+        {
+            if( !gerberFiles[i].IsEmpty() )
+            {
+                // The image layer is set when the image is added
+                std::unique_ptr<GERBER_FILE_IMAGE> gerber( new GERBER_FILE_IMAGE( 0 ) );
+
+                if( gerber->LoadGerberFile( gerberFiles[i] ) )
+                    gerberImages[i] = std::move( gerber );
+
+                num++;
+            }
+
+            if( progress )
+                progress->AdvanceProgress();
+        }
+
+        return num;
+    };
+
+    {
+        // LOCALE_IO changes the locale of the whole process: switch it once for all the
+        // threads, not from each of them
+        LOCALE_IO toggleIo;
+
+        if( parallelThreadCount <= 1 )
+            read_lambda();
+        else
+        {
+            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+                returns[ii] = std::async( std::launch::async, read_lambda );
+
+            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            {
+                // Here we balance returns with a 100ms timeout to allow UI updating
+                std::future_status status;
+                do
+                {
+                    if( progress )
+                        progress->KeepRefreshing();
+
+                    status = returns[ii].wait_for( std::chrono::milliseconds( 100 ) );
+                } while( status != std::future_status::ready );
+            }
+        }
+    }
+
+    if( progress )
+    {
+        progress->AdvancePhase();
+        progress->SetMaxProgress( aFilenameList.GetCount() );
+    }
+
     for( unsigned ii = 0; ii < aFilenameList.GetCount(); ii++ )
     {
         filename = aFilenameList[ii];
@@ -293,15 +383,7 @@ bool GERBVIEW_FRAME::loadListOfGerberAndDrillFiles( const wxString& aPath,
 
         m_lastFileName = filename.GetFullPath();
 
-        if( !progress && ( aFilenameList.GetCount() > 1 ) )
-        {
-            progress = std::make_unique<WX_PROGRESS_REPORTER>( this,
-                            _( "Loading Gerber files..." ), 1, false );
-            progress->SetMaxProgress( aFilenameList.GetCount() - 1 );
-            progress->Report( wxString::Format( _("Loading %u/%zu %s" ), ii+1,
-                                            aFilenameList.GetCount(), m_lastFileName ) );
-        }
-        else if( progress )
+        if( progress )
         {
             progress->Report( wxString::Format( _("Loading %u/%zu %s" ), ii+1,
                                             aFilenameList.GetCount(), m_lastFileName ) );
@@ -319,7 +401,7 @@ bool GERBVIEW_FRAME::loadListOfGerberAndDrillFiles( const wxString& aPath,
         }
         else
         {
-            if( Read_GERBER_File( filename.GetFullPath() ) )
+            if( addGerberImage( gerberImages[ii].release(), filename.GetFullPath() ) )
             {
                 UpdateFileHistory( m_lastFileName );
 
@@ -37,6 +37,13 @@
 #include <geometry/shape_arc.h>
 #include <math/util.h>      // for KiROUND
 
+// The draw parameters of items which do not belong to an image
+static const GERBER_DRAW_PARAMS defaultDrawParams;
+
+// In case the item has a very tiny width defined, allow it to be selected
+static const int MIN_HIT_TEST_RADIUS = Millimeter2iu( 0.01 );
+
+
 GERBER_DRAW_ITEM::GERBER_DRAW_ITEM( GERBER_FILE_IMAGE* aGerberImageFile ) :
     EDA_ITEM( (EDA_ITEM*)NULL, GERBER_DRAW_ITEM_T )
 {
@@ -44,13 +51,11 @@ GERBER_DRAW_ITEM::GERBER_DRAW_ITEM( GERBER_FILE_IMAGE* aGerberImageFile ) :
     m_Shape         = GBR_SEGMENT;
     m_Flashed       = false;
     m_DCode         = 0;
-    m_UnitsMetric   = false;
     m_LayerNegative = false;
-    m_swapAxis      = false;
-    m_mirrorA       = false;
-    m_mirrorB       = false;
-    m_drawScale.x   = m_drawScale.y = 1.0;
-    m_lyrRotation   = 0;
+    m_drawParams    = &defaultDrawParams;
+    m_netAttributes = nullptr;
+    m_aperFunction  = nullptr;
+    m_boundingBoxValid = false;
 
     if( m_GerberImageFile )
         SetLayerParameters();
@@ -64,14 +69,34 @@ GERBER_DRAW_ITEM::~GERBER_DRAW_ITEM()
 
 void GERBER_DRAW_ITEM::SetNetAttributes( const GBR_NETLIST_METADATA& aNetAttributes )
 {
-    m_netAttributes = aNetAttributes;
+    // The attributes are stored by the image: items without an image have none
+    if( m_GerberImageFile )
+        m_netAttributes = m_GerberImageFile->InternNetAttributes( aNetAttributes );
+}
+
+
+const GBR_NETLIST_METADATA& GERBER_DRAW_ITEM::GetNetAttributes() const
+{
+    static const GBR_NETLIST_METADATA noAttributes;
+
+    return m_netAttributes ? *m_netAttributes : noAttributes;
+}
 
-    if( ( m_netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_CMP ) ||
-        ( m_netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_PAD ) )
-        m_GerberImageFile->m_ComponentsList.insert( std::make_pair( m_netAttributes.m_Cmpref, 0 ) );
 
-    if( ( m_netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_NET ) )
-        m_GerberImageFile->m_NetnamesList.insert( std::make_pair( m_netAttributes.m_Netname, 0 ) );
+void GERBER_DRAW_ITEM::SetAperFunction( const wxString& aAperFunction )
+{
+    if( aAperFunction.IsEmpty() || !m_GerberImageFile )
+        m_aperFunction = nullptr;
+    else
+        m_aperFunction = m_GerberImageFile->InternString( aAperFunction );
+}
+
+
+const wxString& GERBER_DRAW_ITEM::GetAperFunction() const
+{
+    static const wxString noFunction;
+
+    return m_aperFunction ? *m_aperFunction : noFunction;
 }
 
 
@@ -156,23 +181,23 @@ wxPoint GERBER_DRAW_ITEM::GetABPosition( const wxPoint& aXYPosition ) const
      */
     wxPoint abPos = aXYPosition + m_GerberImageFile->m_ImageJustifyOffset;
 
-    if( m_swapAxis )
+    if( m_drawParams->m_SwapAxis )
         std::swap( abPos.x, abPos.y );
 
-    abPos  += m_layerOffset + m_GerberImageFile->m_ImageOffset;
-    abPos.x = KiROUND( abPos.x * m_drawScale.x );
-    abPos.y = KiROUND( abPos.y * m_drawScale.y );
-    double rotation = m_lyrRotation * 10 + m_GerberImageFile->m_ImageRotation * 10;
+    abPos  += m_drawParams->m_LayerOffset + m_GerberImageFile->m_ImageOffset;
+    abPos.x = KiROUND( abPos.x * m_drawParams->m_DrawScale.x );
+    abPos.y = KiROUND( abPos.y * m_drawParams->m_DrawScale.y );
+    double rotation = m_drawParams->m_LyrRotation * 10 + m_GerberImageFile->m_ImageRotation * 10;
 
     if( rotation )
         RotatePoint( &abPos, -rotation );
 
     // Negate A axis if mirrored
-    if( m_mirrorA )
+    if( m_drawParams->m_MirrorA )
         abPos.x = -abPos.x;
 
     // abPos.y must be negated when no mirror, because draw axis is top to bottom
-    if( !m_mirrorB )
+    if( !m_drawParams->m_MirrorB )
         abPos.y = -abPos.y;
     return abPos;
 }
@@ -183,22 +208,22 @@ wxPoint GERBER_DRAW_ITEM::GetXYPosition( const wxPoint& aABPosition ) const
     // do the inverse transform made by GetABPosition
     wxPoint xyPos = aABPosition;
 
-    if( m_mirrorA )
+    if( m_drawParams->m_MirrorA )
         xyPos.x = -xyPos.x;
 
-    if( !m_mirrorB )
+    if( !m_drawParams->m_MirrorB )
         xyPos.y = -xyPos.y;
 
-    double rotation = m_lyrRotation * 10 + m_GerberImageFile->m_ImageRotation * 10;
+    double rotation = m_drawParams->m_LyrRotation * 10 + m_GerberImageFile->m_ImageRotation * 10;
 
     if( rotation )
         RotatePoint( &xyPos, rotation );
 
-    xyPos.x = KiROUND( xyPos.x / m_drawScale.x );
-    xyPos.y = KiROUND( xyPos.y / m_drawScale.y );
-    xyPos  -= m_layerOffset + m_GerberImageFile->m_ImageOffset;
+    xyPos.x = KiROUND( xyPos.x / m_drawParams->m_DrawScale.x );
+    xyPos.y = KiROUND( xyPos.y / m_drawParams->m_DrawScale.y );
+    xyPos  -= m_drawParams->m_LayerOffset + m_GerberImageFile->m_ImageOffset;
 
-    if( m_swapAxis )
+    if( m_drawParams->m_SwapAxis )
         std::swap( xyPos.x, xyPos.y );
 
     return xyPos - m_GerberImageFile->m_ImageJustifyOffset;
@@ -207,18 +232,9 @@ wxPoint GERBER_DRAW_ITEM::GetXYPosition( const wxPoint& aABPosition ) const
 
 void GERBER_DRAW_ITEM::SetLayerParameters()
 {
-    m_UnitsMetric = m_GerberImageFile->m_GerbMetric;
-    m_swapAxis    = m_GerberImageFile->m_SwapAxis;     // false if A = X, B = Y;
-
-    // true if A =Y, B = Y
-    m_mirrorA     = m_GerberImageFile->m_MirrorA;      // true: mirror / axe A
-    m_mirrorB     = m_GerberImageFile->m_MirrorB;      // true: mirror / axe B
-    m_drawScale   = m_GerberImageFile->m_Scale;        // A and B scaling factor
-    m_layerOffset = m_GerberImageFile->m_Offset;       // Offset from OF command
-
-    // Rotation from RO command:
-    m_lyrRotation = m_GerberImageFile->m_LocalRotation;
+    m_drawParams    = m_GerberImageFile->GetDrawParams();
     m_LayerNegative = m_GerberImageFile->GetLayerParams().m_LayerNegative;
+    m_boundingBoxValid = false;
 }
 
 
@@ -280,6 +296,35 @@ D_CODE* GERBER_DRAW_ITEM::GetDcodeDescr() const
 
 
 const EDA_RECT GERBER_DRAW_ITEM::GetBoundingBox() const
+{
+    // The box is needed by the view, the hit tests and the spatial index of the image,
+    // and can be long to calculate (aperture macros)
+    if( !m_boundingBoxValid )
+    {
+        m_boundingBox = computeBoundingBox();
+        m_boundingBoxValid = true;
+    }
+
+    return m_boundingBox;
+}
+
+
+const EDA_RECT GERBER_DRAW_ITEM::GetHitTestBoundingBox() const
+{
+    // HitTest() accepts positions outside of the bounding box: up to the line width for
+    // arcs, and at least MIN_HIT_TEST_RADIUS.  The item sizes are in XY axis, so are scaled.
+    double scale = std::max( std::fabs( m_drawParams->m_DrawScale.x ),
+                             std::fabs( m_drawParams->m_DrawScale.y ) );
+    int    size  = std::max( std::max( m_Size.x, m_Size.y ), MIN_HIT_TEST_RADIUS );
+
+    EDA_RECT bbox = GetBoundingBox();
+    bbox.Inflate( KiROUND( size * std::max( scale, 1.0 ) ) );
+
+    return bbox;
+}
+
+
+const EDA_RECT GERBER_DRAW_ITEM::computeBoundingBox() const
 {
     // return a rectangle which is (pos,dim) in nature.  therefore the +1
     EDA_RECT bbox( m_Start, wxSize( 1, 1 ) );
@@ -378,28 +423,22 @@ const EDA_RECT GERBER_DRAW_ITEM::GetBoundingBox() const
 
     case GBR_SEGMENT:
     {
-        if( code && code->m_Shape == APT_RECT )
-        {
-            if( m_Polygon.OutlineCount() > 0 )
-            {
-                auto bb = m_Polygon.BBox();
-                bbox.Inflate( bb.GetWidth() / 2, bb.GetHeight() / 2 );
-                bbox.SetOrigin( bb.GetOrigin().x, bb.GetOrigin().y );
-            }
-        }
-        else
-        {
-            int radius = ( m_Size.x + 1 ) / 2;
+        // A line drawn with a rectangular aperture is the rectangle swept along the line.
+        // Its polygon is only built when the line is drawn, so it is not used here: the
+        // cached box must not depend on it.
+        int radius_x = ( m_Size.x + 1 ) / 2;
+        int radius_y = radius_x;
 
-            int ymax = std::max( m_Start.y, m_End.y ) + radius;
-            int xmax = std::max( m_Start.x, m_End.x ) + radius;
+        if( code && code->m_Shape == APT_RECT )
+            radius_y = ( m_Size.y + 1 ) / 2;
 
-            int ymin = std::min( m_Start.y, m_End.y ) - radius;
-            int xmin = std::min( m_Start.x, m_End.x ) - radius;
+        int ymax = std::max( m_Start.y, m_End.y ) + radius_y;
+        int xmax = std::max( m_Start.x, m_End.x ) + radius_x;
 
-            bbox = EDA_RECT( wxPoint( xmin, ymin ), wxSize( xmax - xmin + 1, ymax - ymin + 1 ) );
-        }
+        int ymin = std::min( m_Start.y, m_End.y ) - radius_y;
+        int xmin = std::min( m_Start.x, m_End.x ) - radius_x;
 
+        bbox = EDA_RECT( wxPoint( xmin, ymin ), wxSize( xmax - xmin + 1, ymax - ymin + 1 ) );
         break;
     }
     default:
@@ -429,6 +468,7 @@ void GERBER_DRAW_ITEM::MoveAB( const wxPoint& aMoveVector )
     m_ArcCentre += xymove;
 
     m_Polygon.Move( VECTOR2I( xymove ) );
+    m_boundingBoxValid = false;
 }
 
 
@@ -439,6 +479,7 @@ void GERBER_DRAW_ITEM::MoveXY( const wxPoint& aMoveVector )
     m_ArcCentre += aMoveVector;
 
     m_Polygon.Move( VECTOR2I( aMoveVector ) );
+    m_boundingBoxValid = false;
 }
 
 
@@ -671,10 +712,10 @@ void GERBER_DRAW_ITEM::GetMsgPanelInfo( EDA_UNITS aUnits, std::vector<MSG_PANEL_
     {
         msg = _( "Attribute" );
 
-        if( m_AperFunction.IsEmpty() )
+        if( GetAperFunction().IsEmpty() )
             text = _( "No attribute" );
         else
-            text = m_AperFunction;
+            text = GetAperFunction();
     }
     else
     {
@@ -694,10 +735,10 @@ void GERBER_DRAW_ITEM::GetMsgPanelInfo( EDA_UNITS aUnits, std::vector<MSG_PANEL_
     aList.emplace_back( _( "Graphic Layer" ), msg, DARKGREEN );
 
     // Display item rotation
-    // The full rotation is Image rotation + m_lyrRotation
-    // but m_lyrRotation is specific to this object
+    // The full rotation is Image rotation + m_LyrRotation
+    // but m_LyrRotation is specific to this object
     // so we display only this parameter
-    msg.Printf( wxT( "%f" ), m_lyrRotation );
+    msg.Printf( wxT( "%f" ), m_drawParams->m_LyrRotation );
     aList.emplace_back( _( "Rotation" ), msg, BLUE );
 
     // Display item polarity (item specific)
@@ -706,50 +747,52 @@ void GERBER_DRAW_ITEM::GetMsgPanelInfo( EDA_UNITS aUnits, std::vector<MSG_PANEL_
 
     // Display mirroring (item specific)
     msg.Printf( wxT( "A:%s B:%s" ),
-                m_mirrorA ? _("Yes") : _("No"),
-                m_mirrorB ? _("Yes") : _("No"));
+                m_drawParams->m_MirrorA ? _("Yes") : _("No"),
+                m_drawParams->m_MirrorB ? _("Yes") : _("No"));
     aList.emplace_back( _( "Mirror" ), msg, DARKRED );
 
     // Display AB axis swap (item specific)
-    msg = m_swapAxis ? wxT( "A=Y B=X" ) : wxT( "A=X B=Y" );
+    msg = m_drawParams->m_SwapAxis ? wxT( "A=Y B=X" ) : wxT( "A=X B=Y" );
     aList.emplace_back( _( "AB axis" ), msg, DARKRED );
 
     // Display net info, if exists
-    if( m_netAttributes.m_NetAttribType == GBR_NETLIST_METADATA::GBR_NETINFO_UNSPECIFIED )
+    const GBR_NETLIST_METADATA& netAttributes = GetNetAttributes();
+
+    if( netAttributes.m_NetAttribType == GBR_NETLIST_METADATA::GBR_NETINFO_UNSPECIFIED )
         return;
 
     // Build full net info:
     wxString net_msg;
     wxString cmp_pad_msg;
 
-    if( ( m_netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_NET ) )
+    if( ( netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_NET ) )
     {
         net_msg = _( "Net:" );
         net_msg << " ";
 
-        if( m_netAttributes.m_Netname.IsEmpty() )
+        if( netAttributes.m_Netname.IsEmpty() )
             net_msg << "<no net>";
         else
-            net_msg << UnescapeString( m_netAttributes.m_Netname );
+            net_msg << UnescapeString( netAttributes.m_Netname );
     }
 
-    if( ( m_netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_PAD ) )
+    if( ( netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_PAD ) )
     {
-        if( m_netAttributes.m_PadPinFunction.IsEmpty() )
+        if( netAttributes.m_PadPinFunction.IsEmpty() )
             cmp_pad_msg.Printf( _( "Cmp: %s  Pad: %s" ),
-                                m_netAttributes.m_Cmpref,
-                                m_netAttributes.m_Padname.GetValue() );
+                                netAttributes.m_Cmpref,
+                                netAttributes.m_Padname.GetValue() );
         else
             cmp_pad_msg.Printf( _( "Cmp: %s  Pad: %s  Fct %s" ),
-                                m_netAttributes.m_Cmpref,
-                                m_netAttributes.m_Padname.GetValue(),
-                                m_netAttributes.m_PadPinFunction.GetValue() );
+                                netAttributes.m_Cmpref,
+                                netAttributes.m_Padname.GetValue(),
+                                netAttributes.m_PadPinFunction.GetValue() );
     }
 
-    else if( ( m_netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_CMP ) )
+    else if( ( netAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_CMP ) )
     {
         cmp_pad_msg = _( "Cmp:" );
-        cmp_pad_msg << " " << m_netAttributes.m_Cmpref;
+        cmp_pad_msg << " " << netAttributes.m_Cmpref;
     }
 
     aList.emplace_back( net_msg, cmp_pad_msg, DARKCYAN );
@@ -786,9 +829,6 @@ BITMAP_DEF GERBER_DRAW_ITEM::GetMenuImage() const
 
 bool GERBER_DRAW_ITEM::HitTest( const wxPoint& aRefPos, int aAccuracy ) const
 {
-    // In case the item has a very tiny width defined, allow it to be selected
-    const int MIN_HIT_TEST_RADIUS = Millimeter2iu( 0.01 );
-
     // calculate aRefPos in XY gerber axis:
     wxPoint ref_pos = GetXYPosition( aRefPos );
 
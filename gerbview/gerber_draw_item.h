@@ -65,6 +65,41 @@ enum Gbr_Basic_Shapes {
 
 /***/
 
+/**
+ * GERBER_DRAW_PARAMS
+ * The image parameters used to convert the coordinates of an item from the X,Y gerber axis
+ * to the A,B draw axis.  They can change along a gerber file, but seldom do: the items
+ * created while they do not change share the same instance, owned by their GERBER_FILE_IMAGE.
+ */
+struct GERBER_DRAW_PARAMS
+{
+    bool        m_UnitsMetric;              // the gerber units (inch/mm)
+    bool        m_SwapAxis;                 // false if A = X, B = Y; true if A = Y, B = X
+    bool        m_MirrorA;                  // true: mirror / axe A
+    bool        m_MirrorB;                  // true: mirror / axe B
+    wxRealPoint m_DrawScale;                // A and B scaling factor
+    wxPoint     m_LayerOffset;              // Offset for A and B axis, from OF parameter
+    double      m_LyrRotation;              // Fine rotation, from OR parameter, in degrees
+
+    GERBER_DRAW_PARAMS() :
+            m_UnitsMetric( false ),
+            m_SwapAxis( false ),
+            m_MirrorA( false ),
+            m_MirrorB( false ),
+            m_DrawScale( 1.0, 1.0 ),
+            m_LyrRotation( 0.0 )
+    {}
+
+    bool operator==( const GERBER_DRAW_PARAMS& aOther ) const
+    {
+        return m_UnitsMetric == aOther.m_UnitsMetric && m_SwapAxis == aOther.m_SwapAxis
+               && m_MirrorA == aOther.m_MirrorA && m_MirrorB == aOther.m_MirrorB
+               && m_DrawScale == aOther.m_DrawScale && m_LayerOffset == aOther.m_LayerOffset
+               && m_LyrRotation == aOther.m_LyrRotation;
+    }
+};
+
+
 class GERBER_DRAW_ITEM : public EDA_ITEM
 {
     // make SetNext() and SetBack() private so that they may not be called from anywhere.
@@ -73,8 +108,6 @@ private:
 
 
 public:
-    bool               m_UnitsMetric;       // store here the gerber units (inch/mm).  Used
-                                            // only to calculate aperture macros shapes sizes
     int                m_Shape;             // Shape and type of this gerber item
     wxPoint            m_Start;             // Line or arc start point or position of the shape
                                             // for flashed items
@@ -90,10 +123,6 @@ public:
                                             // values 0 to 9 can be used for special purposes
                                             // Regions (polygons) doo not use DCode,
                                             // so it is set to 0
-    wxString           m_AperFunction;      // the aperture function set by a %TA.AperFunction, xxx
-                                            // (stores thre xxx value).
-                                            // used for regions that do not have a attached DCode, but
-                                            // have a TA.AperFunction defined
     GERBER_FILE_IMAGE* m_GerberImageFile;   /* Gerber file image source of this item
                                              * Note: some params stored in this class are common
                                              * to the whole gerber file (i.e) the whole graphic
@@ -105,24 +134,41 @@ public:
 private:
     // These values are used to draw this item, according to gerber layers parameters
     // Because they can change inside a gerber image, they are stored here
-    // for each item
+    // for each item.  A gerber set can have millions of items, so the values which are
+    // the same for many items are shared: they are stored by m_GerberImageFile, and the
+    // item only points them.
     bool        m_LayerNegative;            // true = item in negative Layer
-    bool        m_swapAxis;                 // false if A = X, B = Y; true if A =Y, B = Y
-    bool        m_mirrorA;                  // true: mirror / axe A
-    bool        m_mirrorB;                  // true: mirror / axe B
-    wxRealPoint m_drawScale;                // A and B scaling factor
-    wxPoint     m_layerOffset;              // Offset for A and B axis, from OF parameter
-    double      m_lyrRotation;              // Fine rotation, from OR parameter, in degrees
-    GBR_NETLIST_METADATA m_netAttributes;   ///< the string given by a %TO attribute set in aperture
-                                            ///< (dcode). Stored in each item, because %TO is
-                                            ///< a dynamic object attribute
+    const GERBER_DRAW_PARAMS* m_drawParams; // axis, mirror, scale, offset and rotation.
+                                            // Never NULL
+    const GBR_NETLIST_METADATA* m_netAttributes; ///< the attributes given by a %TO command,
+                                            ///< stored in each item because %TO is a dynamic
+                                            ///< object attribute.  NULL if none
+    const wxString* m_aperFunction;         // the aperture function set by a %TA.AperFunction, xxx
+                                            // (stores thre xxx value).
+                                            // used for regions that do not have a attached DCode,
+                                            // but have a TA.AperFunction defined.  NULL if none
+    mutable EDA_RECT m_boundingBox;         // cached by GetBoundingBox()
+    mutable bool     m_boundingBoxValid;
 
 public:
     GERBER_DRAW_ITEM( GERBER_FILE_IMAGE* aGerberparams );
     ~GERBER_DRAW_ITEM();
 
     void SetNetAttributes( const GBR_NETLIST_METADATA& aNetAttributes );
-    const GBR_NETLIST_METADATA& GetNetAttributes() const { return m_netAttributes; }
+    const GBR_NETLIST_METADATA& GetNetAttributes() const;
+
+    /**
+     * Function SetAperFunction
+     * sets the aperture function of an item having no D_Code (a region)
+     */
+    void SetAperFunction( const wxString& aAperFunction );
+
+    /**
+     * Function GetAperFunction
+     * @return the aperture function of an item having no D_Code (a region), or an empty
+     * string.  Items having a D_Code use the aperture function of their D_Code.
+     */
+    const wxString& GetAperFunction() const;
 
     /**
      * Function GetLayer
@@ -229,8 +275,20 @@ public:
      */
     D_CODE* GetDcodeDescr() const;
 
+    /**
+     * Function GetBoundingBox
+     * @return the bounding box, in AB axis.  It is cached: it is computed again only after
+     * the item is moved or its layer parameters are changed.
+     */
     const EDA_RECT GetBoundingBox() const override;
 
+    /**
+     * Function GetHitTestBoundingBox
+     * @return the bounding box inflated by the tolerance of HitTest(), so HitTest() is
+     * false outside of it
+     */
+    const EDA_RECT GetHitTestBoundingBox() const;
+
     void Print( wxDC* aDC, const wxPoint& aOffset, GBR_DISPLAY_OPTIONS* aOptions );
 
     /**
@@ -302,6 +360,9 @@ public:
 
     ///> @copydoc EDA_ITEM::GetMenuImage()
     BITMAP_DEF GetMenuImage() const override;
+
+private:
+    const EDA_RECT computeBoundingBox() const;
 };
 
 
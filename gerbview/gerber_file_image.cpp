@@ -95,6 +95,7 @@ GERBER_FILE_IMAGE::GERBER_FILE_IMAGE( int aLayer ) :
 
     m_Selected_Tool = 0;
     m_FileFunction = NULL;          // file function parameters
+    m_itemsIndexValid = false;
 
     ResetDefaultValues();
 
@@ -167,6 +168,93 @@ APERTURE_MACRO* GERBER_FILE_IMAGE::FindApertureMacro( const APERTURE_MACRO& aLoo
 }
 
 
+void GERBER_FILE_IMAGE::BuildItemsIndex()
+{
+    m_itemsIndex.RemoveAll();
+
+    for( size_t ii = 0; ii < m_drawings.size(); ++ii )
+    {
+        const EDA_RECT bbox    = m_drawings[ii]->GetHitTestBoundingBox();
+        const int      mmin[2] = { bbox.GetX(), bbox.GetY() };
+        const int      mmax[2] = { bbox.GetRight(), bbox.GetBottom() };
+
+        m_itemsIndex.Insert( mmin, mmax, ii );
+    }
+
+    m_itemsIndexValid = true;
+}
+
+
+void GERBER_FILE_IMAGE::GetItemsAt( const wxPoint& aRefPos,
+                                    std::vector<GERBER_DRAW_ITEM*>& aList )
+{
+    if( !m_itemsIndexValid )
+        BuildItemsIndex();
+
+    const int           pos[2] = { aRefPos.x, aRefPos.y };
+    std::vector<size_t> found;
+
+    m_itemsIndex.Search( pos, pos,
+            [&found]( const size_t& aIndex )
+            {
+                found.push_back( aIndex );
+                return true;
+            } );
+
+    std::sort( found.begin(), found.end() );
+
+    for( size_t index : found )
+        aList.push_back( m_drawings[index] );
+}
+
+
+const GERBER_DRAW_PARAMS* GERBER_FILE_IMAGE::GetDrawParams()
+{
+    GERBER_DRAW_PARAMS params;
+
+    params.m_UnitsMetric = m_GerbMetric;
+    params.m_SwapAxis    = m_SwapAxis;
+    params.m_MirrorA     = m_MirrorA;
+    params.m_MirrorB     = m_MirrorB;
+    params.m_DrawScale   = m_Scale;
+    params.m_LayerOffset = m_Offset;        // Offset from OF command
+    params.m_LyrRotation = m_LocalRotation; // Rotation from RO command
+
+    // These parameters are set in the file header, and seldom change later
+    if( m_drawParamsPool.empty() || !( m_drawParamsPool.back() == params ) )
+        m_drawParamsPool.push_back( params );
+
+    return &m_drawParamsPool.back();
+}
+
+
+const GBR_NETLIST_METADATA* GERBER_FILE_IMAGE::InternNetAttributes(
+        const GBR_NETLIST_METADATA& aNetAttributes )
+{
+    // The attributes set by a %TO command are used by all the following items, until the
+    // next %TO or %TD command, so only the last entry is a candidate
+    if( !m_netAttributesPool.empty() && m_netAttributesPool.back() == aNetAttributes )
+        return &m_netAttributesPool.back();
+
+    m_netAttributesPool.push_back( aNetAttributes );
+
+    if( ( aNetAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_CMP ) ||
+        ( aNetAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_PAD ) )
+        m_ComponentsList.insert( std::make_pair( aNetAttributes.m_Cmpref, 0 ) );
+
+    if( ( aNetAttributes.m_NetAttribType & GBR_NETLIST_METADATA::GBR_NETINFO_NET ) )
+        m_NetnamesList.insert( std::make_pair( aNetAttributes.m_Netname, 0 ) );
+
+    return &m_netAttributesPool.back();
+}
+
+
+const wxString* GERBER_FILE_IMAGE::InternString( const wxString& aText )
+{
+    return &*m_stringPool.insert( aText ).first;
+}
+
+
 void GERBER_FILE_IMAGE::ResetDefaultValues()
 {
     m_InUse         = false;
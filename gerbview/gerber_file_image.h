@@ -25,6 +25,7 @@
 #ifndef GERBER_FILE_IMAGE_H
 #define GERBER_FILE_IMAGE_H
 
+#include <deque>
 #include <vector>
 #include <set>
 
@@ -33,6 +34,8 @@
 #include <am_primitive.h>
 #include <gbr_netlist_metadata.h>
 
+#include <geometry/rtree.h>
+
 // An useful macro used when reading gerber files;
 #define IsNumber( x ) ( ( ( (x) >= '0' ) && ( (x) <='9' ) )   \
                        || ( (x) == '-' ) || ( (x) == '+' )  || ( (x) == '.' ) )
@@ -41,6 +44,7 @@ typedef std::vector<GERBER_DRAW_ITEM*> GERBER_DRAW_ITEMS;
 
 class GERBVIEW_FRAME;
 class D_CODE;
+class GERBER_LINE_READER;
 
 /* gerber files have different parameters to define units and how items must be plotted.
  *  some are for the entire file, and other can change along a file.
@@ -181,6 +185,17 @@ public:
     std::map<wxString, int> m_NetnamesList;                     // list of net names
 
 private:
+    // The attributes shared by the items (see GERBER_DRAW_ITEM).  The items point to these
+    // entries, so they are only released with the image.
+    std::deque<GERBER_DRAW_PARAMS>   m_drawParamsPool;
+    std::deque<GBR_NETLIST_METADATA> m_netAttributesPool;
+    std::set<wxString>               m_stringPool;
+
+    // Spatial index of m_drawings, by hit test area.  The data is the index of the item in
+    // m_drawings, to return the items in the drawing order.
+    RTree<size_t, int, 2, double> m_itemsIndex;
+    bool                          m_itemsIndexValid;
+
     wxArrayString      m_messagesList;                          // A list of messages created when reading a file
     int                m_hasNegativeItems;                      // true if the image is negative or has some negative items
                                                                 // Used to optimize drawing, because when there are no
@@ -193,27 +208,26 @@ private:
      * test for an end of line
      * if a end of line is found:
      *   read a new line
-     * @param aBuff = buffer (size = GERBER_BUFZ) to fill with a new line
-     * @param aText = pointer to the last useful char in aBuff
+     * @param aReader = the reader of the GERBER file (can be null: no new line is read)
+     * @param aText = pointer to the last useful char in the current line
      *          on return: points the beginning of the next line.
-     * @param aBuffSize = the size in bytes of aBuff
-     * @param aFile = the opened GERBER file to read
      * @return a pointer to the beginning of the next line or NULL if end of file
     */
-    char* GetNextLine( char *aBuff, unsigned int aBuffSize, char* aText, FILE* aFile );
+    char* GetNextLine( GERBER_LINE_READER* aReader, char* aText );
 
-    bool GetEndOfBlock( char* aBuff, unsigned int aBuffSize, char*& aText, FILE* aGerberFile );
+    bool GetEndOfBlock( GERBER_LINE_READER* aReader, char*& aText );
 
     /**
       * reads a single RS274X command terminated with a %
      */
-    bool ReadRS274XCommand( char *aBuff, unsigned int aBuffSize, char*& aText );
+    bool ReadRS274XCommand( GERBER_LINE_READER* aReader, char*& aText );
 
     /**
      * executes a RS274X command
+     * @param aReader = the reader of the GERBER file, to read the lines of commands
+     *          spanning several lines (can be null)
      */
-    bool ExecuteRS274XCommand( int aCommand, char* aBuff,
-                               unsigned int aBuffSize, char*& aText );
+    bool ExecuteRS274XCommand( int aCommand, GERBER_LINE_READER* aReader, char*& aText );
 
     /**
      * reads two bytes of data and assembles them into an int with the first
@@ -227,16 +241,12 @@ private:
 
     /**
      * reads in an aperture macro and saves it in m_aperture_macros.
-     * @param aBuff a character buffer at least GERBER_BUFZ long that can be
-     *          used to read successive lines from the gerber file.
+     * @param aReader Which file reader to read from for continuation.
      * @param text A reference to a character pointer which gives the initial
      *              text to read from.
-     * @param aBuffSize is the size of aBuff
-     * @param gerber_file Which file to read from for continuation.
      * @return bool - true if a macro was read in successfully, else false.
      */
-    bool ReadApertureMacro( char *aBuff, unsigned int aBuffSize,
-                            char* & text, FILE * gerber_file );
+    bool ReadApertureMacro( GERBER_LINE_READER* aReader, char* & text );
 
     // functions to execute G commands or D basic commands:
     bool    Execute_G_Command( char*& text, int G_command );
@@ -288,8 +298,23 @@ public:
     void AddItemToList( GERBER_DRAW_ITEM* aItem )
     {
         m_drawings.push_back( aItem );
+        m_itemsIndexValid = false;
     }
 
+    /**
+     * Function BuildItemsIndex
+     * builds the spatial index of the items, used by GetItemsAt().  It is built when the
+     * file is read, and built again by GetItemsAt() if items were added since.
+     */
+    void BuildItemsIndex();
+
+    /**
+     * Function GetItemsAt
+     * fills aList with the items which can be hit at aRefPos (whose hit test area contains
+     * aRefPos), in the items list order.  The caller still has to test them with HitTest().
+     */
+    void GetItemsAt( const wxPoint& aRefPos, std::vector<GERBER_DRAW_ITEM*>& aList );
+
     /**
      * @return the last GERBER_DRAW_ITEM* item of the items list
      */
@@ -315,6 +340,26 @@ public:
      */
     bool HasNegativeItems();
 
+    /**
+     * Function GetDrawParams
+     * @return the current draw parameters of the image (axis, mirror, scale, offset and
+     * rotation), as an instance shared by the items created with the same parameters
+     */
+    const GERBER_DRAW_PARAMS* GetDrawParams();
+
+    /**
+     * Function InternNetAttributes
+     * @return an instance equal to aNetAttributes, shared by the items having the same net
+     * attributes.  The components and net names lists are updated with the new attributes.
+     */
+    const GBR_NETLIST_METADATA* InternNetAttributes( const GBR_NETLIST_METADATA& aNetAttributes );
+
+    /**
+     * Function InternString
+     * @return an instance equal to aText, shared by the items having the same attribute text
+     */
+    const wxString* InternString( const wxString& aText );
+
     /**
      * Function ClearMessageList
      * Clear the message list
@@ -0,0 +1,100 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file gerber_line_reader.h
+ */
+
+#ifndef GERBER_LINE_READER_H
+#define GERBER_LINE_READER_H
+
+#include <cstring>
+#include <vector>
+#include <wx/string.h>
+
+
+/**
+ * GERBER_LINE_READER
+ * reads the lines of a Gerber file without copying them.
+ *
+ * The whole file is read in one block when opened, then each line is terminated in place
+ * (its '\n' is replaced by a nul), so a line is a pointer inside the file data, valid as
+ * long as the reader.  Unlike fgets() there is no limit on the line length.
+ */
+class GERBER_LINE_READER
+{
+public:
+    GERBER_LINE_READER() :
+        m_next( nullptr ),
+        m_end( nullptr ),
+        m_line( nullptr )
+    {
+    }
+
+    /**
+     * Function Open
+     * reads the file \a aFileName
+     * @return true on success
+     */
+    bool Open( const wxString& aFileName );
+
+    /**
+     * Function ReadLine
+     * @return the next line, without its end of line, or NULL at the end of the file
+     */
+    char* ReadLine()
+    {
+        if( m_next >= m_end )
+            return NULL;
+
+        m_line = m_next;
+
+        char* eol = (char*) memchr( m_next, '\n', m_end - m_next );
+
+        if( eol )
+        {
+            *eol = 0;
+            m_next = eol + 1;
+        }
+        else
+        {
+            m_next = m_end;         // last line: the data ends by a nul
+        }
+
+        return m_line;
+    }
+
+    /**
+     * Function Line
+     * @return the last line read, or NULL if no line was read
+     */
+    char* Line() const { return m_line; }
+
+private:
+    std::vector<char> m_data;       // the file data, followed by a nul
+    char*             m_next;       // the beginning of the next line
+    char*             m_end;        // the end of the file data
+    char*             m_line;       // the last line read
+};
+
+#endif  // GERBER_LINE_READER_H
@@ -645,6 +645,48 @@ void GERBVIEW_FRAME::UpdateDisplayOptions( const GBR_DISPLAY_OPTIONS& aOptions )
 }
 
 
+void GERBVIEW_FRAME::SetHighlightStrings( const wxString& aNetName, const wxString& aComponent,
+                                         const wxString& aAperFunction )
+{
+    KIGFX::VIEW* view = GetCanvas()->GetView();
+    auto settings = static_cast<KIGFX::GERBVIEW_PAINTER*>( view->GetPainter() )->GetSettings();
+    std::vector<GERBER_DRAW_ITEM*> changed;
+
+    auto collectHighlighted =
+            [&]()
+            {
+                GERBER_FILE_IMAGE_LIST* images = GetImagesList();
+
+                for( unsigned layer = 0; layer < images->ImagesMaxCount(); ++layer )
+                {
+                    GERBER_FILE_IMAGE* gerber = images->GetGbrImage( layer );
+
+                    if( !gerber )
+                        continue;
+
+                    for( GERBER_DRAW_ITEM* item : gerber->GetItems() )
+                    {
+                        if( settings->IsHighlighted( item ) )
+                            changed.push_back( item );
+                    }
+                }
+            };
+
+    // The items highlighted before and after the change are the only ones whose color
+    // can change (items highlighted in both states are just updated twice)
+    collectHighlighted();
+
+    settings->m_netHighlightString       = aNetName;
+    settings->m_componentHighlightString = aComponent;
+    settings->m_attributeHighlightString = aAperFunction;
+
+    collectHighlighted();
+
+    for( GERBER_DRAW_ITEM* item : changed )
+        view->Update( item, KIGFX::COLOR );
+}
+
+
 void GERBVIEW_FRAME::UpdateTitleAndInfo()
 {
     GERBER_FILE_IMAGE* gerber = GetGbrImage( GetActiveLayer() );
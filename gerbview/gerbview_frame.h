@@ -205,6 +205,16 @@ private:
                                         const wxArrayString& aFilenameList,
                                         const std::vector<int>* aFileType = nullptr );
 
+    /**
+     * Adds an image read by GERBER_FILE_IMAGE::LoadGerberFile() on the active layer,
+     * replacing the current image of this layer, and displays the messages of the file
+     * @param aImage is the image, owned by the frame on return, or NULL if the file
+     * could not be read
+     * @param aFullFileName is the name of the file, for error messages
+     * @return true if the image was added
+     */
+    bool addGerberImage( GERBER_FILE_IMAGE* aImage, const wxString& aFullFileName );
+
 public:
     GERBVIEW_FRAME( KIWAY* aKiway, wxWindow* aParent );
     ~GERBVIEW_FRAME();
@@ -418,6 +428,15 @@ public:
     /// Handles the changing of the highlighted component/net/attribute
     void OnSelectHighlightChoice( wxCommandEvent& event );
 
+    /**
+     * Function SetHighlightStrings
+     * Changes the highlighted net, component and aperture attribute (an empty string
+     * highlights nothing), and updates the color of the items whose highlight state
+     * changed, rather than of all the items of the view.
+     */
+    void SetHighlightStrings( const wxString& aNetName, const wxString& aComponent,
+                              const wxString& aAperFunction );
+
     /**
      * Function OnSelectActiveDCode
      * Selects the active DCode for the current active layer.
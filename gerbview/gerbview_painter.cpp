@@ -122,16 +122,7 @@ const COLOR4D& GERBVIEW_RENDER_SETTINGS::GetColor( const VIEW_ITEM* aItem, int a
             return transparent;
     }
 
-    if( !m_netHighlightString.IsEmpty() && gbrItem &&
-        m_netHighlightString == gbrItem->GetNetAttributes().m_Netname )
-        return m_layerColorsHi[aLayer];
-
-    if( !m_componentHighlightString.IsEmpty() && gbrItem &&
-        m_componentHighlightString == gbrItem->GetNetAttributes().m_Cmpref )
-        return m_layerColorsHi[aLayer];
-
-    if( !m_attributeHighlightString.IsEmpty() && gbrItem && gbrItem->GetDcodeDescr() &&
-        m_attributeHighlightString == gbrItem->GetDcodeDescr()->m_AperFunction )
+    if( gbrItem && IsHighlighted( gbrItem ) )
         return m_layerColorsHi[aLayer];
 
     // Return grayish color for non-highlighted layers in the high contrast mode
@@ -148,6 +139,24 @@ const COLOR4D& GERBVIEW_RENDER_SETTINGS::GetColor( const VIEW_ITEM* aItem, int a
 }
 
 
+bool GERBVIEW_RENDER_SETTINGS::IsHighlighted( const GERBER_DRAW_ITEM* aItem ) const
+{
+    if( !m_netHighlightString.IsEmpty()
+            && m_netHighlightString == aItem->GetNetAttributes().m_Netname )
+        return true;
+
+    if( !m_componentHighlightString.IsEmpty()
+            && m_componentHighlightString == aItem->GetNetAttributes().m_Cmpref )
+        return true;
+
+    if( !m_attributeHighlightString.IsEmpty() && aItem->GetDcodeDescr()
+            && m_attributeHighlightString == aItem->GetDcodeDescr()->m_AperFunction )
+        return true;
+
+    return false;
+}
+
+
 GERBVIEW_PAINTER::GERBVIEW_PAINTER( GAL* aGal ) :
     PAINTER( aGal )
 {
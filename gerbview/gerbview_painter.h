@@ -65,6 +65,12 @@ public:
     /// @copydoc RENDER_SETTINGS::GetColor()
     virtual const COLOR4D& GetColor( const VIEW_ITEM* aItem, int aLayer ) const override;
 
+    /**
+     * Function IsHighlighted
+     * @return true if \a aItem matches the highlighted net, component or aperture attribute.
+     */
+    bool IsHighlighted( const GERBER_DRAW_ITEM* aItem ) const;
+
     /**
      * Function GetLayerColor
      * Returns the color used to draw a layer.
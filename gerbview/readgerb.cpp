@@ -30,6 +30,7 @@
 #include <gerbview_frame.h>
 #include <gerber_file_image.h>
 #include <gerber_file_image_list.h>
+#include <gerber_line_reader.h>
 #include <view/view.h>
 
 #include <html_messagebox.h>
@@ -38,39 +39,51 @@
 /* Read a gerber file, RS274D, RS274X or RS274X2 format.
  */
 bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
+{
+    GERBER_FILE_IMAGE* gerber = new GERBER_FILE_IMAGE( GetActiveLayer() );
+
+    // Read the gerber file. The image will be added only if it can be read
+    // to avoid broken data.
+    if( !gerber->LoadGerberFile( GERBER_FullFileName ) )
+    {
+        delete gerber;
+        gerber = NULL;
+    }
+
+    return addGerberImage( gerber, GERBER_FullFileName );
+}
+
+
+bool GERBVIEW_FRAME::addGerberImage( GERBER_FILE_IMAGE* aImage,
+                                     const wxString& aFullFileName )
 {
     wxString msg;
 
     int layer = GetActiveLayer();
     GERBER_FILE_IMAGE_LIST* images = GetImagesList();
-    GERBER_FILE_IMAGE* gerber = GetGbrImage( layer );
 
-    if( gerber != NULL )
+    if( GetGbrImage( layer ) != NULL )
     {
         Erase_Current_DrawLayer( false );
     }
 
-    gerber = new GERBER_FILE_IMAGE( layer );
-
-    // Read the gerber file. The image will be added only if it can be read
-    // to avoid broken data.
-    bool success = gerber->LoadGerberFile( GERBER_FullFileName );
-
-    if( !success )
+    if( aImage == NULL )
     {
-        delete gerber;
-        msg.Printf( _( "File \"%s\" not found" ), GERBER_FullFileName );
+        msg.Printf( _( "File \"%s\" not found" ), aFullFileName );
         DisplayError( this, msg, 10 );
         return false;
     }
 
-    images->AddGbrImage( gerber, layer );
+    // The file may have been read before the active layer was known
+    aImage->m_GraphicLayer = layer;
+
+    images->AddGbrImage( aImage, layer );
 
     // Display errors list
-    if( gerber->GetMessages().size() > 0 )
+    if( aImage->GetMessages().size() > 0 )
     {
         HTML_MESSAGE_BOX dlg( this, _("Errors") );
-        dlg.ListSet(gerber->GetMessages());
+        dlg.ListSet(aImage->GetMessages());
         dlg.ShowModal();
     }
 
@@ -79,9 +92,9 @@ bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
      * or has missing definitions,
      * warn the user:
      */
-    if( gerber->GetItemsCount() && gerber->m_Has_MissingDCode )
+    if( aImage->GetItemsCount() && aImage->m_Has_MissingDCode )
     {
-        if( !gerber->m_Has_DCode )
+        if( !aImage->m_Has_DCode )
             msg = _("Warning: this file has no D-Code definition\n"
                     "Therefore the size of some items is undefined");
         else
@@ -93,13 +106,13 @@ bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
 
     if( GetCanvas() )
     {
-        if( gerber->m_ImageNegative )
+        if( aImage->m_ImageNegative )
         {
             // TODO: find a way to handle negative images
             // (maybe convert geometry into positives?)
         }
 
-        for( auto item : gerber->GetItems() )
+        for( auto item : aImage->GetItems() )
             GetCanvas()->GetView()->Add( (KIGFX::VIEW_ITEM*) item );
     }
 
@@ -108,11 +121,35 @@ bool GERBVIEW_FRAME::Read_GERBER_File( const wxString& GERBER_FullFileName )
 
 
 
-// size of a single line of text from a gerber file.
-// warning: some files can have *very long* lines, so the buffer must be large.
-#define GERBER_BUFZ 1000000
-// A large buffer to store one line
-static char lineBuffer[GERBER_BUFZ+1];
+bool GERBER_LINE_READER::Open( const wxString& aFileName )
+{
+    FILE* file = wxFopen( aFileName, wxT( "rb" ) );
+
+    if( file == NULL )
+        return false;
+
+    fseek( file, 0, SEEK_END );
+    long size = ftell( file );
+    fseek( file, 0, SEEK_SET );
+
+    if( size < 0 )
+    {
+        fclose( file );
+        return false;
+    }
+
+    m_data.resize( size + 1 );
+    size_t len = fread( m_data.data(), 1, size, file );
+    fclose( file );
+
+    m_data[len] = 0;
+    m_next = m_data.data();
+    m_end  = m_next + len;
+    m_line = nullptr;
+
+    return true;
+}
+
 
 bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
 {
@@ -124,9 +161,9 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
     ResetDefaultValues();
 
     // Read the gerber file */
-    m_Current_File = wxFopen( aFullFileName, wxT( "rt" ) );
+    GERBER_LINE_READER reader;
 
-    if( m_Current_File == 0 )
+    if( !reader.Open( aFullFileName ) )
         return false;
 
     m_FileName = aFullFileName;
@@ -135,13 +172,10 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
 
     wxString msg;
 
-    while( true )
+    while( reader.ReadLine() )
     {
-        if( fgets( lineBuffer, GERBER_BUFZ, m_Current_File ) == NULL )
-            break;
-
         m_LineNum++;
-        text = StrPurge( lineBuffer );
+        text = StrPurge( reader.Line() );
 
         while( text && *text )
         {
@@ -198,7 +232,7 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
                 if( m_CommandState != ENTER_RS274X_CMD )
                 {
                     m_CommandState = ENTER_RS274X_CMD;
-                    ReadRS274XCommand( lineBuffer, GERBER_BUFZ, text );
+                    ReadRS274XCommand( &reader, text );
                 }
                 else        //Error
                 {
@@ -217,7 +251,8 @@ bool GERBER_FILE_IMAGE::LoadGerberFile( const wxString& aFullFileName )
         }
     }
 
-    fclose( m_Current_File );
+    // Build the spatial index now: the file can be read on a worker thread
+    BuildItemsIndex();
 
     m_InUse = true;
 
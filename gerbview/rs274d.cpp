@@ -340,7 +340,7 @@ static void fillArcPOLY(  GERBER_DRAW_ITEM* aGbrItem,
     /* in order to calculate arc parameters, we use fillArcGBRITEM
      * so we muse create a dummy track and use its geometric parameters
      */
-    static GERBER_DRAW_ITEM dummyGbrItem( NULL );
+    GERBER_DRAW_ITEM dummyGbrItem( NULL );
 
     aGbrItem->SetLayerPolarity( aLayerNegative );
 
@@ -495,7 +495,7 @@ bool GERBER_FILE_IMAGE::Execute_G_Command( char*& text, int G_command )
 
             char* cptr = (char*)x2buf.data();
             int code_command = ReadXCommandID( cptr );
-            ExecuteRS274XCommand( code_command, NULL, 0, cptr );
+            ExecuteRS274XCommand( code_command, NULL, cptr );
         }
 
         while( *text && (*text != '*') )
@@ -631,7 +631,7 @@ bool GERBER_FILE_IMAGE::Execute_DCODE_Command( char*& text, int D_commande )
                 if( gbritem->m_GerberImageFile )
                 {
                     gbritem->SetNetAttributes( gbritem->m_GerberImageFile->m_NetAttributeDict );
-                    gbritem->m_AperFunction = gbritem->m_GerberImageFile->m_AperFunction;
+                    gbritem->SetAperFunction( gbritem->m_GerberImageFile->m_AperFunction );
                 }
             }
 
@@ -58,20 +58,20 @@ int GERBVIEW_CONTROL::HighlightControl( const TOOL_EVENT& aEvent )
         m_frame->m_SelNetnameBox->SetSelection( 0 );
         m_frame->m_SelAperAttributesBox->SetSelection( 0 );
 
-        settings->m_netHighlightString = "";
-        settings->m_componentHighlightString = "";
-        settings->m_attributeHighlightString = "";
+        m_frame->SetHighlightStrings( wxEmptyString, wxEmptyString, wxEmptyString );
     }
     else if( item && aEvent.IsAction( &GERBVIEW_ACTIONS::highlightNet ) )
     {
         auto string = item->GetNetAttributes().m_Netname;
-        settings->m_netHighlightString = string;
+        m_frame->SetHighlightStrings( string, settings->m_componentHighlightString,
+                                      settings->m_attributeHighlightString );
         m_frame->m_SelNetnameBox->SetStringSelection( UnescapeString( string ) );
     }
     else if( item && aEvent.IsAction( &GERBVIEW_ACTIONS::highlightComponent ) )
     {
         auto string = item->GetNetAttributes().m_Cmpref;
-        settings->m_componentHighlightString = string;
+        m_frame->SetHighlightStrings( settings->m_netHighlightString, string,
+                                      settings->m_attributeHighlightString );
         m_frame->m_SelComponentBox->SetStringSelection( string );
     }
     else if( item && aEvent.IsAction( &GERBVIEW_ACTIONS::highlightAttribute ) )
@@ -80,12 +80,12 @@ int GERBVIEW_CONTROL::HighlightControl( const TOOL_EVENT& aEvent )
         if( apertDescr )
         {
             auto string = apertDescr->m_AperFunction;
-            settings->m_attributeHighlightString = string;
+            m_frame->SetHighlightStrings( settings->m_netHighlightString,
+                                          settings->m_componentHighlightString, string );
             m_frame->m_SelAperAttributesBox->SetStringSelection( string );
         }
     }
 
-    m_frame->GetCanvas()->GetView()->UpdateAllItems( KIGFX::COLOR );
     m_frame->GetCanvas()->Refresh();
 
     return 0;
@@ -88,6 +88,31 @@ public:
      */
     int m_coroutineStackSize;
 
+    /**
+     * Write the auto save files from a background thread
+     */
+    bool m_backgroundAutoSave;
+
+    /**
+     * Save the zone fills in the compact filled_polygon_data format
+     */
+    bool m_compressZoneFills;
+
+    /**
+     * Do not read the zone fills when opening a board, fill the zones after loading
+     */
+    bool m_skipZoneFillsOnLoad;
+
+    /**
+     * Reuse the zone fills stored in the zone fill cache of the board folder
+     */
+    bool m_zoneFillCache;
+
+    /**
+     * Record the profiled scopes (see PROF_TRACE) and write them as a Chrome trace on exit
+     */
+    bool m_enableProfiling;
+
 
 private:
     ADVANCED_CFG();
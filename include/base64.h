@@ -34,7 +34,13 @@ namespace base64
 
     void encode( const std::vector<uint8_t>& aInput, std::vector<uint8_t>& aOutput );
 
-    void decode( const std::vector<uint8_t>& aInput, std::vector<uint8_t>& aOutput );
+    /**
+     * Decodes \a aInput, encoded by encode() (without padding), and appends the result
+     * to \a aOutput.
+     * @return false if \a aInput holds a character out of the base64 alphabet, or has
+     * an invalid length.
+     */
+    bool decode( const std::vector<uint8_t>& aInput, std::vector<uint8_t>& aOutput );
 }
 
 
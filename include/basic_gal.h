@@ -25,6 +25,8 @@
 #ifndef BASIC_GAL_H
 #define BASIC_GAL_H
 
+#include <mutex>
+
 #include <eda_rect.h>
 
 #include <gal/stroke_font.h>
@@ -167,4 +169,8 @@ private:
 
 extern BASIC_GAL basic_gal;
 
+/// Serializes the use of basic_gal, which is shared by all the threads drawing, plotting
+/// or converting texts.  Held for the whole setup and stroking of a text.
+extern std::mutex basic_gal_mutex;
+
 #endif      // define BASIC_GAL_H
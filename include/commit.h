@@ -43,7 +43,19 @@ enum CHANGE_TYPE {
     ///> Flag to indicate the change is already applied,
     ///> just notify observers (not compatible with CHT_MODIFY)
     CHT_DONE    = 8,
-    CHT_FLAGS   = CHT_DONE
+
+    ///> Flag to indicate the modification only moves the item, so the undo entry
+    ///> can store the move vector instead of a copy of the item (used with CHT_MODIFY)
+    CHT_MOVE    = 16,
+
+    ///> Flags to indicate the modification only rotates or flips the item, so the undo entry
+    ///> can store the centre, and the angle or the direction, instead of a copy of the item
+    ///> (used with CHT_MODIFY)
+    CHT_ROTATE      = 32,
+    CHT_FLIP        = 64,
+
+    CHT_TRANSFORM   = CHT_MOVE | CHT_ROTATE | CHT_FLIP,
+    CHT_FLAGS   = CHT_DONE | CHT_TRANSFORM
 };
 
 template<typename T>
@@ -105,6 +117,24 @@ public:
         return Stage( aItem, CHT_MODIFY );
     }
 
+    ///> Modifies a given item in the model, when the modification only moves it. All the items
+    ///> of a commit staged this way are expected to be moved by the same vector.
+    ///> Must be called before modification is performed.
+    COMMIT& ModifyForMove( EDA_ITEM* aItem )
+    {
+        return Stage( aItem, CHT_MODIFY | CHT_MOVE );
+    }
+
+    ///> Modifies a given item in the model, when the modification only rotates it by aAngle
+    ///> (in tenths of degrees) around aCentre.
+    ///> Must be called before modification is performed.
+    COMMIT& ModifyForRotate( EDA_ITEM* aItem, const wxPoint& aCentre, double aAngle );
+
+    ///> Modifies a given item in the model, when the modification only flips it around
+    ///> aCentre, left/right if aFlipLeftRight is true, else top/bottom.
+    ///> Must be called before modification is performed.
+    COMMIT& ModifyForFlip( EDA_ITEM* aItem, const wxPoint& aCentre, bool aFlipLeftRight );
+
     ///> Creates an undo entry for an item that has been already modified. Requires a copy done
     ///> before the modification.
     COMMIT& Modified( EDA_ITEM* aItem, EDA_ITEM* aCopy )
@@ -155,13 +185,28 @@ protected:
 
         ///> Modification type
         CHANGE_TYPE m_type;
+
+        ///> Rotation or flip centre (with CHT_ROTATE or CHT_FLIP)
+        wxPoint m_transformPoint;
+
+        ///> Rotation angle (with CHT_ROTATE)
+        double m_transformAngle = 0.0;
+
+        ///> Flip direction (with CHT_FLIP)
+        bool m_flipLeftRight = false;
     };
 
+    ///> Stages a rotation or a flip, and returns the entry added for aItem (nullptr if
+    ///> aItem was already modified)
+    COMMIT_LINE* stageTransform( EDA_ITEM* aItem, CHANGE_TYPE aTransform,
+                                 const wxPoint& aCentre );
+
     // Should be called in Push() & Revert() methods
     void clear()
     {
         m_changedItems.clear();
         m_changes.clear();
+        m_hasTransforms = false;
     }
 
     COMMIT& createModified( EDA_ITEM* aItem, EDA_ITEM* aCopy, int aExtraFlags = 0 );
@@ -180,6 +225,9 @@ protected:
 
     std::set<EDA_ITEM*> m_changedItems;
     std::vector<COMMIT_LINE> m_changes;
+
+    ///> True if some changes are staged with one of the CHT_TRANSFORM flags
+    bool m_hasTransforms;
 };
 
 #endif
@@ -107,7 +107,7 @@ public:
 
     void Clear() { clear(); }
 
-    const wxString& GetValue() { return m_field; }
+    const wxString& GetValue() const { return m_field; }
 
     void SetField( const wxString& aField, bool aUseUTF8, bool aEscapeString )
     {
@@ -116,10 +116,16 @@ public:
         m_escapeString = aEscapeString;
     }
 
-    bool IsEmpty() { return m_field.IsEmpty(); }
+    bool IsEmpty() const { return m_field.IsEmpty(); }
 
     std::string GetGerberString();
 
+    bool operator==( const GBR_DATA_FIELD& aOther ) const
+    {
+        return m_field == aOther.m_field && m_useUTF8 == aOther.m_useUTF8
+               && m_escapeString == aOther.m_escapeString;
+    }
+
 
 private:
     wxString m_field;       ///< the unicade text to print in Gbr file
@@ -182,6 +188,17 @@ public:
     {
     }
 
+    /** Compare all the attributes, to know if the metadata of an item has changed
+     */
+    bool operator==( const GBR_NETLIST_METADATA& aOther ) const
+    {
+        return m_NetAttribType == aOther.m_NetAttribType && m_NotInNet == aOther.m_NotInNet
+               && m_Padname == aOther.m_Padname && m_PadPinFunction == aOther.m_PadPinFunction
+               && m_Cmpref == aOther.m_Cmpref && m_Netname == aOther.m_Netname
+               && m_ExtraData == aOther.m_ExtraData
+               && m_TryKeepPreviousAttributes == aOther.m_TryKeepPreviousAttributes;
+    }
+
     /** Clear the extra data string printed at end of net attributes
      */
     void ClearExtraData()
@@ -32,6 +32,8 @@
 #ifndef PLOT_COMMON_H_
 #define PLOT_COMMON_H_
 
+#include <map>
+#include <tuple>
 #include <vector>
 #include <math/box2.h>
 #include <gr_text.h>
@@ -563,6 +565,16 @@ protected:
 
     double GetDashGapLenIU() const;
 
+    /**
+     * Open a file with a large output buffer.  Plot files are written in many small
+     * pieces (one or more for each vertex), which the default stdio buffer flushes far
+     * too often on large boards.
+     * @param aFullFilename = the full file name of the file to open
+     * @param aMode = the fopen mode
+     * @return the opened file, or NULL if it cannot be opened
+     */
+    static FILE* openPlotFile( const wxString& aFullFilename, const wxChar* aMode );
+
 protected:      // variables used in most of plotters:
     /// Plot scale - chosen by the user (even implicitly with 'fit in a4')
     double        plotScale;
@@ -1384,6 +1396,10 @@ protected:
     std::vector<APERTURE> m_apertures;  // The list of available apertures
     int m_currentApertureIdx;   // The index of the current aperture in m_apertures
 
+    // The index in m_apertures of each aperture, by type, size and attribute, to find
+    // an existing aperture without scanning the whole list
+    std::map<std::tuple<int, int, int, int>, int> m_apertureIndex;
+
     bool     m_gerberUnitInch;  // true if the gerber units are inches, false for mm
     int      m_gerberUnitFmt;   // number of digits in mantissa.
                                 // usually 6 in Inches and 5 or 6  in mm
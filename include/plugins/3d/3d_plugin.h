@@ -131,4 +131,13 @@ KICAD_PLUGIN_EXPORT bool CanRender( void );
  */
 KICAD_PLUGIN_EXPORT SCENEGRAPH* Load( char const* aFileName );
 
+/**
+ * Function CanLoadConcurrently
+ * is optional; plugins which do not export it are never called
+ * while another model is being loaded
+ *
+ * @return true if Load() may be called from several threads at once
+ */
+KICAD_PLUGIN_EXPORT bool CanLoadConcurrently( void );
+
 #endif  // PLUGIN_3D_H
@@ -32,10 +32,13 @@
 #define TPROFILE_H
 
 #include <chrono>
+#include <cstdint>
 #include <string>
 #include <iostream>
 #include <iomanip>
 
+#include <wx/string.h>
+
 /**
  * The class PROF_COUNTER is a small class to help profiling.
  * It allows the calculation of the elapsed time (in milliseconds) between
@@ -198,6 +201,99 @@ private:
 };
 
 
+/**
+ * PROF_TRACE
+ * is the registry of the profiled scopes (see PROF_SCOPE).  Unlike the PROF_COUNTERs used
+ * under \#ifdef PROFILE, it is always compiled in, and enabled by the EnableProfiling
+ * advanced setting, so a session can be profiled without rebuilding KiCad.  When it is not
+ * enabled, a PROF_SCOPE costs only a test.
+ *
+ * Each thread records its scopes in its own buffer, used as a ring: only the last
+ * MaxEventsPerThread scopes of each thread are kept.  WriteChromeTrace() writes them in the
+ * Chrome trace event format, which can be opened in chrome://tracing or in Perfetto.
+ */
+class PROF_TRACE
+{
+public:
+    ///> The value of the scopes recorded without argument
+    static const int64_t NoArg = INT64_MIN;
+
+    static const size_t MaxEventsPerThread = 65536;
+
+    struct EVENT
+    {
+        const char* m_name;         ///< a static string: only the pointer is recorded
+        int64_t     m_arg;          ///< e.g. the net code for the per net scopes, or NoArg
+        uint64_t    m_start;        ///< in ns since the creation of the registry
+        uint64_t    m_duration;     ///< in ns
+        unsigned    m_thread;       ///< a serial number of the thread
+    };
+
+    using CLOCK = std::chrono::steady_clock;
+
+    /**
+     * Function IsEnabled
+     * @return the EnableProfiling advanced setting, read at the first call.
+     */
+    static bool IsEnabled();
+
+    /**
+     * Function Record
+     * adds a scope named \a aName, from \a aStart to \a aEnd, to the buffer of the
+     * calling thread.
+     */
+    static void Record( const char* aName, int64_t aArg, CLOCK::time_point aStart,
+                        CLOCK::time_point aEnd );
+
+    /**
+     * Function WriteChromeTrace
+     * writes the scopes recorded by all the threads to \a aFileName, as a Chrome trace event
+     * JSON file.
+     * @throw IO_ERROR on write error.
+     */
+    static void WriteChromeTrace( const wxString& aFileName );
+};
+
+
+/**
+ * A RAII class recording the time of a scope in the PROF_TRACE registry, when it is enabled.
+ *
+ * For example:
+ *
+ * for( ZONE_CONTAINER* zone : zones )
+ * {
+ *     PROF_SCOPE scope( "zone-fill-zone", zone->GetNetCode() );
+ *     ...
+ * }
+ *
+ * The name must be a static string (usually a literal): only its address is recorded.
+ */
+class PROF_SCOPE
+{
+public:
+    PROF_SCOPE( const char* aName, int64_t aArg = PROF_TRACE::NoArg ) :
+            m_name( aName ),
+            m_arg( aArg ),
+            m_enabled( PROF_TRACE::IsEnabled() )
+    {
+        if( m_enabled )
+            m_start = PROF_TRACE::CLOCK::now();
+    }
+
+    ~PROF_SCOPE()
+    {
+        if( m_enabled )
+            PROF_TRACE::Record( m_name, m_arg, m_start, PROF_TRACE::CLOCK::now() );
+    }
+
+private:
+    const char*                   m_name;
+    int64_t                       m_arg;
+    bool                          m_enabled;
+    PROF_TRACE::CLOCK::time_point m_start;
+};
+
+
 /**
  * Function GetRunningMicroSecs
  * An alternate way to calculate an elapset time (in microsecondes) to class PROF_COUNTER
@@ -396,6 +396,18 @@ public:
      */
     int PRINTF_FUNC Print( int nestLevel, const char* fmt, ... );
 
+    /**
+     * Function Write
+     * writes \a aText as is, without any formatting.  It is faster than Print() for text
+     * which is already formatted, e.g. by another STRING_FORMATTER.
+     *
+     * @throw IO_ERROR, if there is a problem outputting, such as a full disk.
+     */
+    void Write( const std::string& aText )
+    {
+        write( aText.c_str(), (int) aText.size() );
+    }
+
     /**
      * Function GetQuoteChar
      * performs quote character need determination.
@@ -37,6 +37,7 @@
 #include <libcontext.h>
 #include <memory>
 #include <advanced_config.h>
+#include <tool/coroutine_stack_pool.h>
 
 /**
  *  Class COROUNTINE.
@@ -161,6 +162,7 @@ public:
 #ifdef KICAD_USE_VALGRIND
         VALGRIND_STACK_DEREGISTER( valgrind_stack );
 #endif
+        COROUTINE_STACK_POOL::Instance().Release( m_stack );
     }
 
 public:
@@ -298,23 +300,23 @@ private:
 
         m_args = &aArgs;
 
-        assert( m_stack == nullptr );
+        assert( m_stack.m_mapping == nullptr );
 
         size_t stackSize = m_stacksize;
         void* sp = nullptr;
 
         #ifndef LIBCONTEXT_HAS_OWN_STACK
-        // fixme: Clean up stack stuff. Add a guard
-        m_stack.reset( new char[stackSize] );
+        // the stack comes from the pool, with a guard page below it
+        m_stack = COROUTINE_STACK_POOL::Instance().Acquire( stackSize );
 
-        // align to 16 bytes
-        sp = (void*)((((ptrdiff_t) m_stack.get()) + stackSize - 0xf) & (~0x0f));
+        // the stack grows down from its top, aligned to 16 bytes
+        sp = (void*)( ( (ptrdiff_t) m_stack.m_bottom + m_stack.m_size ) & ( ~0x0f ) );
 
         // correct the stack size
-        stackSize -= size_t( ( (ptrdiff_t) m_stack.get() + stackSize ) - (ptrdiff_t) sp );
+        stackSize = size_t( (ptrdiff_t) sp - (ptrdiff_t) m_stack.m_bottom );
 
 #ifdef KICAD_USE_VALGRIND
-        valgrind_stack = VALGRIND_STACK_REGISTER( sp, m_stack.get() );
+        valgrind_stack = VALGRIND_STACK_REGISTER( sp, m_stack.m_bottom );
 #endif
         #endif
 
@@ -376,8 +378,8 @@ private:
         }
     }
 
-    ///< coroutine stack
-    std::unique_ptr<char[]> m_stack;
+    ///< coroutine stack, taken from COROUTINE_STACK_POOL
+    COROUTINE_STACK_POOL::STACK m_stack;
 
     int m_stacksize;
 
@@ -0,0 +1,101 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef COROUTINE_STACK_POOL_H
+#define COROUTINE_STACK_POOL_H
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+
+/**
+ * COROUTINE_STACK_POOL
+ * provides the stacks of the coroutines.
+ *
+ * Each tool invocation runs in a new coroutine.  When a coroutine is done, its stack goes
+ * back to the pool and the next coroutine reuses it, so invoking a tool does not allocate
+ * a new stack.  Each stack is mapped with a guard page at its low end, where the stack
+ * grows to.  A stack overflow then crashes immediately instead of corrupting other memory.
+ */
+class COROUTINE_STACK_POOL
+{
+public:
+    struct STACK
+    {
+        STACK() :
+            m_mapping( nullptr ),
+            m_mappingSize( 0 ),
+            m_bottom( nullptr ),
+            m_size( 0 )
+        {
+        }
+
+        void*  m_mapping;       ///< the whole mapping, guard page included
+        size_t m_mappingSize;
+        char*  m_bottom;        ///< the lowest usable address of the stack
+        size_t m_size;          ///< the usable size of the stack
+    };
+
+    ///> Returns the pool shared by all the coroutines
+    static COROUTINE_STACK_POOL& Instance();
+
+    ~COROUTINE_STACK_POOL();
+
+    /**
+     * Function Acquire
+     * @return a stack of at least \a aSize bytes, reused from the pool when possible.
+     * @throw std::bad_alloc if the stack cannot be mapped.
+     */
+    STACK Acquire( size_t aSize );
+
+    /**
+     * Function Release
+     * gives back a stack obtained from Acquire().  It is kept for the next coroutines, or
+     * unmapped if the pool is already full.
+     */
+    void Release( const STACK& aStack );
+
+    ///> Number of stacks mapped since the start (the ones not reused from the pool)
+    size_t GetMappedCount() const { return m_mappedCount; }
+
+    ///> Number of stacks currently waiting in the pool
+    size_t GetFreeCount() const;
+
+private:
+    COROUTINE_STACK_POOL();
+
+    static size_t pageSize();
+
+    STACK map( size_t aSize );
+    void unmap( const STACK& aStack );
+
+    ///> Stacks kept for reuse.  Nested tools rarely go deeper than a few coroutines.
+    static const size_t MaxFreeStacks = 16;
+
+    mutable std::mutex m_lock;
+    std::vector<STACK> m_free;
+    size_t             m_mappedCount;
+};
+
+#endif  // COROUTINE_STACK_POOL_H
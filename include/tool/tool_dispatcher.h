@@ -98,6 +98,9 @@ private:
     ///> Handles mouse related events (click, motion, dragging).
     bool handleMouseButton( wxEvent& aEvent, int aIndex, bool aMotion );
 
+    ///> Sends the waiting mouse motion event (if any) to the tool manager.
+    void dispatchPendingMotion();
+
     ///> Saves the state of key modifiers (Alt, Ctrl and so on).
     static int decodeModifiers( const wxKeyboardState* aState )
     {
@@ -121,6 +124,10 @@ private:
     ///> The last mouse cursor position (in world coordinates).
     VECTOR2D m_lastMousePos;
 
+    ///> The last mouse motion event, waiting to be dispatched.  The motion events are
+    ///> coalesced: when several ones arrive before the dispatch, only the last one is sent.
+    OPT<TOOL_EVENT> m_pendingMotion;
+
     ///> State of mouse buttons.
     std::vector<BUTTON_STATE*> m_buttons;
 
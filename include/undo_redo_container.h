@@ -129,6 +129,9 @@ public:
                                    * UR_UNSPECIFIED */
     wxPoint m_TransformPoint;     /* used to undo redo command by the same command: usually
                                    * need to know the rotate point or the move vector */
+    double m_TransformAngle;      /* the angle of UR_ROTATED and UR_ROTATED_CLOCKWISE commands,
+                                   * in tenths of degrees */
+    bool m_TransformFlipLeftRight; /* the direction of UR_FLIPPED commands */
 
 private:
     std::vector <ITEM_PICKER> m_ItemsList;
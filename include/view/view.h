@@ -107,6 +107,17 @@ public:
      */
     virtual int Query( const BOX2I& aRect, std::vector<LAYER_ITEM_PAIR>& aResult ) const;
 
+    /**
+     * Function QueryItems()
+     * Finds all the items whose bounding box touches the rectangle aRect.  Unlike Query(),
+     * hidden items and the items of hidden and display-only layers are found too, and an item
+     * found on several layers is returned once, so the view can be used as a spatial index of
+     * the items it holds.
+     * @param aRect area to search for items
+     * @param aResult the found items, in no particular order.
+     */
+    void QueryItems( const BOX2I& aRect, std::vector<VIEW_ITEM*>& aResult ) const;
+
     /**
      * Sets the item visibility.
      *
@@ -60,12 +60,17 @@ COMMIT& BOARD_COMMIT::Stage( EDA_ITEM* aItem, CHANGE_TYPE aChangeType )
 {
     // if aItem belongs a footprint, the full footprint will be saved
     // because undo/redo does not handle "sub items" modifications
-    if( aItem && aItem->Type() != PCB_MODULE_T && aChangeType == CHT_MODIFY )
+    if( aItem && aItem->Type() != PCB_MODULE_T && ( aChangeType & CHT_TYPE ) == CHT_MODIFY )
     {
         EDA_ITEM* item = aItem->GetParent();
 
         if( item && item->Type() == PCB_MODULE_T )  // means aItem belongs a footprint
+        {
             aItem = item;
+
+            // moving a sub item is not moving the footprint
+            aChangeType = CHT_MODIFY;
+        }
     }
 
     return COMMIT::Stage( aItem, aChangeType );
@@ -92,6 +97,9 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry, bool a
     std::set<EDA_ITEM*> savedModules;
     SELECTION_TOOL*     selTool = m_toolMgr->GetTool<SELECTION_TOOL>();
     bool                itemsDeselected = false;
+    int                 transform = 0;  // the CHT_TRANSFORM flag of the undo entry, if any
+    wxPoint             transformPoint; // its move vector, or rotation or flip centre
+                                        // (the angle and direction are kept in undoList)
 
     if( Empty() )
         return;
@@ -249,12 +257,61 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry, bool a
 
             case CHT_MODIFY:
             {
+                bool storeCopy = aCreateUndoEntry;
+
                 if( !m_editModules && aCreateUndoEntry )
                 {
-                    ITEM_PICKER itemWrapper( boardItem, UR_CHANGED );
                     wxASSERT( ent.m_copy );
-                    itemWrapper.SetLink( ent.m_copy );
-                    undoList.PushItem( itemWrapper );
+
+                    // A moved, rotated or flipped item is undone by moving, rotating or flipping
+                    // it back, without keeping a copy of it.  The undo list has only one move
+                    // vector, or centre and angle or direction: the other transforms keep
+                    // their copy.
+                    int itemTransform = changeFlags & CHT_TRANSFORM;
+
+                    if( itemTransform )
+                    {
+                        wxPoint point = ent.m_transformPoint;
+
+                        if( itemTransform == CHT_MOVE )
+                        {
+                            BOARD_ITEM* copy = static_cast<BOARD_ITEM*>( ent.m_copy );
+                            point = boardItem->GetPosition() - copy->GetPosition();
+                        }
+
+                        if( !transform )
+                        {
+                            transform = itemTransform;
+                            transformPoint = point;
+                            undoList.m_TransformAngle = ent.m_transformAngle;
+                            undoList.m_TransformFlipLeftRight = ent.m_flipLeftRight;
+                        }
+
+                        if( itemTransform == transform && point == transformPoint
+                                && ent.m_transformAngle == undoList.m_TransformAngle
+                                && ent.m_flipLeftRight == undoList.m_TransformFlipLeftRight )
+                        {
+                            storeCopy = false;
+                        }
+                    }
+
+                    if( storeCopy )
+                    {
+                        ITEM_PICKER itemWrapper( boardItem, UR_CHANGED );
+                        itemWrapper.SetLink( ent.m_copy );
+                        undoList.PushItem( itemWrapper );
+                    }
+                    else
+                    {
+                        UNDO_REDO_T undoType = UR_MOVED;
+
+                        if( transform == CHT_ROTATE )
+                            undoType = UR_ROTATED;
+                        else if( transform == CHT_FLIP )
+                            undoType = UR_FLIPPED;
+
+                        undoList.PushItem( ITEM_PICKER( boardItem, undoType ) );
+                    }
                 }
 
                 if( ent.m_copy )
@@ -263,9 +320,12 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry, bool a
                 connectivity->Update( boardItem );
                 view->Update( boardItem );
 
-                // if no undo entry is needed, the copy would create a memory leak
-                if( !aCreateUndoEntry )
+                // if no undo entry needs the copy, it would create a memory leak
+                if( !storeCopy )
+                {
                     delete ent.m_copy;
+                    ent.m_copy = nullptr;
+                }
 
                 break;
             }
@@ -313,7 +373,7 @@ void BOARD_COMMIT::Push( const wxString& aMessage, bool aCreateUndoEntry, bool a
     }
 
     if( !m_editModules && aCreateUndoEntry )
-        frame->SaveCopyInUndoList( undoList, UR_UNSPECIFIED );
+        frame->SaveCopyInUndoList( undoList, UR_UNSPECIFIED, transformPoint );
 
     m_toolMgr->PostEvent( { TC_MESSAGE, TA_MODEL_CHANGE, AS_GLOBAL } );
 
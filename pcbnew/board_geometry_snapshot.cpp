@@ -0,0 +1,106 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <board_geometry_snapshot.h>
+
+#include <algorithm>
+
+#include <class_board.h>
+#include <class_module.h>
+#include <class_pad.h>
+#include <class_track.h>
+
+
+BOARD_GEOMETRY_SNAPSHOT::BOARD_GEOMETRY_SNAPSHOT( const BOARD* aBoard )
+{
+    m_tracks.reserve( aBoard->Tracks().size() );
+
+    for( const TRACK* track : aBoard->Tracks() )
+        m_tracks.push_back( makeEntry( track ) );
+
+    for( const MODULE* module : aBoard->Modules() )
+    {
+        for( const D_PAD* pad : module->Pads() )
+            m_pads.push_back( makeEntry( pad ) );
+    }
+}
+
+
+BOARD_GEOMETRY_SNAPSHOT::BOX BOARD_GEOMETRY_SNAPSHOT::TrackBox( const TRACK* aTrack )
+{
+    // end of track is round, this is its radius, rounded up
+    int            radius = ( aTrack->GetWidth() + 1 ) / 2;
+    const wxPoint& start = aTrack->GetStart();
+    const wxPoint& end = aTrack->GetEnd();
+    BOX            box;
+
+    box.m_xmin = std::min( start.x, end.x ) - radius;
+    box.m_ymin = std::min( start.y, end.y ) - radius;
+    box.m_xmax = std::max( start.x, end.x ) + radius;
+    box.m_ymax = std::max( start.y, end.y ) + radius;
+
+    return box;
+}
+
+
+BOARD_GEOMETRY_SNAPSHOT::ENTRY BOARD_GEOMETRY_SNAPSHOT::makeEntry( const TRACK* aTrack )
+{
+    ENTRY entry;
+
+    entry.m_bbox = TrackBox( aTrack );
+    entry.m_layers = aTrack->GetLayerSet();
+    entry.m_netCode = aTrack->GetNetCode();
+    entry.m_clearance = aTrack->GetClearance();
+
+    return entry;
+}
+
+
+BOARD_GEOMETRY_SNAPSHOT::ENTRY BOARD_GEOMETRY_SNAPSHOT::makeEntry( const D_PAD* aPad )
+{
+    ENTRY entry;
+
+    // GetBoundingRadius() covers any pad shape, custom shapes included (+1 for its rounding)
+    wxPoint shapePos = aPad->ShapePos();
+    int     radius = aPad->GetBoundingRadius() + 1;
+
+    entry.m_bbox.m_xmin = shapePos.x - radius;
+    entry.m_bbox.m_ymin = shapePos.y - radius;
+    entry.m_bbox.m_xmax = shapePos.x + radius;
+    entry.m_bbox.m_ymax = shapePos.y + radius;
+
+    // The hole is centered on the pad position, not on the shape (which can have an offset)
+    wxPoint pos = aPad->GetPosition();
+    int     holeRadius = ( std::max( aPad->GetDrillSize().x, aPad->GetDrillSize().y ) + 1 ) / 2;
+
+    entry.m_bbox.m_xmin = std::min( entry.m_bbox.m_xmin, pos.x - holeRadius );
+    entry.m_bbox.m_ymin = std::min( entry.m_bbox.m_ymin, pos.y - holeRadius );
+    entry.m_bbox.m_xmax = std::max( entry.m_bbox.m_xmax, pos.x + holeRadius );
+    entry.m_bbox.m_ymax = std::max( entry.m_bbox.m_ymax, pos.y + holeRadius );
+
+    entry.m_layers = aPad->GetLayerSet();
+    entry.m_netCode = aPad->GetNetCode();
+    entry.m_clearance = aPad->GetClearance();
+
+    return entry;
+}
@@ -0,0 +1,94 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef BOARD_GEOMETRY_SNAPSHOT_H
+#define BOARD_GEOMETRY_SNAPSHOT_H
+
+#include <vector>
+
+#include <layers_id_colors_and_visibility.h>
+
+class BOARD;
+class TRACK;
+class D_PAD;
+
+
+/**
+ * BOARD_GEOMETRY_SNAPSHOT
+ * is a compact copy of what the clearance tests need to know about the tracks and the pads
+ * of a board: their bounding box, layers, net and clearance.
+ *
+ * The entries are stored next to each other, in the order of BOARD::Tracks() and of the pads
+ * of BOARD::Modules(), so going through them reads memory sequentially instead of following
+ * a pointer to each item, and the clearances, computed from the net classes, are computed
+ * only once per item.  The tests use it to skip quickly the items that are too far away,
+ * before looking at the items themselves.
+ *
+ * It is a copy: it must be built again when the board is modified.
+ */
+class BOARD_GEOMETRY_SNAPSHOT
+{
+public:
+    ///> A bounding box, faster to compare than a BOX2I or an EDA_RECT (always normalized)
+    struct BOX
+    {
+        int m_xmin;
+        int m_ymin;
+        int m_xmax;
+        int m_ymax;
+
+        bool Intersects( const BOX& aOther ) const
+        {
+            return m_xmin <= aOther.m_xmax && aOther.m_xmin <= m_xmax
+                && m_ymin <= aOther.m_ymax && aOther.m_ymin <= m_ymax;
+        }
+    };
+
+    struct ENTRY
+    {
+        BOX  m_bbox;        ///< the bounding box of the copper, and of the hole of pads
+        LSET m_layers;
+        int  m_netCode;
+        int  m_clearance;   ///< GetClearance() of the item
+    };
+
+    BOARD_GEOMETRY_SNAPSHOT( const BOARD* aBoard );
+
+    ///> One entry per track, via and arc, in the order of BOARD::Tracks()
+    const std::vector<ENTRY>& Tracks() const { return m_tracks; }
+
+    ///> One entry per pad, in the order of the pads of the footprints of BOARD::Modules()
+    const std::vector<ENTRY>& Pads() const { return m_pads; }
+
+    ///> Returns the box covering a track with its width
+    static BOX TrackBox( const TRACK* aTrack );
+
+private:
+    static ENTRY makeEntry( const TRACK* aTrack );
+    static ENTRY makeEntry( const D_PAD* aPad );
+
+    std::vector<ENTRY> m_tracks;
+    std::vector<ENTRY> m_pads;
+};
+
+#endif  // BOARD_GEOMETRY_SNAPSHOT_H
@@ -51,7 +51,6 @@ struct TSEGM_2_POLY_PRMS {
     int m_error;
     SHAPE_POLY_SET* m_cornerBuffer;
 };
-TSEGM_2_POLY_PRMS prms;
 
 // This is a call back function, used by GRText to draw the 3D text shape:
 static void addTextSegmToPoly( int x0, int y0, int xf, int yf, void* aData )
@@ -227,6 +226,7 @@ void MODULE::TransformGraphicShapesWithClearanceToPolygonSet( PCB_LAYER_ID aLaye
     if( Value().GetLayer() == aLayer && Value().IsVisible() )
         texts.push_back( &Value() );
 
+    TSEGM_2_POLY_PRMS prms;
     prms.m_cornerBuffer = &aCornerBuffer;
 
     for( TEXTE_MODULE* textmod : texts )
@@ -283,6 +283,7 @@ void MODULE::TransformGraphicTextWithClearanceToPolygonSet( PCB_LAYER_ID aLayer,
     if( Value().GetLayer() == aLayer && Value().IsVisible() )
         texts.push_back( &Value() );
 
+    TSEGM_2_POLY_PRMS prms;
     prms.m_cornerBuffer = &aCornerBuffer;
 
     for( TEXTE_MODULE* textmod : texts )
@@ -310,7 +311,7 @@ void ZONE_CONTAINER::TransformSolidAreasShapesToPolygonSet( SHAPE_POLY_SET& aCor
         return;
 
     // add filled areas polygons
-    aCornerBuffer.Append( m_FilledPolysList );
+    aCornerBuffer.Append( *m_FilledPolysList );
     auto board = GetBoard();
     int maxError = ARC_HIGH_DEF;
 
@@ -318,9 +319,9 @@ void ZONE_CONTAINER::TransformSolidAreasShapesToPolygonSet( SHAPE_POLY_SET& aCor
         maxError = board->GetDesignSettings().m_MaxError;
 
     // add filled areas outlines, which are drawn with thick lines
-    for( int i = 0; i < m_FilledPolysList.OutlineCount(); i++ )
+    for( int i = 0; i < m_FilledPolysList->OutlineCount(); i++ )
     {
-        const SHAPE_LINE_CHAIN& path = m_FilledPolysList.COutline( i );
+        const SHAPE_LINE_CHAIN& path = m_FilledPolysList->COutline( i );
 
         for( int j = 0; j < path.PointCount(); j++ )
         {
@@ -379,6 +380,7 @@ void TEXTE_PCB::TransformShapeWithClearanceToPolygonSet( SHAPE_POLY_SET& aCorner
     if( IsMirrored() )
         size.x = -size.x;
 
+    TSEGM_2_POLY_PRMS prms;
     prms.m_cornerBuffer = &aCornerBuffer;
     prms.m_textWidth = GetThickness() + ( 2 * aClearanceValue );
     prms.m_error = aError;
@@ -767,6 +769,6 @@ void ZONE_CONTAINER::TransformShapeWithClearanceToPolygon( SHAPE_POLY_SET& aCorn
 {
     wxASSERT_MSG( !ignoreLineWidth, "IgnoreLineWidth has no meaning for zones." );
 
-    aCornerBuffer = m_FilledPolysList;
+    aCornerBuffer = *m_FilledPolysList;
     aCornerBuffer.Simplify( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
 }
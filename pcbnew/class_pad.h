@@ -37,6 +37,7 @@
 #include <geometry/shape_poly_set.h>
 #include <pad_shapes.h>
 #include <pcbnew.h>
+#include <slab_allocator.h>
 
 class DRAWSEGMENT;
 class PARAM_CFG;
@@ -146,6 +147,9 @@ public:
 public:
     D_PAD( MODULE* parent );
 
+    // Boards have tens of thousands of pads: allocate them from slabs
+    DECLARE_SLAB_ALLOCATED
+
     // Do not create a copy constructor & operator=.
     // The ones generated by the compiler are adequate.
 
@@ -563,7 +567,18 @@ public:
      *                        inflate, < 0 deflate
      * @param aRotation = full rotation of the polygon
      */
-    void BuildPadPolygon( wxPoint aCoord[4], wxSize aInflateValue, double aRotation ) const;
+    void BuildPadPolygon( wxPoint aCoord[4], wxSize aInflateValue, double aRotation ) const
+    {
+        BuildPadPolygon( aCoord, aInflateValue, aRotation, m_Size, m_DeltaSize );
+    }
+
+    /**
+     * Function BuildPadPolygon
+     * Same as above, for a pad of size \a aSize and delta \a aDelta instead of its own
+     * (e.g. to plot it with another size without modifying it)
+     */
+    void BuildPadPolygon( wxPoint aCoord[4], wxSize aInflateValue, double aRotation,
+                          const wxSize& aSize, const wxSize& aDelta ) const;
 
     /**
      * Function GetRoundRectCornerRadius
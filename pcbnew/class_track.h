@@ -40,6 +40,7 @@
 #include <geometry/seg.h>
 #include <geometry/shape_arc.h>
 
+#include <slab_allocator.h>
 #include <trigo.h>
 
 
@@ -86,6 +87,9 @@ public:
 
     TRACK( BOARD_ITEM* aParent, KICAD_T idtype = PCB_TRACE_T );
 
+    // Boards have hundreds of thousands of tracks and vias: allocate them from slabs
+    DECLARE_SLAB_ALLOCATED
+
     // Do not create a copy constructor.  The one generated by the compiler is adequate.
 
     void Move( const wxPoint& aMoveVector ) override
@@ -48,6 +48,8 @@
 
 ZONE_CONTAINER::ZONE_CONTAINER( BOARD_ITEM_CONTAINER* aParent, bool aInModule )
         : BOARD_CONNECTED_ITEM( aParent, aInModule ? PCB_MODULE_ZONE_AREA_T : PCB_ZONE_AREA_T ),
+          m_FillSegmList( std::make_shared<ZONE_SEGMENT_FILL>() ),
+          m_FilledPolysList( std::make_shared<SHAPE_POLY_SET>() ),
           m_area( 0.0 )
 {
     m_CornerSelection = nullptr;                // no corner is selected
@@ -105,9 +107,7 @@ ZONE_CONTAINER& ZONE_CONTAINER::operator=( const ZONE_CONTAINER& aOther )
     SetHatchStyle( aOther.GetHatchStyle() );
     SetHatchPitch( aOther.GetHatchPitch() );
     m_HatchLines = aOther.m_HatchLines;     // copy vector <SEG>
-    m_FilledPolysList.RemoveAllContours();
-    m_FilledPolysList.Append( aOther.m_FilledPolysList );
-    m_FillSegmList.clear();
+    m_FilledPolysList = aOther.m_FilledPolysList;   // shared until one of the zones changes it
     m_FillSegmList = aOther.m_FillSegmList;
 
     m_HatchFillTypeThickness = aOther.m_HatchFillTypeThickness;
@@ -151,8 +151,8 @@ void ZONE_CONTAINER::initDataFromSrcInCopyCtor( const ZONE_CONTAINER& aZone )
     m_PadConnection = aZone.m_PadConnection;
     m_ThermalReliefGap = aZone.m_ThermalReliefGap;
     m_ThermalReliefCopperBridge = aZone.m_ThermalReliefCopperBridge;
-    m_FilledPolysList.Append( aZone.m_FilledPolysList );
-    m_FillSegmList = aZone.m_FillSegmList;      // vector <> copy
+    m_FilledPolysList = aZone.m_FilledPolysList;    // shared until one of the zones changes it
+    m_FillSegmList = aZone.m_FillSegmList;
 
     m_doNotAllowCopperPour = aZone.m_doNotAllowCopperPour;
     m_doNotAllowVias = aZone.m_doNotAllowVias;
@@ -187,12 +187,30 @@ EDA_ITEM* ZONE_CONTAINER::Clone() const
 }
 
 
+SHAPE_POLY_SET& ZONE_CONTAINER::mutableFilledPolys()
+{
+    if( m_FilledPolysList.use_count() > 1 )
+        m_FilledPolysList = std::make_shared<SHAPE_POLY_SET>( *m_FilledPolysList );
+
+    return *m_FilledPolysList;
+}
+
+
+ZONE_SEGMENT_FILL& ZONE_CONTAINER::mutableFillSegments()
+{
+    if( m_FillSegmList.use_count() > 1 )
+        m_FillSegmList = std::make_shared<ZONE_SEGMENT_FILL>( *m_FillSegmList );
+
+    return *m_FillSegmList;
+}
+
+
 bool ZONE_CONTAINER::UnFill()
 {
-    bool change = ( !m_FilledPolysList.IsEmpty() || m_FillSegmList.size() > 0 );
+    bool change = ( !m_FilledPolysList->IsEmpty() || m_FillSegmList->size() > 0 );
 
-    m_FilledPolysList.RemoveAllContours();
-    m_FillSegmList.clear();
+    m_FilledPolysList = std::make_shared<SHAPE_POLY_SET>();
+    m_FillSegmList = std::make_shared<ZONE_SEGMENT_FILL>();
     m_IsFilled = false;
 
     return change;
@@ -438,7 +456,7 @@ void ZONE_CONTAINER::PrintFilledArea( PCB_BASE_FRAME* aFrame, wxDC* DC, const wx
     if( displ_opts.m_DisplayZonesMode == 1 )     // Do not show filled areas
         return;
 
-    if( m_FilledPolysList.IsEmpty() )  // Nothing to draw
+    if( m_FilledPolysList->IsEmpty() )  // Nothing to draw
         return;
 
     if( brd->IsLayerVisible( GetLayer() ) == false )
@@ -446,9 +464,9 @@ void ZONE_CONTAINER::PrintFilledArea( PCB_BASE_FRAME* aFrame, wxDC* DC, const wx
 
     color.a = 0.588;
 
-    for( int ic = 0; ic < m_FilledPolysList.OutlineCount(); ic++ )
+    for( int ic = 0; ic < m_FilledPolysList->OutlineCount(); ic++ )
     {
-        const SHAPE_LINE_CHAIN& path = m_FilledPolysList.COutline( ic );
+        const SHAPE_LINE_CHAIN& path = m_FilledPolysList->COutline( ic );
 
         CornersBuffer.clear();
 
@@ -678,7 +696,7 @@ int ZONE_CONTAINER::GetClearance( BOARD_CONNECTED_ITEM* aItem ) const
 
 bool ZONE_CONTAINER::HitTestFilledArea( const wxPoint& aRefPos ) const
 {
-    return m_FilledPolysList.Contains( VECTOR2I( aRefPos.x, aRefPos.y ) );
+    return m_FilledPolysList->Contains( VECTOR2I( aRefPos.x, aRefPos.y ) );
 }
 
 
@@ -764,9 +782,9 @@ void ZONE_CONTAINER::GetMsgPanelInfo( EDA_UNITS aUnits, std::vector<MSG_PANEL_IT
     msg.Printf( wxT( "%d" ), (int) m_HatchLines.size() );
     aList.emplace_back( MSG_PANEL_ITEM( _( "Hatch Lines" ), msg, BLUE ) );
 
-    if( !m_FilledPolysList.IsEmpty() )
+    if( !m_FilledPolysList->IsEmpty() )
     {
-        msg.Printf( wxT( "%d" ), m_FilledPolysList.TotalVertices() );
+        msg.Printf( wxT( "%d" ), m_FilledPolysList->TotalVertices() );
         aList.emplace_back( MSG_PANEL_ITEM( _( "Corner Count" ), msg, BLUE ) );
     }
 }
@@ -781,9 +799,9 @@ void ZONE_CONTAINER::Move( const wxPoint& offset )
 
     Hatch();
 
-    m_FilledPolysList.Move( offset );
+    mutableFilledPolys().Move( offset );
 
-    for( SEG& seg : m_FillSegmList )
+    for( SEG& seg : mutableFillSegments() )
     {
         seg.A += VECTOR2I( offset );
         seg.B += VECTOR2I( offset );
@@ -816,16 +834,18 @@ void ZONE_CONTAINER::Rotate( const wxPoint& centre, double angle )
     Hatch();
 
     /* rotate filled areas: */
-    m_FilledPolysList.Rotate( angle, VECTOR2I( centre ) );
+    mutableFilledPolys().Rotate( angle, VECTOR2I( centre ) );
+
+    ZONE_SEGMENT_FILL& fillSegs = mutableFillSegments();
 
-    for( unsigned ic = 0; ic < m_FillSegmList.size(); ic++ )
+    for( unsigned ic = 0; ic < fillSegs.size(); ic++ )
     {
-        wxPoint a( m_FillSegmList[ic].A );
+        wxPoint a( fillSegs[ic].A );
         RotatePoint( &a, centre, angle );
-        m_FillSegmList[ic].A = a;
-        wxPoint b( m_FillSegmList[ic].B );
+        fillSegs[ic].A = a;
+        wxPoint b( fillSegs[ic].B );
         RotatePoint( &b, centre, angle );
-        m_FillSegmList[ic].B = a;
+        fillSegs[ic].B = a;
     }
 }
 
@@ -853,9 +873,9 @@ void ZONE_CONTAINER::Mirror( const wxPoint& aMirrorRef, bool aMirrorLeftRight )
 
     Hatch();
 
-    m_FilledPolysList.Mirror( aMirrorLeftRight, !aMirrorLeftRight, VECTOR2I( aMirrorRef ) );
+    mutableFilledPolys().Mirror( aMirrorLeftRight, !aMirrorLeftRight, VECTOR2I( aMirrorRef ) );
 
-    for( SEG& seg : m_FillSegmList )
+    for( SEG& seg : mutableFillSegments() )
     {
         if( aMirrorLeftRight )
         {
@@ -1177,7 +1197,9 @@ void ZONE_CONTAINER::SwapData( BOARD_ITEM* aImage )
 
 void ZONE_CONTAINER::CacheTriangulation()
 {
-    m_FilledPolysList.CacheTriangulation();
+    // A fill shared with other copies of the zone is triangulated only once
+    if( !m_FilledPolysList->IsTriangulationUpToDate() )
+        mutableFilledPolys().CacheTriangulation();
 }
 
 
@@ -1273,13 +1295,13 @@ double ZONE_CONTAINER::CalculateFilledArea()
 
     // Iterate over each outline polygon in the zone and then iterate over
     // each hole it has to compute the total area.
-    for( int i = 0; i < m_FilledPolysList.OutlineCount(); i++ )
+    for( int i = 0; i < m_FilledPolysList->OutlineCount(); i++ )
     {
-        m_area += m_FilledPolysList.Outline( i ).Area();
+        m_area += m_FilledPolysList->Outline( i ).Area();
 
-        for( int j = 0; m_FilledPolysList.HoleCount( i ); j++ )
+        for( int j = 0; m_FilledPolysList->HoleCount( i ); j++ )
         {
-            m_area -= m_FilledPolysList.Hole( i, j ).Area();
+            m_area -= m_FilledPolysList->Hole( i, j ).Area();
         }
     }
 
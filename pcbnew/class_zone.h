@@ -30,6 +30,7 @@
 #define CLASS_ZONE_H_
 
 
+#include <memory>
 #include <vector>
 #include <gr_basic.h>
 #include <class_board_item.h>
@@ -259,8 +260,8 @@ public:
     int GetLocalFlags() const { return m_localFlgs; }
     void SetLocalFlags( int aFlags ) { m_localFlgs = aFlags; }
 
-    ZONE_SEGMENT_FILL& FillSegments() { return m_FillSegmList; }
-    const ZONE_SEGMENT_FILL& FillSegments() const { return m_FillSegmList; }
+    ZONE_SEGMENT_FILL& FillSegments() { return mutableFillSegments(); }
+    const ZONE_SEGMENT_FILL& FillSegments() const { return *m_FillSegmList; }
 
     SHAPE_POLY_SET* Outline() { return m_Poly; }
     const SHAPE_POLY_SET* Outline() const { return const_cast< SHAPE_POLY_SET* >( m_Poly ); }
@@ -560,7 +561,7 @@ public:
      */
     void ClearFilledPolysList()
     {
-        m_FilledPolysList.RemoveAllContours();
+        m_FilledPolysList = std::make_shared<SHAPE_POLY_SET>();
     }
 
    /**
@@ -570,7 +571,7 @@ public:
      */
     const SHAPE_POLY_SET& GetFilledPolysList() const
     {
-        return m_FilledPolysList;
+        return *m_FilledPolysList;
     }
 
     /** (re)create a list of triangles that "fill" the solid areas.
@@ -584,7 +585,7 @@ public:
      */
     void SetFilledPolysList( SHAPE_POLY_SET& aPolysList )
     {
-        m_FilledPolysList = aPolysList;
+        m_FilledPolysList = std::make_shared<SHAPE_POLY_SET>( aPolysList );
     }
 
     /**
@@ -629,7 +630,7 @@ public:
 
     void SetFillSegments( const ZONE_SEGMENT_FILL& aSegments )
     {
-        m_FillSegmList = aSegments;
+        m_FillSegmList = std::make_shared<ZONE_SEGMENT_FILL>( aSegments );
     }
 
     SHAPE_POLY_SET& RawPolysList()
@@ -717,7 +718,7 @@ public:
      *  in m_filledPolysHash.
      *  Used in zone filling calculations, to know if m_FilledPolysList is up to date.
      */
-    void BuildHashValue() { m_filledPolysHash = m_FilledPolysList.GetHash(); }
+    void BuildHashValue() { m_filledPolysHash = m_FilledPolysList->GetHash(); }
 
 
 
@@ -734,6 +735,13 @@ protected:
      */
     void initDataFromSrcInCopyCtor( const ZONE_CONTAINER& aZone );
 
+    /**
+     * Return the fill of the zone for a change, after making a copy of it if it is still
+     * shared with other copies of the zone.
+     */
+    SHAPE_POLY_SET& mutableFilledPolys();
+    ZONE_SEGMENT_FILL& mutableFillSegments();
+
     SHAPE_POLY_SET*       m_Poly;                ///< Outline of the zone.
     int                   m_cornerSmoothingType;
     unsigned int          m_cornerRadius;
@@ -811,7 +819,7 @@ protected:
     /** Segments used to fill the zone (#m_FillMode ==1 ), when fill zone by segment is used.
      *  In this case the segments have #m_ZoneMinThickness width.
      */
-    ZONE_SEGMENT_FILL          m_FillSegmList;
+    std::shared_ptr<ZONE_SEGMENT_FILL> m_FillSegmList;
 
     /* set of filled polygons used to draw a zone as a filled area.
      * from outlines (m_Poly) but unlike m_Poly these filled polygons have no hole
@@ -820,8 +828,12 @@ protected:
      * a polygon equivalent to m_Poly, without holes but with extra outline segment
      * connecting "holes" with external main outline.  In complex cases an outline
      * described by m_Poly can have many filled areas
+     *
+     * The fill (m_FilledPolysList and m_FillSegmList) is shared between the copies of the
+     * zone, like the ones stored in the undo list, and copied only when one of them changes
+     * it (see mutableFilledPolys()), so an edit of the zone does not duplicate its fill.
      */
-    SHAPE_POLY_SET        m_FilledPolysList;
+    std::shared_ptr<SHAPE_POLY_SET> m_FilledPolysList;
     SHAPE_POLY_SET        m_RawPolysList;
     MD5_HASH              m_filledPolysHash;    // A hash value used in zone filling calculations
                                                 // to see if the filled areas are up to date
@@ -24,6 +24,7 @@
 
 #include <collectors.h>
 #include <class_board_item.h>             // class BOARD_ITEM
+#include <class_board.h>
 
 #include <class_module.h>
 #include <class_edge_mod.h>
@@ -34,6 +35,8 @@
 #include <class_drawsegment.h>
 #include <math/util.h>      // for KiROUND
 
+#include <algorithm>
+
 
 /* This module contains out of line member functions for classes given in
  * collectors.h.  Those classes augment the functionality of class PCB_EDIT_FRAME.
@@ -533,7 +536,8 @@ exit:
 
 
 void GENERAL_COLLECTOR::Collect( BOARD_ITEM* aItem, const KICAD_T aScanList[],
-                                 const wxPoint& aRefPos, const COLLECTORS_GUIDE& aGuide )
+                                 const wxPoint& aRefPos, const COLLECTORS_GUIDE& aGuide,
+                                 const KIGFX::VIEW* aView )
 {
     Empty();        // empty the collection, primary criteria list
     Empty2nd();     // empty the collection, secondary criteria list
@@ -547,7 +551,10 @@ void GENERAL_COLLECTOR::Collect( BOARD_ITEM* aItem, const KICAD_T aScanList[],
     // the Inspect() function.
     SetRefPos( aRefPos );
 
-    aItem->Visit( m_inspector, NULL, m_ScanTypes );
+    if( aView && aItem->Type() == PCB_T )
+        inspectViewItems( static_cast<BOARD*>( aItem ), aView );
+    else
+        aItem->Visit( m_inspector, NULL, m_ScanTypes );
 
     // record the length of the primary list before concatenating on to it.
     m_PrimaryLength = m_List.size();
@@ -560,6 +567,51 @@ void GENERAL_COLLECTOR::Collect( BOARD_ITEM* aItem, const KICAD_T aScanList[],
 }
 
 
+void GENERAL_COLLECTOR::inspectViewItems( BOARD* aBoard, const KIGFX::VIEW* aView )
+{
+    // Inspect() tests zone corners at twice its 5 pixel accuracy; the other hit tests are
+    // within the view bounding boxes of the items
+    int   margin = std::max( KiROUND( 10 * m_Guide->OnePixelInIU() ), m_Threshold );
+    BOX2I area( VECTOR2I( m_RefPos ), VECTOR2I( 0, 0 ) );
+
+    area.Inflate( margin );
+
+    std::vector<KIGFX::VIEW_ITEM*>            found;
+    std::vector<std::pair<int, BOARD_ITEM*>> candidates;
+
+    aView->QueryItems( area, found );
+
+    for( KIGFX::VIEW_ITEM* viewItem : found )
+    {
+        BOARD_ITEM* item = dynamic_cast<BOARD_ITEM*>( viewItem );
+
+        // The view also holds previews, overlays, the worksheet...
+        if( !item || item->GetBoard() != aBoard )
+            continue;
+
+        for( int rank = 0; m_ScanTypes[rank] != EOT; ++rank )
+        {
+            if( item->Type() == m_ScanTypes[rank] )
+            {
+                candidates.emplace_back( rank, item );
+                break;
+            }
+        }
+    }
+
+    // Keep the priority order of the scan list, as BOARD::Visit() does
+    std::stable_sort( candidates.begin(), candidates.end(),
+            []( const std::pair<int, BOARD_ITEM*>& aLeft,
+                const std::pair<int, BOARD_ITEM*>& aRight )
+            {
+                return aLeft.first < aRight.first;
+            } );
+
+    for( const std::pair<int, BOARD_ITEM*>& candidate : candidates )
+        Inspect( candidate.second, NULL );
+}
+
+
 SEARCH_RESULT PCB_TYPE_COLLECTOR::Inspect( EDA_ITEM* testItem, void* testData )
 {
     // The Visit() function only visits the testItem if its type was in the
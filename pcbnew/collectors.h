@@ -372,9 +372,19 @@ public:
      *  collection in "m_List".
      * @param aRefPos A wxPoint to use in hit-testing.
      * @param aGuide The COLLECTORS_GUIDE to use in collecting items.
+     * @param aView If not null and aItem is a BOARD, the view showing it: only the items found
+     *  near aRefPos in the R-tree of the view are inspected, instead of visiting all the
+     *  items of the board.  The collection is ordered by aScanList.
      */
     void Collect( BOARD_ITEM* aItem, const KICAD_T aScanList[],
-                 const wxPoint& aRefPos, const COLLECTORS_GUIDE& aGuide );
+                 const wxPoint& aRefPos, const COLLECTORS_GUIDE& aGuide,
+                 const KIGFX::VIEW* aView = nullptr );
+
+private:
+    /**
+     * Inspects the items of \a aBoard found near m_RefPos in the R-tree of \a aView.
+     */
+    void inspectViewItems( BOARD* aBoard, const KIGFX::VIEW* aView );
 };
 
 
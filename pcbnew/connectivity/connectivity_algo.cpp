@@ -32,9 +32,7 @@
 #include <algorithm>
 #include <future>
 
-#ifdef PROFILE
 #include <profile.h>
-#endif
 
 
 bool CN_CONNECTIVITY_ALGO::Remove( BOARD_ITEM* aItem )
@@ -201,21 +199,18 @@ void CN_CONNECTIVITY_ALGO::searchConnections()
     printf("Search start\n");
 #endif
 
-#ifdef PROFILE
-    PROF_COUNTER garbage_collection( "garbage-collection" );
-#endif
-    std::vector<CN_ITEM*> garbage;
-    garbage.reserve( 1024 );
+    {
+        PROF_SCOPE garbageCollection( "connectivity-garbage-collection" );
+        std::vector<CN_ITEM*> garbage;
+        garbage.reserve( 1024 );
 
-    m_itemList.RemoveInvalidItems( garbage );
+        m_itemList.RemoveInvalidItems( garbage );
 
-    for( auto item : garbage )
-        delete item;
+        for( auto item : garbage )
+            delete item;
+    }
 
-#ifdef PROFILE
-    garbage_collection.Show();
-    PROF_COUNTER search_basic( "search-basic" );
-#endif
+    PROF_SCOPE searchBasic( "connectivity-search" );
 
     std::vector<CN_ITEM*> dirtyItems;
     std::copy_if( m_itemList.begin(), m_itemList.end(), std::back_inserter( dirtyItems ),
@@ -276,10 +271,6 @@ void CN_CONNECTIVITY_ALGO::searchConnections()
             m_progressReporter->KeepRefreshing();
     }
 
-#ifdef PROFILE
-        search_basic.Show();
-#endif
-
     m_itemList.ClearDirtyFlags();
 
 #ifdef CONNECTIVITY_DEBUG
@@ -408,6 +399,8 @@ const CN_CONNECTIVITY_ALGO::CLUSTERS CN_CONNECTIVITY_ALGO::SearchClusters( CLUST
 
 void CN_CONNECTIVITY_ALGO::Build( BOARD* aBoard )
 {
+    PROF_SCOPE profScope( "connectivity-build" );
+
     for( int i = 0; i<aBoard->GetAreaCount(); i++ )
     {
         auto zone = aBoard->GetArea( i );
@@ -23,16 +23,14 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
  */
 
-#ifdef PROFILE
-#include <profile.h>
-#endif
-
 #include <thread>
 #include <algorithm>
 #include <future>
+#include <map>
 
 #include <connectivity/connectivity_data.h>
 #include <connectivity/connectivity_algo.h>
+#include <profile.h>
 #include <ratsnest_data.h>
 
 CONNECTIVITY_DATA::CONNECTIVITY_DATA()
@@ -96,15 +94,16 @@ void CONNECTIVITY_DATA::Build( const std::vector<BOARD_ITEM*>& aItems )
 
 void CONNECTIVITY_DATA::updateRatsnest()
 {
-    #ifdef PROFILE
-    PROF_COUNTER rnUpdate( "update-ratsnest" );
-    #endif
-    std::vector<RN_NET*> dirty_nets;
+    PROF_SCOPE rnUpdate( "ratsnest-update" );
+    std::vector<int> dirty_nets;
 
     // Start with net 1 as net 0 is reserved for not-connected
     // Nets without nodes are also ignored
-    std::copy_if( m_nets.begin() + 1, m_nets.end(), std::back_inserter( dirty_nets ),
-            [] ( RN_NET* aNet ) { return aNet->IsDirty() && aNet->GetNodeCount() > 0; } );
+    for( int net = 1; net < (int) m_nets.size(); ++net )
+    {
+        if( m_nets[net]->IsDirty() && m_nets[net]->GetNodeCount() > 0 )
+            dirty_nets.push_back( net );
+    }
 
     // We don't want to spin up a new thread for fewer than 8 nets (overhead costs)
     size_t parallelThreadCount = std::min<size_t>( std::thread::hardware_concurrency(),
@@ -113,10 +112,13 @@ void CONNECTIVITY_DATA::updateRatsnest()
     std::atomic<size_t> nextNet( 0 );
     std::vector<std::future<size_t>> returns( parallelThreadCount );
 
-    auto update_lambda = [&nextNet, &dirty_nets]() -> size_t
+    auto update_lambda = [this, &nextNet, &dirty_nets]() -> size_t
     {
         for( size_t i = nextNet++; i < dirty_nets.size(); i = nextNet++ )
-            dirty_nets[i]->Update();
+        {
+            PROF_SCOPE rnNet( "ratsnest-net", dirty_nets[i] );
+            m_nets[dirty_nets[i]]->Update();
+        }
 
         return 1;
     };
@@ -132,10 +134,6 @@ void CONNECTIVITY_DATA::updateRatsnest()
         for( size_t ii = 0; ii < parallelThreadCount; ++ii )
             returns[ii].wait();
     }
-
-    #ifdef PROFILE
-    rnUpdate.Show();
-    #endif /* PROFILE */
 }
 
 
@@ -149,6 +147,10 @@ void CONNECTIVITY_DATA::addRatsnestCluster( const std::shared_ptr<CN_CLUSTER>& a
 
 void CONNECTIVITY_DATA::RecalculateRatsnest( BOARD_COMMIT* aCommit  )
 {
+    PROF_SCOPE profScope( "ratsnest-recalculate" );
+
+    m_dynamicRatsnestEngine.reset();
+
     m_connAlgo->PropagateNets( aCommit );
 
     int lastNet = m_connAlgo->NetCount();
@@ -242,6 +244,250 @@ void CONNECTIVITY_DATA::FindIsolatedCopperIslands( std::vector<CN_ZONE_ISOLATED_
 }
 
 
+/**
+ * The dynamic ratsnest of a set of items moved together.
+ *
+ * The moved items keep their relative positions (they are only translated, rotated or
+ * flipped), so the lines between them, which are the ratsnest of their own connectivity,
+ * always join the same anchors.  The other nodes of the board do not move at all.  Both are
+ * prepared once, when the items start moving; then each update only reads the new positions
+ * of the moved anchors and searches the nearest board node of each of their nets.
+ */
+class CONNECTIVITY_DATA::DYNAMIC_RATSNEST
+{
+public:
+    /**
+     * Prepares the ratsnest of aItems.
+     * @return false if the items have anchors which can't be followed (zones)
+     */
+    bool Prepare( CONNECTIVITY_DATA* aBoardData, const std::vector<BOARD_ITEM*>& aItems );
+
+    bool IsPreparedFor( const std::vector<BOARD_ITEM*>& aItems ) const
+    {
+        return aItems == m_items;
+    }
+
+    /**
+     * Appends the lines of the ratsnest of the items at their current position to aLines.
+     */
+    void Update( std::vector<RN_DYNAMIC_LINE>& aLines );
+
+private:
+    struct MOVED_ANCHOR
+    {
+        BOARD_CONNECTED_ITEM* m_item;
+        int                   m_index;      // index of the anchor in the anchors of the item
+        VECTOR2I              m_pos;
+    };
+
+    struct MOVED_NET
+    {
+        int                   m_netCode;
+        std::vector<int>      m_anchors;    // the moved anchors of the net
+        std::vector<VECTOR2I> m_nodes;      // the nodes of the net which don't move, by x
+    };
+
+    int addAnchor( const CN_ANCHOR_PTR& aAnchor );
+
+    static VECTOR2I anchorPosition( const MOVED_ANCHOR& aAnchor );
+
+    std::vector<BOARD_ITEM*>         m_items;
+    std::vector<MOVED_ANCHOR>        m_anchors;
+    std::map<CN_ANCHOR*, int>        m_anchorIndex;
+    std::vector<MOVED_NET>           m_nets;
+    std::vector<std::pair<int, int>> m_lines;      // lines between moved anchors
+};
+
+
+int CONNECTIVITY_DATA::DYNAMIC_RATSNEST::addAnchor( const CN_ANCHOR_PTR& aAnchor )
+{
+    auto it = m_anchorIndex.find( aAnchor.get() );
+
+    if( it != m_anchorIndex.end() )
+        return it->second;
+
+    const auto& itemAnchors = aAnchor->Item()->Anchors();
+    auto        anchorIt = std::find( itemAnchors.begin(), itemAnchors.end(), aAnchor );
+
+    MOVED_ANCHOR anchor;
+    anchor.m_item = aAnchor->Parent();
+    anchor.m_index = anchorIt - itemAnchors.begin();
+    anchor.m_pos = aAnchor->Pos();
+
+    m_anchors.push_back( anchor );
+    m_anchorIndex[ aAnchor.get() ] = m_anchors.size() - 1;
+
+    return m_anchors.size() - 1;
+}
+
+
+VECTOR2I CONNECTIVITY_DATA::DYNAMIC_RATSNEST::anchorPosition( const MOVED_ANCHOR& aAnchor )
+{
+    // The anchors of the items, as created by CN_LIST::Add()
+    switch( aAnchor.m_item->Type() )
+    {
+    case PCB_PAD_T:
+        return static_cast<D_PAD*>( aAnchor.m_item )->ShapePos();
+
+    case PCB_TRACE_T:
+    case PCB_ARC_T:
+    {
+        TRACK* track = static_cast<TRACK*>( aAnchor.m_item );
+        return aAnchor.m_index == 0 ? track->GetStart() : track->GetEnd();
+    }
+
+    case PCB_VIA_T:
+        return static_cast<VIA*>( aAnchor.m_item )->GetStart();
+
+    default:
+        return aAnchor.m_pos;
+    }
+}
+
+
+bool CONNECTIVITY_DATA::DYNAMIC_RATSNEST::Prepare( CONNECTIVITY_DATA* aBoardData,
+                                                   const std::vector<BOARD_ITEM*>& aItems )
+{
+    for( const BOARD_ITEM* item : aItems )
+    {
+        if( item->Type() == PCB_ZONE_AREA_T || item->Type() == PCB_MODULE_ZONE_AREA_T )
+            return false;
+    }
+
+    m_items = aItems;
+
+    CONNECTIVITY_DATA connData( aItems );
+    aBoardData->BlockRatsnestItems( aItems );
+
+    for( unsigned int nc = 1; nc < connData.m_nets.size(); nc++ )
+    {
+        RN_NET* dynNet = connData.m_nets[nc];
+
+        if( dynNet->GetNodeCount() == 0 || nc >= aBoardData->m_nets.size() )
+            continue;
+
+        MOVED_NET net;
+        net.m_netCode = nc;
+
+        for( const CN_ANCHOR_PTR& node : dynNet->GetNodes() )
+            net.m_anchors.push_back( addAnchor( node ) );
+
+        for( const CN_ANCHOR_PTR& node : aBoardData->m_nets[nc]->GetNodes() )
+        {
+            if( !node->GetNoLine() )
+                net.m_nodes.push_back( node->Pos() );
+        }
+
+        if( net.m_nodes.empty() )
+            continue;
+
+        std::sort( net.m_nodes.begin(), net.m_nodes.end(),
+                []( const VECTOR2I& aA, const VECTOR2I& aB )
+                {
+                    return aA.x < aB.x;
+                } );
+
+        m_nets.push_back( std::move( net ) );
+    }
+
+    for( RN_NET* net : connData.m_nets )
+    {
+        if( !net )
+            continue;
+
+        for( const CN_EDGE& edge : net->GetUnconnected() )
+        {
+            m_lines.emplace_back( addAnchor( edge.GetSourceNode() ),
+                                  addAnchor( edge.GetTargetNode() ) );
+        }
+    }
+
+    // The anchors are now held by their index
+    m_anchorIndex.clear();
+
+    return true;
+}
+
+
+void CONNECTIVITY_DATA::DYNAMIC_RATSNEST::Update( std::vector<RN_DYNAMIC_LINE>& aLines )
+{
+    for( MOVED_ANCHOR& anchor : m_anchors )
+        anchor.m_pos = anchorPosition( anchor );
+
+    for( const MOVED_NET& net : m_nets )
+    {
+        VECTOR2I::extended_type distMax = VECTOR2I::ECOORD_MAX;
+        const VECTOR2I*         nearestNode = nullptr;
+        const VECTOR2I*         nearestAnchor = nullptr;
+
+        for( int anchor : net.m_anchors )
+        {
+            const VECTOR2I& pos = m_anchors[anchor].m_pos;
+
+            // The nodes are sorted by x: search both ways from the anchor position, until
+            // the x distance alone is larger than the nearest node found
+            auto first = std::lower_bound( net.m_nodes.begin(), net.m_nodes.end(), pos,
+                    []( const VECTOR2I& aNode, const VECTOR2I& aPos )
+                    {
+                        return aNode.x < aPos.x;
+                    } );
+
+            auto test =
+                    [&]( const VECTOR2I& aNode ) -> bool
+                    {
+                        VECTOR2I::extended_type dx = (VECTOR2I::extended_type) aNode.x - pos.x;
+
+                        if( dx * dx >= distMax )
+                            return false;
+
+                        VECTOR2I::extended_type dist = ( aNode - pos ).SquaredEuclideanNorm();
+
+                        if( dist < distMax )
+                        {
+                            distMax = dist;
+                            nearestNode = &aNode;
+                            nearestAnchor = &pos;
+                        }
+
+                        return true;
+                    };
+
+            for( auto it = first; it != net.m_nodes.end(); ++it )
+            {
+                if( !test( *it ) )
+                    break;
+            }
+
+            for( auto it = first; it != net.m_nodes.begin(); --it )
+            {
+                if( !test( *( it - 1 ) ) )
+                    break;
+            }
+        }
+
+        if( nearestNode )
+        {
+            RN_DYNAMIC_LINE l;
+            l.a = *nearestNode;
+            l.b = *nearestAnchor;
+            l.netCode = net.m_netCode;
+
+            aLines.push_back( l );
+        }
+    }
+
+    for( const std::pair<int, int>& line : m_lines )
+    {
+        RN_DYNAMIC_LINE l;
+        l.a = m_anchors[line.first].m_pos;
+        l.b = m_anchors[line.second].m_pos;
+        l.netCode = 0;
+
+        aLines.push_back( l );
+    }
+}
+
+
 void CONNECTIVITY_DATA::ComputeDynamicRatsnest( const std::vector<BOARD_ITEM*>& aItems )
 {
     m_dynamicRatsnest.clear();
@@ -254,6 +500,24 @@ void CONNECTIVITY_DATA::ComputeDynamicRatsnest( const std::vector<BOARD_ITEM*>&
         return ;
     }
 
+    if( !m_dynamicRatsnestEngine || !m_dynamicRatsnestEngine->IsPreparedFor( aItems ) )
+    {
+        m_dynamicRatsnestEngine.reset( new DYNAMIC_RATSNEST );
+
+        if( !m_dynamicRatsnestEngine->Prepare( this, aItems ) )
+        {
+            m_dynamicRatsnestEngine.reset();
+            computeDynamicRatsnest( aItems );
+            return;
+        }
+    }
+
+    m_dynamicRatsnestEngine->Update( m_dynamicRatsnest );
+}
+
+
+void CONNECTIVITY_DATA::computeDynamicRatsnest( const std::vector<BOARD_ITEM*>& aItems )
+{
     CONNECTIVITY_DATA connData( aItems );
     BlockRatsnestItems( aItems );
 
@@ -305,6 +569,7 @@ void CONNECTIVITY_DATA::ComputeDynamicRatsnest( const std::vector<BOARD_ITEM*>&
 
 void CONNECTIVITY_DATA::ClearDynamicRatsnest()
 {
+    m_dynamicRatsnestEngine.reset();
     m_connAlgo->ForEachAnchor( [] ( CN_ANCHOR& anchor ) { anchor.SetNoLine( false ); } );
     HideDynamicRatsnest();
 }
@@ -345,6 +610,8 @@ unsigned int CONNECTIVITY_DATA::GetUnconnectedCount() const
 
 void CONNECTIVITY_DATA::Clear()
 {
+    m_dynamicRatsnestEngine.reset();
+
     for( auto net : m_nets )
         delete net;
 
@@ -199,6 +199,9 @@ public:
      * Function ComputeDynamicRatsnest()
      * Calculates the temporary dynamic ratsnest (i.e. the ratsnest lines that)
      * for the set of items aItems.
+     *
+     * The first call for a set of items prepares what does not change while they are moved
+     * together; the next calls for the same items only follow their new positions.
      */
     void ComputeDynamicRatsnest( const std::vector<BOARD_ITEM*>& aItems );
 
@@ -253,9 +256,18 @@ private:
     void    updateRatsnest();
     void    addRatsnestCluster( const std::shared_ptr<CN_CLUSTER>& aCluster );
 
+    ///> Computes the dynamic ratsnest of aItems from scratch
+    void    computeDynamicRatsnest( const std::vector<BOARD_ITEM*>& aItems );
+
     std::shared_ptr<CN_CONNECTIVITY_ALGO> m_connAlgo;
 
     std::vector<RN_DYNAMIC_LINE> m_dynamicRatsnest;
+
+    ///> What ComputeDynamicRatsnest() prepared for the items being moved, used by its next
+    ///> calls for the same items.  Dropped when the ratsnest is recalculated.
+    class DYNAMIC_RATSNEST;
+    std::unique_ptr<DYNAMIC_RATSNEST> m_dynamicRatsnestEngine;
+
     std::vector<RN_NET*> m_nets;
 
     PROGRESS_REPORTER* m_progressReporter;
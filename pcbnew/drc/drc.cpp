@@ -50,6 +50,7 @@
 #include <drc/drc.h>
 #include <netlist_reader/pcb_netlist.h>
 #include <math/util.h>      // for KiROUND
+#include <profile.h>
 
 #include <dialog_drc.h>
 #include <wx/progdlg.h>
@@ -340,6 +341,8 @@ int DRC::TestZoneToZoneOutline( ZONE_CONTAINER* aZone, bool aCreateMarkers )
 
 void DRC::RunTests( wxTextCtrl* aMessages )
 {
+    PROF_SCOPE profScope( "drc" );
+
     // be sure m_pcb is the current board, not a old one
     // ( the board can be reloaded )
     m_pcb = m_pcbEditorFrame->GetBoard();
@@ -624,6 +627,8 @@ bool DRC::doNetClass( const NETCLASSPTR& nc, wxString& msg )
 
 bool DRC::testNetClasses()
 {
+    PROF_SCOPE profScope( "drc-netclasses" );
+
     bool        ret = true;
 
     NETCLASSES& netclasses = m_pcb->GetDesignSettings().m_NetClasses;
@@ -647,6 +652,8 @@ bool DRC::testNetClasses()
 
 void DRC::testPad2Pad()
 {
+    PROF_SCOPE profScope( "drc-pad-to-pad" );
+
     std::vector<D_PAD*> sortedPads;
 
     m_pcb->GetSortedPadListByXthenYCoord( sortedPads );
@@ -686,6 +693,8 @@ void DRC::testPad2Pad()
 
 void DRC::testDrilledHoles()
 {
+    PROF_SCOPE profScope( "drc-drilled-holes" );
+
     int holeToHoleMin = m_pcb->GetDesignSettings().m_HoleToHoleMin;
 
     if( holeToHoleMin == 0 )    // No min setting turns testing off.
@@ -759,6 +768,8 @@ void DRC::testDrilledHoles()
 
 void DRC::testTracks( wxWindow *aActiveWindow, bool aShowProgressBar )
 {
+    PROF_SCOPE profScope( "drc-tracks" );
+
     wxProgressDialog * progressDialog = NULL;
     const int delta = 500;  // This is the number of tests between 2 calls to the
                             // progress bar
@@ -779,6 +790,9 @@ void DRC::testTracks( wxWindow *aActiveWindow, bool aShowProgressBar )
     int ii = 0;
     count = 0;
 
+    // The board is not modified during the tests: its geometry is read once for all tracks
+    BOARD_GEOMETRY_SNAPSHOT geometry( m_pcb );
+
     for( auto seg_it = m_pcb->Tracks().begin(); seg_it != m_pcb->Tracks().end(); seg_it++ )
     {
         if( ii++ > delta )
@@ -799,7 +813,8 @@ void DRC::testTracks( wxWindow *aActiveWindow, bool aShowProgressBar )
         }
 
         // Test new segment against tracks and pads, optionally against copper zones
-        if( !doTrackDrc( *seg_it, seg_it + 1, m_pcb->Tracks().end(), m_doZonesTest ) )
+        if( !doTrackDrc( *seg_it, seg_it + 1, m_pcb->Tracks().end(), m_doZonesTest,
+                         geometry ) )
         {
             if( m_currentMarker )
             {
@@ -816,6 +831,8 @@ void DRC::testTracks( wxWindow *aActiveWindow, bool aShowProgressBar )
 
 void DRC::testUnconnected()
 {
+    PROF_SCOPE profScope( "drc-unconnected" );
+
     for( DRC_ITEM* unconnectedItem : m_unconnected )
         delete unconnectedItem;
 
@@ -847,6 +864,8 @@ void DRC::testUnconnected()
 
 void DRC::testZones()
 {
+    PROF_SCOPE profScope( "drc-zones" );
+
     // Test copper areas for valid netcodes
     // if a netcode is < 0 the netname was not found when reading a netlist
     // if a netcode is == 0 the netname is void, and the zone is not connected.
@@ -883,6 +902,8 @@ void DRC::testZones()
 
 void DRC::testKeepoutAreas()
 {
+    PROF_SCOPE profScope( "drc-keepouts" );
+
     // Get a list of all zones to inspect, from both board and footprints
     std::list<ZONE_CONTAINER*> areasToInspect = m_pcb->GetZoneList( true );
 
@@ -932,6 +953,8 @@ void DRC::testKeepoutAreas()
 
 void DRC::testCopperTextAndGraphics()
 {
+    PROF_SCOPE profScope( "drc-copper-graphics" );
+
     // Test copper items for clearance violations with vias, tracks and pads
 
     for( BOARD_ITEM* brdItem : m_pcb->Drawings() )
@@ -1161,6 +1184,8 @@ void DRC::testCopperTextItem( BOARD_ITEM* aTextItem )
 
 void DRC::testOutline()
 {
+    PROF_SCOPE profScope( "drc-outline" );
+
     wxPoint error_loc( m_pcb->GetBoardEdgesBoundingBox().GetPosition() );
 
     m_board_outlines.RemoveAllContours();
@@ -1175,6 +1200,8 @@ void DRC::testOutline()
 
 void DRC::testDisabledLayers()
 {
+    PROF_SCOPE profScope( "drc-disabled-layers" );
+
     BOARD* board = m_pcbEditorFrame->GetBoard();
     wxCHECK( board, /*void*/ );
     LSET disabledLayers = board->GetEnabledLayers().flip();
@@ -1344,6 +1371,8 @@ bool DRC::doPadToPadsDrc( D_PAD* aRefPad, D_PAD** aStart, D_PAD** aEnd, int x_li
 
 void DRC::doOverlappingCourtyardsDrc()
 {
+    PROF_SCOPE profScope( "drc-courtyards" );
+
     DRC_COURTYARD_OVERLAP drc_overlap(
             m_markerFactory, [&]( MARKER_PCB* aMarker ) { addMarkerToPcb( aMarker ); } );
 
@@ -25,6 +25,7 @@
 #ifndef DRC_H
 #define DRC_H
 
+#include <board_geometry_snapshot.h>
 #include <class_board.h>
 #include <class_track.h>
 #include <geometry/seg.h>
@@ -331,11 +332,13 @@ private:
      * @param aStartIt the iterator to the first track to test
      * @param aEndIt the marker for the iterator end
      * @param aTestZones true if should do copper zones test. This can be very time consumming
+     * @param aGeometry the geometry of the tracks and pads of m_pcb, used to skip quickly the
+     *                  ones too far away from aRefSeg.  The iterators must be in m_pcb->Tracks().
      * @return bool - true if no problems, else false and m_currentMarker is
      *          filled in with the problem information.
      */
     bool doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterator aEndIt,
-                     bool aTestZones );
+                     bool aTestZones, const BOARD_GEOMETRY_SNAPSHOT& aGeometry );
 
     /**
      * Test for footprint courtyard overlaps.
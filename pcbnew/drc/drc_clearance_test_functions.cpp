@@ -112,7 +112,7 @@ bool poly2segmentDRC( wxPoint* aTref, int aTrefCount, wxPoint aSegStart, wxPoint
 
 
 bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterator aEndIt,
-                      bool aTestZones )
+                      bool aTestZones, const BOARD_GEOMETRY_SNAPSHOT& aGeometry )
 {
     TRACK*    track;
     wxPoint   delta;           // length on X and Y axis of segments
@@ -160,6 +160,21 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
     int  ref_seg_clearance  = netclass->GetClearance();
     int  ref_seg_width = aRefSeg->GetWidth();
 
+    const BOARD_GEOMETRY_SNAPSHOT::BOX refSegBox = BOARD_GEOMETRY_SNAPSHOT::TrackBox( aRefSeg );
+
+    // Returns true if an item of aGeometry cannot be closer than its clearance to aRefSeg
+    auto isFarAway = [&]( const BOARD_GEOMETRY_SNAPSHOT::ENTRY& aEntry ) -> bool
+    {
+        int margin = std::max( ref_seg_clearance, aEntry.m_clearance );
+        BOARD_GEOMETRY_SNAPSHOT::BOX box = aEntry.m_bbox;
+
+        box.m_xmin -= margin;
+        box.m_ymin -= margin;
+        box.m_xmax += margin;
+        box.m_ymax += margin;
+
+        return !box.Intersects( refSegBox );
+    };
 
     /******************************************/
     /* Phase 0 : via DRC tests :              */
@@ -310,10 +325,15 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
     dummypad.SetLayerSet( LSET::AllCuMask() );     // Ensure the hole is on all layers
 
     // Compute the min distance to pads
+    auto padGeometry = aGeometry.Pads().begin();
+
     for( MODULE* mod : m_pcb->Modules() )
     {
         for( D_PAD* pad : mod->Pads() )
         {
+            if( isFarAway( *padGeometry++ ) )
+                continue;
+
             SEG padSeg( pad->GetPosition(), pad->GetPosition() );
 
             // No problem if pads are on another layer, but if a drill hole exists (a pad on
@@ -375,20 +395,29 @@ bool DRC::doTrackDrc( TRACK* aRefSeg, TRACKS::iterator aStartIt, TRACKS::iterato
     wxPoint segStartPoint;
     wxPoint segEndPoint;
 
+    auto trackGeometry = aGeometry.Tracks().begin() + ( aStartIt - m_pcb->Tracks().begin() );
+
     for( auto it = aStartIt; it != aEndIt; it++ )
     {
-        track = *it;
+        const BOARD_GEOMETRY_SNAPSHOT::ENTRY& geometry = *trackGeometry++;
+
         // No problem if segments have the same net code:
-        if( net_code_ref == track->GetNetCode() )
+        if( net_code_ref == geometry.m_netCode )
             continue;
 
         // No problem if segment are on different layers :
-        if( !( layerMask & track->GetLayerSet() ).any() )
+        if( !( layerMask & geometry.m_layers ).any() )
             continue;
 
+        // No problem if the segments are too far away
+        if( isFarAway( geometry ) )
+            continue;
+
+        track = *it;
+
         // the minimum distance = clearance plus half the reference track
         // width plus half the other track's width
-        int w_dist = std::max( ref_seg_clearance, track->GetClearance() );
+        int w_dist = std::max( ref_seg_clearance, geometry.m_clearance );
         w_dist += ( ref_seg_width + track->GetWidth() ) / 2;
 
         // Due to many double to int conversions during calculations, which
@@ -44,9 +44,15 @@
 #include <pcbnew.h>
 #include <pcbnew_id.h>
 #include <io_mgr.h>
+#include <kicad_plugin.h>
+#include <advanced_config.h>
 #include <wildcards_and_files_ext.h>
 
 #include <class_board.h>
+#include <class_zone.h>
+#include <pcb_draw_panel_gal.h>
+#include <view/view.h>
+#include <zone_filler.h>
 #include <build_version.h>      // LEGACY_BOARD_FILE_VERSION
 
 #include <wx/stdpaths.h>
@@ -242,6 +248,9 @@ bool PCB_EDIT_FRAME::Files_io_from_id( int id )
 
             if( id == ID_MENU_RECOVER_BOARD_AUTOSAVE )
             {
+                // Read the auto save file once completely written
+                waitForAutoSave();
+
                 wxString rec_name = GetAutoSaveFilePrefix() + fn.GetName();
                 fn.SetName( rec_name );
             }
@@ -515,6 +524,10 @@ bool PCB_EDIT_FRAME::OpenProjectFiles( const std::vector<wxString>& aFileSet, in
             props["page_width"]  = xbuf;
             props["page_height"] = ybuf;
 
+            // The zones are filled again after loading, see fillSkippedZones()
+            if( ADVANCED_CFG::GetCfg().m_skipZoneFillsOnLoad )
+                props["skip_zone_fills"] = "";
+
 #if USE_INSTRUMENTATION
             // measure the time to load a BOARD.
             unsigned startTime = GetRunningMicroSecs();
@@ -620,6 +633,11 @@ bool PCB_EDIT_FRAME::OpenProjectFiles( const std::vector<wxString>& aFileSet, in
 
     onBoardLoaded();
 
+    // Fill the zones which were loaded without their fills once the board is shown.  If they
+    // cannot be filled now, they are filled before the board is saved.
+    m_zoneFillsSkipped = ADVANCED_CFG::GetCfg().m_skipZoneFillsOnLoad;
+    CallAfter( [this]() { fillSkippedZones(); } );
+
     // Refresh the 3D view, if any
     EDA_3D_VIEWER* draw3DFrame = Get3DViewerFrame();
 
@@ -703,6 +721,13 @@ bool PCB_EDIT_FRAME::SavePcbFile( const wxString& aFileName, bool aCreateBackupF
         return false;
     }
 
+    if( !fillSkippedZones() )
+    {
+        DisplayError( this, _( "The zone fills skipped when opening the board could not be "
+                               "built.  The board was not saved." ) );
+        return false;
+    }
+
     wxString backupFileName;
 
     if( aCreateBackupFile )
@@ -755,7 +780,10 @@ bool PCB_EDIT_FRAME::SavePcbFile( const wxString& aFileName, bool aCreateBackupF
     if( aCreateBackupFile )
         UpdateFileHistory( GetBoard()->GetFileName() );
 
-    // Delete auto save file on successful save.
+    // Delete auto save file on successful save (after the end of a background auto save, which
+    // would create it again).
+    waitForAutoSave();
+
     wxFileName autoSaveFileName = pcbFileName;
 
     autoSaveFileName.SetName( GetAutoSaveFilePrefix() + pcbFileName.GetName() );
@@ -794,6 +822,13 @@ bool PCB_EDIT_FRAME::SavePcbCopy( const wxString& aFileName )
         return false;
     }
 
+    if( !fillSkippedZones() )
+    {
+        DisplayError( this, _( "The zone fills skipped when opening the board could not be "
+                               "built.  The board was not copied." ) );
+        return false;
+    }
+
     GetBoard()->SynchronizeNetsAndNetClasses();
 
     // Select default Netclass before writing file.
@@ -850,6 +885,10 @@ bool PCB_EDIT_FRAME::doAutoSave()
     if( !autoSaveFileName.IsOk() )
         return false;
 
+    // Never auto save a board without the zone fills skipped on load: try again later
+    if( !fillSkippedZones() )
+        return false;
+
     // If the board file path is not writable, try writing to a platform specific temp file
     // path.  If that path isn't writabe, give up.
     if( !autoSaveFileName.IsDirWritable() )
@@ -862,6 +901,62 @@ bool PCB_EDIT_FRAME::doAutoSave()
 
     wxLogTrace( traceAutoSave, "Creating auto save file <" + autoSaveFileName.GetFullPath() + ">" );
 
+    if( ADVANCED_CFG::GetCfg().m_backgroundAutoSave )
+    {
+        // The previous auto save file is still being written: try again later
+        if( m_autoSaveWriter.valid()
+                && m_autoSaveWriter.wait_for( std::chrono::seconds( 0 ) )
+                        != std::future_status::ready )
+        {
+            return false;
+        }
+
+        waitForAutoSave();
+
+        GetBoard()->SynchronizeNetsAndNetClasses();
+        SetCurrentNetClass( NETCLASS::Default );
+
+        // The board is formatted here, it cannot be read by another thread while it is edited.
+        // Only the writing of the file, which can take seconds on slow or network disks, is
+        // done in the background.
+        auto snapshot = std::make_shared<STRING_FORMATTER>();
+
+        try
+        {
+            PCB_IO pi;
+
+            pi.FormatBoardFile( GetBoard(), snapshot.get() );
+        }
+        catch( const IO_ERROR& ioe )
+        {
+            wxLogTrace( traceAutoSave, "Auto save failed: " + ioe.What() );
+            return false;
+        }
+
+        wxString fileName = autoSaveFileName.GetFullPath();
+
+        m_autoSaveWriter = std::async( std::launch::async,
+                [fileName, snapshot]() -> bool
+                {
+                    try
+                    {
+                        FILE_OUTPUTFORMATTER formatter( fileName );
+
+                        formatter.Write( snapshot->GetString() );
+                    }
+                    catch( const IO_ERROR& )
+                    {
+                        return false;
+                    }
+
+                    return true;
+                } );
+
+        GetScreen()->ClrSave();
+        m_autoSaveState = false;
+        return true;
+    }
+
     if( SavePcbFile( autoSaveFileName.GetFullPath(), NO_BACKUP_FILE ) )
     {
         GetScreen()->SetModify();
@@ -877,6 +972,51 @@ bool PCB_EDIT_FRAME::doAutoSave()
 }
 
 
+bool PCB_EDIT_FRAME::fillSkippedZones()
+{
+    if( !m_zoneFillsSkipped )
+        return true;
+
+    std::vector<ZONE_CONTAINER*> toFill;
+
+    for( ZONE_CONTAINER* zone : GetBoard()->Zones() )
+    {
+        if( zone->IsFilled() && zone->NeedRefill() )
+            toFill.push_back( zone );
+    }
+
+    if( !toFill.empty() )
+    {
+        // Without commit: the fills are not a modification of the board, they were just
+        // not read
+        ZONE_FILLER filler( GetBoard() );
+
+        filler.InstallNewProgressReporter( this, _( "Fill All Zones" ), 4 );
+
+        if( !filler.Fill( toFill ) )
+        {
+            wxLogTrace( traceAutoSave, "The zone fills skipped on load could not be built." );
+            return false;
+        }
+
+        for( ZONE_CONTAINER* zone : toFill )
+            GetCanvas()->GetView()->Update( zone );
+
+        GetCanvas()->Refresh();
+    }
+
+    m_zoneFillsSkipped = false;
+    return true;
+}
+
+
+void PCB_EDIT_FRAME::waitForAutoSave()
+{
+    if( m_autoSaveWriter.valid() && !m_autoSaveWriter.get() )
+        wxLogTrace( traceAutoSave, "Writing the auto save file failed." );
+}
+
+
 bool PCB_EDIT_FRAME::importFile( const wxString& aFileName, int aFileType )
 {
     switch( (IO_MGR::PCB_FILE_T) aFileType )
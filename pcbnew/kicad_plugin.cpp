@@ -44,6 +44,9 @@
 #include <kicad_plugin.h>
 #include <pcb_parser.h>
 #include <pcbnew_settings.h>
+#include <profile.h>
+#include <properties.h>
+#include <zone_fill_encoding.h>
 #include <wx/dir.h>
 #include <wx/filename.h>
 #include <wx/wfstream.h>
@@ -55,6 +58,11 @@
 
 #include <advanced_config.h> // for pad pin function and pad property feature management
 
+#include <atomic>
+#include <future>
+#include <memory>
+#include <thread>
+
 using namespace PCB_KEYS_T;
 
 
@@ -355,6 +363,17 @@ long long FP_CACHE::GetTimestamp( const wxString& aLibPath )
 
 void PCB_IO::Save( const wxString& aFileName, BOARD* aBoard, const PROPERTIES* aProperties )
 {
+    PROF_SCOPE profScope( "pcb-save" );
+    FILE_OUTPUTFORMATTER    formatter( aFileName );
+
+    FormatBoardFile( aBoard, &formatter, aProperties );
+}
+
+
+void PCB_IO::FormatBoardFile( BOARD* aBoard, OUTPUTFORMATTER* aFormatter,
+                              const PROPERTIES* aProperties )
+{
+    PROF_SCOPE  profScope( "pcb-format" );
     LOCALE_IO   toggle;     // toggles on, then off, the C locale.
 
     init( aProperties );
@@ -364,12 +383,10 @@ void PCB_IO::Save( const wxString& aFileName, BOARD* aBoard, const PROPERTIES* a
     // Prepare net mapping that assures that net codes saved in a file are consecutive integers
     m_mapping->SetBoard( aBoard );
 
-    FILE_OUTPUTFORMATTER    formatter( aFileName );
-
-    m_out = &formatter;     // no ownership
+    m_out = aFormatter;     // no ownership
 
     m_out->Print( 0, "(kicad_pcb (version %d) (host pcbnew %s)\n", SEXPR_BOARD_FILE_VERSION,
-                  formatter.Quotew( GetBuildVersion() ).c_str() );
+                  m_out->Quotew( GetBuildVersion() ).c_str() );
 
     Format( aBoard, 1 );
 
@@ -770,32 +787,92 @@ void PCB_IO::format( BOARD* aBoard, int aNestLevel ) const
 {
     formatHeader( aBoard, aNestLevel );
 
-    // Save the modules.
-    for( auto module : aBoard->Modules() )
+    // The items to save, in the order of the file: the modules, the graphical items on the
+    // board (not owned by a module), the tracks and vias, then the polygon (which are the
+    // newer technology) zones.
+    // Do not save MARKER_PCBs, they can be regenerated easily.
+    std::vector<BOARD_ITEM*> items;
+
+    items.reserve( aBoard->Modules().size() + aBoard->Drawings().size()
+                   + aBoard->Tracks().size() + aBoard->GetAreaCount() );
+
+    items.insert( items.end(), aBoard->Modules().begin(), aBoard->Modules().end() );
+    size_t modulesEnd = items.size();
+
+    items.insert( items.end(), aBoard->Drawings().begin(), aBoard->Drawings().end() );
+    size_t drawingsEnd = items.size();
+
+    items.insert( items.end(), aBoard->Tracks().begin(), aBoard->Tracks().end() );
+    size_t tracksEnd = items.size();
+
+    for( int i = 0; i < aBoard->GetAreaCount();  ++i )
+        items.push_back( aBoard->GetArea( i ) );
+
+    // Formats an item with aIo, followed by the blank lines ending the modules and the
+    // drawings and tracks sections
+    auto formatItem = [&]( const PCB_IO& aIo, size_t aIndex )
     {
-        Format( module, aNestLevel );
-        m_out->Print( 0, "\n" );
+        aIo.Format( items[aIndex], aNestLevel );
+
+        if( aIndex < modulesEnd )
+            aIo.m_out->Print( 0, "\n" );
+        else if( aIndex + 1 == drawingsEnd || aIndex + 1 == tracksEnd )
+            aIo.m_out->Print( 0, "\n" );
+    };
+
+    // The items are formatted in parallel, by chunks, each one to its own STRING_FORMATTER.
+    // The chunks are then written in order, so the file is the same as a serial output.
+    const size_t chunkSize = 256;
+    size_t       chunkCount = ( items.size() + chunkSize - 1 ) / chunkSize;
+    size_t       parallelThreadCount =
+            std::min<size_t>( std::thread::hardware_concurrency(), chunkCount );
+
+    if( parallelThreadCount <= 1 )
+    {
+        for( size_t i = 0; i < items.size(); ++i )
+            formatItem( *this, i );
+
+        return;
     }
 
-    // Save the graphical items on the board (not owned by a module)
-    for( auto item : aBoard->Drawings() )
-        Format( item, aNestLevel );
+    // Each thread has its own PCB_IO to output to its own formatters.  They are created here:
+    // the board and the net mapping are shared, and only read.
+    std::vector<std::unique_ptr<PCB_IO>> threadIos;
 
-    if( aBoard->Drawings().size() )
-        m_out->Print( 0, "\n" );
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+    {
+        threadIos.emplace_back( new PCB_IO( m_ctl ) );
+        threadIos.back()->m_board = m_board;
+        threadIos.back()->m_compressZoneFills = m_compressZoneFills;
+        *threadIos.back()->m_mapping = *m_mapping;
+    }
 
-    // Do not save MARKER_PCBs, they can be regenerated easily.
+    std::vector<STRING_FORMATTER>  chunks( chunkCount );
+    std::atomic<size_t>            nextChunk( 0 );
+    std::vector<std::future<void>> returns( parallelThreadCount );
 
-    // Save the tracks and vias.
-    for( auto track : aBoard->Tracks() )
-        Format( track, aNestLevel );
+    auto format_lambda = [&]( PCB_IO* aIo )
+    {
+        for( size_t i = nextChunk++; i < chunkCount; i = nextChunk++ )
+        {
+            size_t end = std::min( items.size(), ( i + 1 ) * chunkSize );
 
-    if( aBoard->Tracks().size() )
-        m_out->Print( 0, "\n" );
+            aIo->SetOutputFormatter( &chunks[i] );
 
-    // Save the polygon (which are the newer technology) zones.
-    for( int i = 0; i < aBoard->GetAreaCount();  ++i )
-        Format( aBoard->GetArea( i ), aNestLevel );
+            for( size_t j = i * chunkSize; j < end; ++j )
+                formatItem( *aIo, j );
+        }
+    };
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        returns[ii] = std::async( std::launch::async, format_lambda, threadIos[ii].get() );
+
+    // Finalize the threads (get() throws again the exceptions thrown by the threads)
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+        returns[ii].get();
+
+    for( STRING_FORMATTER& chunk : chunks )
+        m_out->Write( chunk.GetString() );
 }
 
 
@@ -1945,7 +2022,20 @@ void PCB_IO::format( ZONE_CONTAINER* aZone, int aNestLevel ) const
     const SHAPE_POLY_SET& fv = aZone->GetFilledPolysList();
     newLine = 0;
 
-    if( !fv.IsEmpty() )
+    if( !fv.IsEmpty() && m_compressZoneFills )
+    {
+        // The encoded data is split in lines of 100 characters
+        const size_t lineLength = 100;
+        std::string  encoded = EncodeZoneFill( fv );
+
+        m_out->Print( aNestLevel+1, "(filled_polygon_data\n" );
+
+        for( size_t i = 0; i < encoded.size(); i += lineLength )
+            m_out->Print( aNestLevel+2, "\"%s\"\n", encoded.substr( i, lineLength ).c_str() );
+
+        m_out->Print( aNestLevel+1, ")\n" );
+    }
+    else if( !fv.IsEmpty() )
     {
         bool new_polygon = true;
         bool is_closed = false;
@@ -1995,8 +2085,10 @@ void PCB_IO::format( ZONE_CONTAINER* aZone, int aNestLevel ) const
             m_out->Print( aNestLevel+1, ")\n" );
     }
 
-    // Save the filling segments list
-    const auto& segs = aZone->FillSegments();
+    // Save the filling segments list (read through a const zone: the non const accessor
+    // unshares the fill from the undo copies of the zone)
+    const ZONE_CONTAINER*    constZone = aZone;
+    const ZONE_SEGMENT_FILL& segs = constZone->FillSegments();
 
     if( segs.size() )
     {
@@ -2037,6 +2129,7 @@ PCB_IO::~PCB_IO()
 
 BOARD* PCB_IO::Load( const wxString& aFileName, BOARD* aAppendToMe, const PROPERTIES* aProperties )
 {
+    PROF_SCOPE profScope( "pcb-load" );
     FILE_LINE_READER    reader( aFileName );
 
     init( aProperties );
@@ -2085,6 +2178,12 @@ void PCB_IO::init( const PROPERTIES* aProperties )
     m_reader = NULL;
     m_loading_format_version = SEXPR_BOARD_FILE_VERSION;
     m_props = aProperties;
+
+    // The zone fills can be skipped only by a caller filling the zones after loading
+    m_parser->SetSkipZoneFills( aProperties && aProperties->Exists( "skip_zone_fills" ) );
+
+    m_compressZoneFills = ADVANCED_CFG::GetCfg().m_compressZoneFills
+                          || ( aProperties && aProperties->Exists( "compress_zone_fills" ) );
 }
 
 
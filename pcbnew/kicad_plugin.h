@@ -66,7 +66,8 @@ class TEXTE_PCB;
 //#define SEXPR_BOARD_FILE_VERSION    20190907  // Keepout areas in footprints
 //#define SEXPR_BOARD_FILE_VERSION    20191123  // pin function in pads
 //#define SEXPR_BOARD_FILE_VERSION    20200104    // pad property for fabrication
-#define SEXPR_BOARD_FILE_VERSION      20200119  // arcs in tracks
+//#define SEXPR_BOARD_FILE_VERSION    20200119  // arcs in tracks
+#define SEXPR_BOARD_FILE_VERSION      20200512  // compressed zone fills (filled_polygon_data)
 
 #define CTL_STD_LAYER_NAMES         (1 << 0)    ///< Use English Standard layer names
 #define CTL_OMIT_NETS               (1 << 1)    ///< Omit pads net names (useless in library)
@@ -168,6 +169,17 @@ public:
      */
     void Format( BOARD_ITEM* aItem, int aNestLevel = 0 ) const;
 
+    /**
+     * Function FormatBoardFile
+     * outputs the whole board file of \a aBoard to \a aFormatter, as Save() does to a file.
+     * This is used to take a snapshot of a board in memory, e.g. to write it later from
+     * another thread.
+     *
+     * @throw IO_ERROR on write error.
+     */
+    void FormatBoardFile( BOARD* aBoard, OUTPUTFORMATTER* aFormatter,
+                          const PROPERTIES* aProperties = NULL );
+
     std::string GetStringOutput( bool doClear )
     {
         std::string ret = m_sf.GetString();
@@ -198,6 +210,7 @@ protected:
     STRING_FORMATTER    m_sf;
     OUTPUTFORMATTER*    m_out;      ///< output any Format()s to this, no ownership
     int                 m_ctl;
+    bool                m_compressZoneFills;    ///< write (filled_polygon_data ...) blocks
     PCB_PARSER*         m_parser;
     NETINFO_MAPPING*    m_mapping;  ///< mapping for net codes, so only not empty net codes
                                     ///< are stored with consecutive integers as net codes
@@ -375,7 +375,10 @@ bool D_PAD::MergePrimitivesAsPolygon( SHAPE_POLY_SET* aMergedPolygon )
     if( !buildCustomPadPolygon( aMergedPolygon, maxError ) )
         return false;
 
-    m_boundingRadius = -1;  // The current bounding radius is no longer valid.
+    // The current bounding radius is no longer valid.  A polygon built for the caller
+    // leaves the pad untouched (the plot reads pads shared by several threads).
+    if( aMergedPolygon == &m_customShapeAsPolygon )
+        m_boundingRadius = -1;
 
     return aMergedPolygon->OutlineCount() <= 1;
 }
@@ -614,14 +614,14 @@ int D_PAD::BuildSegmentFromOvalShape( wxPoint& aSegStart, wxPoint& aSegEnd, doub
 }
 
 
-void D_PAD::BuildPadPolygon( wxPoint aCoord[4], wxSize aInflateValue,
-                             double aRotation ) const
+void D_PAD::BuildPadPolygon( wxPoint aCoord[4], wxSize aInflateValue, double aRotation,
+                             const wxSize& aSize, const wxSize& aDelta ) const
 {
     wxSize delta;
     wxSize halfsize;
 
-    halfsize.x = m_Size.x >> 1;
-    halfsize.y = m_Size.y >> 1;
+    halfsize.x = aSize.x >> 1;
+    halfsize.y = aSize.y >> 1;
 
     switch( GetShape() )
     {
@@ -640,8 +640,8 @@ void D_PAD::BuildPadPolygon( wxPoint aCoord[4], wxSize aInflateValue,
 
         case PAD_SHAPE_TRAPEZOID:
             // Trapezoidal pad: verify delta values
-            delta.x = ( m_DeltaSize.x >> 1 );
-            delta.y = ( m_DeltaSize.y >> 1 );
+            delta.x = ( aDelta.x >> 1 );
+            delta.y = ( aDelta.y >> 1 );
 
             // be sure delta values are not to large
             if( (delta.x < 0) && (delta.x <= -halfsize.y) )
@@ -685,7 +685,7 @@ void D_PAD::BuildPadPolygon( wxPoint aCoord[4], wxSize aInflateValue,
         if( delta.y )    // lower and upper segment is horizontal
         {
             // Calculate angle of left (or right) segment with vertical axis
-            angle = atan2( (double) m_DeltaSize.y, (double) m_Size.y );
+            angle = atan2( (double) aDelta.y, (double) aSize.y );
 
             // left and right sides are moved by aInflateValue.x in their perpendicular direction
             // We must calculate the corresponding displacement on the horizontal axis
@@ -701,7 +701,7 @@ void D_PAD::BuildPadPolygon( wxPoint aCoord[4], wxSize aInflateValue,
         else if( delta.x )          // left and right segment is vertical
         {
             // Calculate angle of lower (or upper) segment with horizontal axis
-            angle = atan2( (double) m_DeltaSize.x, (double) m_Size.x );
+            angle = atan2( (double) aDelta.x, (double) aSize.x );
 
             // lower and upper sides are moved by aInflateValue.x in their perpendicular direction
             // We must calculate the corresponding displacement on the vertical axis
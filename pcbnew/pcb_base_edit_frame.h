@@ -95,7 +95,8 @@ public:
      * Function SaveCopyInUndoList
      * Creates a new entry in undo list of commands.
      * add a list of pickers to handle a list of items
-     * @param aItemsList = the list of items modified by the command to undo
+     * @param aItemsList = the list of items modified by the command to undo, and the angle
+     *                     or direction of its rotate or flip commands
      * @param aTypeCommand = command type (see enum UNDO_REDO_T)
      * @param aTransformPoint = the reference point of the transformation,
      *                          for commands like move
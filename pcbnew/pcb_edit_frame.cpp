@@ -174,6 +174,7 @@ PCB_EDIT_FRAME::PCB_EDIT_FRAME( KIWAY* aKiway, wxWindow* aParent ) :
     m_show_microwave_tools = false;
     m_show_layer_manager_tools = true;
     m_hasAutoSave = true;
+    m_zoneFillsSkipped = false;
     m_microWaveToolBar = NULL;
     m_Layers = nullptr;
     m_FrameSize = ConvertDialogToPixels( wxSize( 500, 350 ) );    // default in case of no prefs
@@ -510,7 +511,10 @@ void PCB_EDIT_FRAME::OnCloseWindow( wxCloseEvent& aEvent )
 
     GetCanvas()->StopDrawing();
 
-    // Delete the auto save file if it exists.
+    // Delete the auto save file if it exists (after the end of a background auto save, which
+    // would create it again).
+    waitForAutoSave();
+
     wxFileName fn = GetBoard()->GetFileName();
 
     // Auto save file name is the normal file name prefixed with 'GetAutoSaveFilePrefix()'.
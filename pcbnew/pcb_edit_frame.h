@@ -21,6 +21,7 @@
 #ifndef  WXPCB_STRUCT_H_
 #define  WXPCB_STRUCT_H_
 
+#include <future>
 #include <unordered_map>
 #include <map>
 #include "pcb_base_edit_frame.h"
@@ -132,6 +133,13 @@ protected:
 
     LAYER_TOOLBAR_ICON_VALUES m_prevIconVal;
 
+    ///> The writing of the last background auto save file (see doAutoSave()).  Its destructor
+    ///> waits for the end of the writing.
+    std::future<bool>       m_autoSaveWriter;
+
+    ///> True while the zone fills skipped when opening the board are not built again
+    bool                    m_zoneFillsSkipped;
+
     // The Tool Framework initalization
     void setupTools();
 
@@ -242,10 +250,27 @@ protected:
      * performs auto save when the board has been modified and not saved within the
      * auto save interval.
      *
-     * @return true if the auto save was successful.
+     * Unless disabled in the advanced config, the board is formatted in memory and the file
+     * is written by a background thread: only the formatting blocks the editor.
+     *
+     * @return true if the auto save was successful (or, in the background, started).
      */
     bool doAutoSave() override;
 
+    /**
+     * Function waitForAutoSave
+     * waits for the end of the writing of a background auto save file.
+     */
+    void waitForAutoSave();
+
+    /**
+     * Function fillSkippedZones
+     * fills the zones whose fills were not read when opening the board (see the
+     * SkipZoneFillsOnLoad advanced config).
+     * @return false if the fills could not be built (the connectivity is busy): the zones
+     * keep their NeedRefill() flag, and the board must not be saved without its fills.
+     */
+    bool fillSkippedZones();
     /**
      * Function isautoSaveRequired
      * returns true if the board has been modified.
@@ -50,6 +50,7 @@
 #include <zones.h>
 #include <pcb_parser.h>
 #include <convert_basic_shapes_to_polygon.h>    // for RECT_CHAMFER_POSITIONS definition
+#include <zone_fill_encoding.h>
 
 using namespace PCB_KEYS_T;
 
@@ -3591,6 +3592,7 @@ ZONE_CONTAINER* PCB_PARSER::parseZONE_CONTAINER( BOARD_ITEM_CONTAINER* aParent )
 
     // bigger scope since each filled_polygon is concatenated in here
     SHAPE_POLY_SET pts;
+    bool fillSkipped = false;
     bool inModule = false;
 
     if( dynamic_cast<MODULE*>( aParent ) )      // The zone belongs a footprint
@@ -3912,6 +3914,13 @@ ZONE_CONTAINER* PCB_PARSER::parseZONE_CONTAINER( BOARD_ITEM_CONTAINER* aParent )
 
         case T_filled_polygon:
             {
+                if( m_skipZoneFills )
+                {
+                    fillSkipped = true;
+                    skipCurrent();
+                    break;
+                }
+
                 // "(filled_polygon (pts"
                 NeedLEFT();
                 token = NextTok();
@@ -3930,8 +3939,43 @@ ZONE_CONTAINER* PCB_PARSER::parseZONE_CONTAINER( BOARD_ITEM_CONTAINER* aParent )
             }
             break;
 
+        case T_filled_polygon_data:
+            {
+                if( m_skipZoneFills )
+                {
+                    fillSkipped = true;
+                    skipCurrent();
+                    break;
+                }
+
+                // "(filled_polygon_data "..." "..." ...)": the encoded data, split in strings
+                std::string encoded;
+
+                for( token = NextTok();  token != T_RIGHT;  token = NextTok() )
+                {
+                    if( !IsSymbol( token ) )
+                        Expecting( DSN_STRING );
+
+                    encoded += CurText();
+                }
+
+                if( !DecodeZoneFill( encoded, pts ) )
+                {
+                    THROW_PARSE_ERROR( _( "Invalid filled_polygon_data" ), CurSource(), CurLine(),
+                                       CurLineNumber(), CurOffset() );
+                }
+            }
+            break;
+
         case T_fill_segments:
             {
+                if( m_skipZoneFills )
+                {
+                    fillSkipped = true;
+                    skipCurrent();
+                    break;
+                }
+
                 ZONE_SEGMENT_FILL segs;
 
                 for( token = NextTok();  token != T_RIGHT;  token = NextTok() )
@@ -3955,7 +3999,7 @@ ZONE_CONTAINER* PCB_PARSER::parseZONE_CONTAINER( BOARD_ITEM_CONTAINER* aParent )
 
         default:
             Expecting( "net, layer/layers, tstamp, hatch, priority, connect_pads, min_thickness, "
-                       "fill, polygon, filled_polygon, or fill_segments" );
+                       "fill, polygon, filled_polygon, filled_polygon_data, or fill_segments" );
         }
     }
 
@@ -4018,8 +4062,8 @@ ZONE_CONTAINER* PCB_PARSER::parseZONE_CONTAINER( BOARD_ITEM_CONTAINER* aParent )
         }
     }
 
-    // Clear flags used in zone edition:
-    zone->SetNeedRefill( false );
+    // Clear flags used in zone edition (the skipped fills must be computed again):
+    zone->SetNeedRefill( fillSkipped );
 
     return zone.release();
 }
@@ -79,6 +79,7 @@ class PCB_PARSER : public PCB_LEXER
     int                 m_requiredVersion;  ///< set to the KiCad format version this board requires
 
     bool                m_showLegacyZoneWarning;
+    bool                m_skipZoneFills;    ///< do not read the zone fills, see SetSkipZoneFills()
 
     ///> Converts net code using the mapping table if available,
     ///> otherwise returns unchanged net code if < 0 or if is is out of range
@@ -317,7 +318,8 @@ public:
 
     PCB_PARSER( LINE_READER* aReader = NULL ) :
         PCB_LEXER( aReader ),
-        m_board( 0 )
+        m_board( 0 ),
+        m_skipZoneFills( false )
     {
         init();
     }
@@ -343,6 +345,17 @@ public:
         m_board = aBoard;
     }
 
+    /**
+     * Function SetSkipZoneFills
+     * allows to skip the filled polygons of the zones, which are most of the board files,
+     * when the zones are filled again after loading.  The zones are then loaded without
+     * fill, and with NeedRefill() true.
+     */
+    void SetSkipZoneFills( bool aSkip )
+    {
+        m_skipZoneFills = aSkip;
+    }
+
     BOARD_ITEM* Parse();
     /**
      * Function parseMODULE
@@ -491,6 +491,38 @@ bool PLOT_CONTROLLER::PlotLayer()
 }
 
 
+bool PLOT_CONTROLLER::PlotLayers( const LSEQ& aLayers, PLOT_FORMAT aFormat,
+                                  const wxString& aSheetDesc )
+{
+    GetPlotOptions().SetFormat( aFormat );
+
+    // Ensure that the previous plot is closed
+    ClosePlot();
+
+    wxFileName outputDir = wxFileName::DirName( GetPlotOptions().GetOutputDirectory() );
+    wxString   boardFilename = m_board->GetFileName();
+
+    if( !EnsureFileDirectoryExists( &outputDir, boardFilename ) )
+        return false;
+
+    wxArrayString fullFileNames;
+
+    for( PCB_LAYER_ID layer : aLayers )
+    {
+        wxFileName fn( boardFilename );
+        wxString   fileExt = GetDefaultPlotExtension( aFormat );
+
+        if( aFormat == PLOT_FORMAT::GERBER && GetPlotOptions().GetUseGerberProtelExtensions() )
+            fileExt = GetGerberProtelExtension( layer );
+
+        BuildPlotFileName( &fn, outputDir.GetPath(), m_board->GetLayerName( layer ), fileExt );
+        fullFileNames.Add( fn.GetFullPath() );
+    }
+
+    return PlotBoardLayers( m_board, GetPlotOptions(), aLayers, fullFileNames, aSheetDesc );
+}
+
+
 void PLOT_CONTROLLER::SetColorMode( bool aColorMode )
 {
     if( !m_plotter )
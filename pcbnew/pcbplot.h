@@ -123,6 +123,16 @@ public:
      */
     void PlotPad( D_PAD* aPad, COLOR4D aColor, EDA_DRAW_MODE_T aPlotMode );
 
+    /**
+     * Plot a pad with another shape than its own (e.g. inflated by the mask margin), without
+     * modifying it: the pads are shared by the layers plotted concurrently.
+     * @param aSize and aDelta replace the size and the delta (trapezoid pads) of the pad.
+     * @param aCustomShape, if not null, replaces the shape of a custom pad, relative to the
+     * pad position at orientation 0, as built by D_PAD::MergePrimitivesAsPolygon().
+     */
+    void PlotPad( D_PAD* aPad, COLOR4D aColor, EDA_DRAW_MODE_T aPlotMode, const wxSize& aSize,
+                  const wxSize& aDelta, const SHAPE_POLY_SET* aCustomShape = nullptr );
+
     /**
      * plot items like text and graphics,
      *  but not tracks and modules
@@ -177,6 +187,23 @@ PLOTTER* StartPlotBoard( BOARD* aBoard,
 void PlotOneBoardLayer( BOARD *aBoard, PLOTTER* aPlotter, PCB_LAYER_ID aLayer,
                         const PCB_PLOT_PARAMS& aPlotOpt );
 
+/**
+ * Function PlotBoardLayers
+ * plots several layers, each one in its own file.  The layers are plotted concurrently,
+ * each one by its own plotter; the board is only read while plotting.
+ * @param aBoard = the board to plot
+ * @param aPlotOpts = the plot options (format, scale, sketch ...)
+ * @param aLayers = the layers to plot
+ * @param aFullFileNames = the full filename of the plot file of each layer of aLayers
+ * @param aSheetDesc = the sheet description, used in the frame reference
+ * @param aReporter = a REPORTER to print the name of the created files and the errors,
+ *                    in the order of aLayers.  Can be NULL
+ * @return true if all the plot files were created
+ */
+bool PlotBoardLayers( BOARD* aBoard, const PCB_PLOT_PARAMS& aPlotOpts, const LSEQ& aLayers,
+                      const wxArrayString& aFullFileNames, const wxString& aSheetDesc,
+                      REPORTER* aReporter = nullptr );
+
 /**
  * Function PlotStandardLayer
  * plot copper or technical layers.
@@ -29,6 +29,10 @@
  */
 
 
+#include <atomic>
+#include <future>
+#include <thread>
+
 #include <fctsys.h>
 #include <common.h>
 #include <plotter.h>
@@ -49,10 +53,13 @@
 #include <class_drawsegment.h>
 #include <class_pcb_target.h>
 #include <class_dimension.h>
+#include <convert_basic_shapes_to_polygon.h>
+#include <geometry/shape_rect.h>
 
 #include <pcbnew.h>
 #include <pcbplot.h>
 #include <gbr_metadata.h>
+#include <reporter.h>
 
 /*
  * Plot a solder mask layer.  Solder mask layers have a minimum thickness value and cannot be
@@ -362,7 +369,7 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
             wxSize extraSize = margin * 2;
             extraSize.x += width_adj;
             extraSize.y += width_adj;
-            wxSize deltaSize = pad->GetDelta(); // has meaning only for trapezoidal pads
+            wxSize padPlotsDelta = pad->GetDelta(); // has meaning only for trapezoidal pads
 
             if( pad->GetShape() == PAD_SHAPE_TRAPEZOID )
             {   // The easy way is to use BuildPadPolygon to calculate
@@ -388,14 +395,12 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
 
                 // calculate the delta ( difference of lenght between 2 opposite edges )
                 // The delta.x is the delta along the X axis, therefore the delta of Y lenghts
-                wxSize delta;
+                padPlotsDelta = wxSize( 0, 0 );
 
                 if( coord[0].y != coord[3].y )
-                    delta.x = coord[0].y - coord[3].y;
+                    padPlotsDelta.x = coord[0].y - coord[3].y;
                 else
-                    delta.y = coord[1].x - coord[0].x;
-
-                pad->SetDelta( delta );
+                    padPlotsDelta.y = coord[1].x - coord[0].x;
             }
             else
                 padPlotsSize = pad->GetSize() + extraSize;
@@ -412,37 +417,33 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
             if( pad->GetLayerSet()[F_Cu] )
                 color = color.LegacyMix( aPlotOpt.ColorSettings()->GetColor( LAYER_PAD_FR ) );
 
-            // Temporary set the pad size to the required plot size:
-            wxSize tmppadsize = pad->GetSize();
-
+            // Layers can be plotted concurrently (see PlotBoardLayers()), so the pad itself is
+            // not resized (nor copied): it is plotted with the required plot size instead.
             switch( pad->GetShape() )
             {
             case PAD_SHAPE_CIRCLE:
             case PAD_SHAPE_OVAL:
-                pad->SetSize( padPlotsSize );
-
                 if( aPlotOpt.GetSkipPlotNPTH_Pads() &&
                     ( aPlotOpt.GetDrillMarksType() == PCB_PLOT_PARAMS::NO_DRILL_SHAPE ) &&
-                    ( pad->GetSize() == pad->GetDrillSize() ) &&
+                    ( padPlotsSize == pad->GetDrillSize() ) &&
                     ( pad->GetAttribute() == PAD_ATTRIB_HOLE_NOT_PLATED ) )
                     break;
 
-                itemplotter.PlotPad( pad, color, plotMode );
+                itemplotter.PlotPad( pad, color, plotMode, padPlotsSize, padPlotsDelta );
                 break;
 
             case PAD_SHAPE_TRAPEZOID:
             case PAD_SHAPE_RECT:
             case PAD_SHAPE_ROUNDRECT:
             case PAD_SHAPE_CHAMFERED_RECT:
-                pad->SetSize( padPlotsSize );
-                itemplotter.PlotPad( pad, color, plotMode );
+                itemplotter.PlotPad( pad, color, plotMode, padPlotsSize, padPlotsDelta );
                 break;
 
             case PAD_SHAPE_CUSTOM:
             {
                 // inflate/deflate a custom shape is a bit complex.
-                // so build a similar pad shape, and inflate/deflate the polygonal shape
-                D_PAD dummy( *pad );
+                // so inflate/deflate the polygonal shape, and merge it with the anchor pad
+                // as a pad having this shape as only primitive would do
                 SHAPE_POLY_SET shape;
                 pad->MergePrimitivesAsPolygon( &shape );
                 // Shape polygon can have holes so use InflateWithLinkedHoles(), not Inflate()
@@ -450,23 +451,38 @@ void PlotStandardLayer( BOARD *aBoard, PLOTTER* aPlotter,
                 int maxError = aBoard->GetDesignSettings().m_MaxError;
                 int numSegs = std::max( GetArcToSegmentCount( margin.x, maxError, 360.0 ), 6 );
                 shape.InflateWithLinkedHoles( margin.x, numSegs, SHAPE_POLY_SET::PM_FAST );
-                dummy.DeletePrimitivesList();
-                dummy.AddPrimitive( shape, 0 );
-                dummy.MergePrimitivesAsPolygon();
+                shape.Fracture( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+                shape.Simplify( SHAPE_POLY_SET::PM_FAST );
 
                 // Be sure the anchor pad is not bigger than the deflated shape because this
-                // anchor will be added to the pad shape when plotting the pad. So now the
-                // polygonal shape is built, we can clamp the anchor size
-                if( margin.x < 0 )  // we expect margin.x = margin.y for custom pads
-                    dummy.SetSize( padPlotsSize );
+                // anchor is added to the pad shape.
+                // (we expect margin.x = margin.y for custom pads)
+                wxSize         anchorSize = margin.x < 0 ? padPlotsSize : pad->GetSize();
+                SHAPE_POLY_SET plotShape;
+
+                if( pad->GetAnchorPadShape() == PAD_SHAPE_RECT )
+                {
+                    SHAPE_RECT rect( -anchorSize.x / 2, -anchorSize.y / 2, anchorSize.x,
+                                     anchorSize.y );
+                    plotShape.AddOutline( rect.Outline() );
+                }
+                else
+                {
+                    TransformCircleToPolygon( plotShape, wxPoint( 0, 0 ), anchorSize.x / 2,
+                                              maxError );
+                }
+
+                if( shape.OutlineCount() )
+                {
+                    plotShape.BooleanAdd( shape, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+                    plotShape.Fracture( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
+                }
 
-                itemplotter.PlotPad( &dummy, color, plotMode );
+                itemplotter.PlotPad( pad, color, plotMode, anchorSize, pad->GetDelta(),
+                                     &plotShape );
             }
                 break;
             }
-
-            pad->SetSize( tmppadsize );     // Restore the pad size
-            pad->SetDelta( deltaSize );
         }
 
         aPlotter->EndBlock( NULL );
@@ -1146,3 +1162,93 @@ PLOTTER* StartPlotBoard( BOARD *aBoard, PCB_PLOT_PARAMS *aPlotOpts, int aLayer,
     delete plotter;
     return NULL;
 }
+
+
+bool PlotBoardLayers( BOARD* aBoard, const PCB_PLOT_PARAMS& aPlotOpts, const LSEQ& aLayers,
+                      const wxArrayString& aFullFileNames, const wxString& aSheetDesc,
+                      REPORTER* aReporter )
+{
+    wxASSERT( aLayers.size() == aFullFileNames.GetCount() );
+
+    // The locale is global to the process: switch it once for all the plots, not in each
+    // plot thread
+    LOCALE_IO toggle;
+
+    // Pads compute their bounding radius on demand: compute it before the plot threads read it
+    for( MODULE* module : aBoard->Modules() )
+    {
+        for( D_PAD* pad : module->Pads() )
+            pad->GetBoundingRadius();
+    }
+
+    // Not a std::vector<bool>, whose items cannot be written by several threads
+    std::vector<char>   created( aLayers.size(), false );
+    std::atomic<size_t> nextLayer( 0 );
+    size_t              parallelThreadCount =
+            std::min<size_t>( std::thread::hardware_concurrency(), aLayers.size() );
+    std::vector<std::future<size_t>> returns( parallelThreadCount );
+
+    auto plot_lambda = [&]() -> size_t
+    {
+        size_t num = 0;
+
+        for( size_t i = nextLayer++; i < aLayers.size(); i = nextLayer++ )
+        {
+            // Each layer has its own options and plotter; the board is shared, and only read
+            PCB_PLOT_PARAMS plotOpts = aPlotOpts;
+            PLOTTER*        plotter = StartPlotBoard( aBoard, &plotOpts, aLayers[i],
+                                                      aFullFileNames[i], aSheetDesc );
+
+            if( !plotter )
+                continue;
+
+            PlotOneBoardLayer( aBoard, plotter, aLayers[i], plotOpts );
+            plotter->EndPlot();
+            delete plotter;
+
+            created[i] = true;
+            num++;
+        }
+
+        return num;
+    };
+
+    if( parallelThreadCount <= 1 )
+        plot_lambda();
+    else
+    {
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii] = std::async( std::launch::async, plot_lambda );
+
+        // Finalize the threads
+        for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            returns[ii].wait();
+    }
+
+    // Report in the layer order, whatever the order the plots ended
+    bool success = true;
+
+    for( size_t i = 0; i < aLayers.size(); ++i )
+    {
+        if( !created[i] )
+            success = false;
+
+        if( !aReporter )
+            continue;
+
+        wxString msg;
+
+        if( created[i] )
+        {
+            msg.Printf( _( "Plot file \"%s\" created." ), aFullFileNames[i] );
+            aReporter->Report( msg, REPORTER::RPT_ACTION );
+        }
+        else
+        {
+            msg.Printf( _( "Unable to create file \"%s\"." ), aFullFileNames[i] );
+            aReporter->Report( msg, REPORTER::RPT_ERROR );
+        }
+    }
+
+    return success;
+}
@@ -85,6 +85,14 @@ COLOR4D BRDITEMS_PLOTTER::getColor( LAYER_NUM aLayer )
 
 
 void BRDITEMS_PLOTTER::PlotPad( D_PAD* aPad, COLOR4D aColor, EDA_DRAW_MODE_T aPlotMode )
+{
+    PlotPad( aPad, aColor, aPlotMode, aPad->GetSize(), aPad->GetDelta() );
+}
+
+
+void BRDITEMS_PLOTTER::PlotPad( D_PAD* aPad, COLOR4D aColor, EDA_DRAW_MODE_T aPlotMode,
+                                const wxSize& aSize, const wxSize& aDelta,
+                                const SHAPE_POLY_SET* aCustomShape )
 {
     wxPoint shape_pos = aPad->ShapePos();
     GBR_METADATA gbr_metadata;
@@ -215,40 +223,40 @@ void BRDITEMS_PLOTTER::PlotPad( D_PAD* aPad, COLOR4D aColor, EDA_DRAW_MODE_T aPl
     switch( aPad->GetShape() )
     {
     case PAD_SHAPE_CIRCLE:
-        m_plotter->FlashPadCircle( shape_pos, aPad->GetSize().x, aPlotMode, &gbr_metadata );
+        m_plotter->FlashPadCircle( shape_pos, aSize.x, aPlotMode, &gbr_metadata );
         break;
 
     case PAD_SHAPE_OVAL:
-        m_plotter->FlashPadOval( shape_pos, aPad->GetSize(),
+        m_plotter->FlashPadOval( shape_pos, aSize,
                                  aPad->GetOrientation(), aPlotMode, &gbr_metadata );
         break;
 
     case PAD_SHAPE_TRAPEZOID:
         {
         wxPoint coord[4];
-        aPad->BuildPadPolygon( coord, wxSize(0,0), 0 );
+        aPad->BuildPadPolygon( coord, wxSize(0,0), 0, aSize, aDelta );
         m_plotter->FlashPadTrapez( shape_pos, coord,
                                    aPad->GetOrientation(), aPlotMode, &gbr_metadata );
         }
         break;
 
     case PAD_SHAPE_ROUNDRECT:
-        m_plotter->FlashPadRoundRect( shape_pos, aPad->GetSize(), aPad->GetRoundRectCornerRadius(),
+        m_plotter->FlashPadRoundRect( shape_pos, aSize, aPad->GetRoundRectCornerRadius( aSize ),
                                       aPad->GetOrientation(), aPlotMode, &gbr_metadata );
         break;
 
     case PAD_SHAPE_CHAMFERED_RECT:
         {
         SHAPE_POLY_SET polygons;
-        const int corner_radius = aPad->GetRoundRectCornerRadius( aPad->GetSize() );
-        TransformRoundChamferedRectToPolygon( polygons, shape_pos, aPad->GetSize(),
+        const int corner_radius = aPad->GetRoundRectCornerRadius( aSize );
+        TransformRoundChamferedRectToPolygon( polygons, shape_pos, aSize,
                 aPad->GetOrientation(), corner_radius, aPad->GetChamferRectRatio(),
                 aPad->GetChamferPositions(), m_board->GetDesignSettings().m_MaxError );
 
         if( polygons.OutlineCount() == 0 )
             break;
 
-        int min_dim = std::min( aPad->GetSize().x, aPad->GetSize().y ) /2;
+        int min_dim = std::min( aSize.x, aSize.y ) /2;
         m_plotter->FlashPadCustom( shape_pos,wxSize( min_dim, min_dim ), &polygons, aPlotMode, &gbr_metadata );
         }
         break;
@@ -256,19 +264,23 @@ void BRDITEMS_PLOTTER::PlotPad( D_PAD* aPad, COLOR4D aColor, EDA_DRAW_MODE_T aPl
     case PAD_SHAPE_CUSTOM:
         {
         SHAPE_POLY_SET polygons;
-        aPad->MergePrimitivesAsPolygon( &polygons );
+
+        if( aCustomShape )
+            polygons = *aCustomShape;
+        else
+            aPad->MergePrimitivesAsPolygon( &polygons );
 
         if( polygons.OutlineCount() == 0 )
             break;
 
         aPad->CustomShapeAsPolygonToBoardPosition( &polygons, shape_pos, aPad->GetOrientation() );
-        m_plotter->FlashPadCustom( shape_pos, aPad->GetSize(), &polygons, aPlotMode, &gbr_metadata );
+        m_plotter->FlashPadCustom( shape_pos, aSize, &polygons, aPlotMode, &gbr_metadata );
         }
         break;
 
     case PAD_SHAPE_RECT:
     default:
-        m_plotter->FlashPadRect( shape_pos, aPad->GetSize(),
+        m_plotter->FlashPadRect( shape_pos, aSize,
                                  aPad->GetOrientation(), aPlotMode, &gbr_metadata );
         break;
     }
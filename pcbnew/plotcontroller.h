@@ -83,6 +83,16 @@ public:
      */
     bool PlotLayer();
 
+    /**
+     * Plot several layers, each one in its own file named after the board and the layer.
+     * The layers are plotted concurrently, and the current plot, if any, is closed first.
+     * @param aLayers is the list of layers to plot
+     * @param aFormat is the plot file format identifier
+     * @param aSheetDesc
+     * @return true if all the plot files were created
+     */
+    bool PlotLayers( const LSEQ& aLayers, PLOT_FORMAT aFormat, const wxString& aSheetDesc );
+
     /**
      * @return the current plot full filename, set by OpenPlotfile
      */
@@ -28,16 +28,14 @@
  * @brief Class that computes missing connections on a PCB.
  */
 
-#ifdef PROFILE
 #include <profile.h>
-#endif
-
 #include <ratsnest_data.h>
 #include <functional>
 using namespace std::placeholders;
 
 #include <cassert>
 #include <algorithm>
+#include <cmath>
 #include <limits>
 
 static uint64_t getDistance( const CN_ANCHOR_PTR& aNode1, const CN_ANCHOR_PTR& aNode2 )
@@ -55,7 +53,7 @@ static bool sortWeight( const CN_EDGE& aEdge1, const CN_EDGE& aEdge2 )
 }
 
 
-static const std::vector<CN_EDGE> kruskalMST( std::list<CN_EDGE>& aEdges,
+static const std::vector<CN_EDGE> kruskalMST( std::vector<CN_EDGE>& aEdges,
         std::vector<CN_ANCHOR_PTR>& aNodes )
 {
     unsigned int    nodeNumber = aNodes.size();
@@ -66,119 +64,583 @@ static const std::vector<CN_EDGE> kruskalMST( std::list<CN_EDGE>& aEdges,
     // The output
     std::vector<CN_EDGE> mst;
 
-    // Set tags for marking cycles
-    std::unordered_map<CN_ANCHOR_PTR, int> tags;
-    unsigned int tag = 0;
+    // Nodes are referred to by their index, stored in their tag.  If a node is several times
+    // in the list, its last index is used.
+    for( unsigned int i = 0; i < nodeNumber; ++i )
+        aNodes[i]->SetTag( i );
+
+    // Kruskal algorithm requires edges to be sorted by their weight
+    std::stable_sort( aEdges.begin(), aEdges.end(), sortWeight );
 
-    for( auto& node : aNodes )
+    std::vector<int> sources( aEdges.size() );
+    std::vector<int> targets( aEdges.size() );
+
+    for( size_t i = 0; i < aEdges.size(); ++i )
     {
-        node->SetTag( tag );
-        tags[node] = tag++;
+        sources[i] = aEdges[i].GetSourceNode()->GetTag();
+        targets[i] = aEdges[i].GetTargetNode()->GetTag();
     }
 
-    // Lists of nodes connected together (subtrees) to detect cycles in the graph
-    std::vector<std::list<int> > cycles( nodeNumber );
+    // Union-find of the subtrees, to detect cycles in the graph.  The root of a merged subtree
+    // is always the root of the source node subtree, so roots are the same as the tags of the
+    // nodes when the subtrees were merged by moving lists of nodes.
+    std::vector<int> parent( nodeNumber );
 
     for( unsigned int i = 0; i < nodeNumber; ++i )
-        cycles[i].push_back( i );
+        parent[i] = i;
 
-    // Kruskal algorithm requires edges to be sorted by their weight
-    aEdges.sort( sortWeight );
+    auto findRoot =
+            [&parent]( int aNode )
+            {
+                while( parent[aNode] != aNode )
+                {
+                    parent[aNode] = parent[parent[aNode]];      // path halving
+                    aNode = parent[aNode];
+                }
 
-    while( mstSize < mstExpectedSize && !aEdges.empty() )
+                return aNode;
+            };
+
+    // Node tags tell which nodes are connected by the board items (weight == 0)
+    auto tagConnectedNodes =
+            [&]()
+            {
+                for( unsigned int i = 0; i < nodeNumber; ++i )
+                    aNodes[i]->SetTag( findRoot( i ) );
+            };
+
+    for( size_t i = 0; i < aEdges.size() && mstSize < mstExpectedSize; ++i )
     {
-        //printf("mstSize %d %d\n", mstSize, mstExpectedSize);
-        auto& dt = aEdges.front();
+        const CN_EDGE& dt = aEdges[i];
 
-        int srcTag  = tags[dt.GetSourceNode()];
-        int trgTag  = tags[dt.GetTargetNode()];
+        int srcTag = findRoot( sources[i] );
+        int trgTag = findRoot( targets[i] );
 
         // Check if by adding this edge we are going to join two different forests
-        if( srcTag != trgTag )
+        if( srcTag == trgTag )
+            continue;
+
+        // Because edges are sorted by their weight, first we always process connected
+        // items (weight == 0). Once we stumble upon an edge with non-zero weight,
+        // it means that the rest of the lines are ratsnest.
+        if( !ratsnestLines && dt.GetWeight() != 0 )
         {
-            // Because edges are sorted by their weight, first we always process connected
-            // items (weight == 0). Once we stumble upon an edge with non-zero weight,
-            // it means that the rest of the lines are ratsnest.
-            if( !ratsnestLines && dt.GetWeight() != 0 )
-                ratsnestLines = true;
-
-            // Update tags
-            if( ratsnestLines )
-            {
-                for( auto it = cycles[trgTag].begin(); it != cycles[trgTag].end(); ++it )
-                {
-                    tags[aNodes[*it]] = srcTag;
-                }
+            ratsnestLines = true;
+            tagConnectedNodes();
+        }
 
-                // Do a copy of edge, but make it RN_EDGE_MST. In contrary to RN_EDGE,
-                // RN_EDGE_MST saves both source and target node and does not require any other
-                // edges to exist for getting source/target nodes
-                CN_EDGE newEdge ( dt.GetSourceNode(), dt.GetTargetNode(), dt.GetWeight() );
+        if( ratsnestLines )
+        {
+            // Do a copy of edge, but make it RN_EDGE_MST. In contrary to RN_EDGE,
+            // RN_EDGE_MST saves both source and target node and does not require any other
+            // edges to exist for getting source/target nodes
+            CN_EDGE newEdge ( dt.GetSourceNode(), dt.GetTargetNode(), dt.GetWeight() );
 
-                assert( newEdge.GetSourceNode()->GetTag() != newEdge.GetTargetNode()->GetTag() );
-                assert( newEdge.GetWeight() > 0 );
+            assert( newEdge.GetSourceNode()->GetTag() != newEdge.GetTargetNode()->GetTag() );
+            assert( newEdge.GetWeight() > 0 );
 
-                mst.push_back( newEdge );
-                ++mstSize;
-            }
-            else
+            mst.push_back( newEdge );
+            ++mstSize;
+        }
+        else
+        {
+            // Processing a connection, decrease the expected size of the ratsnest MST
+            --mstExpectedSize;
+        }
+
+        parent[trgTag] = srcTag;
+    }
+
+    if( !ratsnestLines )
+        tagConnectedNodes();
+
+    return mst;
+}
+
+
+/**
+ * DELAUNAY
+ * Delaunay triangulation of a set of distinct points, which must not be all colinear.
+ *
+ * The points are inserted in the order of their distance to a seed triangle, so each new
+ * point is outside of the convex hull of the previous ones: it is connected to the hull
+ * edges it can see, then the new triangles are flipped until they are Delaunay (this is
+ * the sweep-hull algorithm of the Delaunator library).  Points, triangles and half-edges
+ * are indexes in flat arrays.
+ */
+class DELAUNAY
+{
+public:
+    /**
+     * @param aCoords are the coordinates of the points: x0, y0, x1, y1, ...
+     */
+    DELAUNAY( const std::vector<double>& aCoords ) :
+            m_coords( aCoords ),
+            m_hullStart( 0 )
+    {
+        triangulate();
+    }
+
+    /**
+     * Function ForEachEdge
+     * calls aFunc( int aPoint1, int aPoint2 ) once for each edge of the triangulation.
+     */
+    template <typename FUNC>
+    void ForEachEdge( FUNC aFunc ) const
+    {
+        for( size_t e = 0; e < m_triangles.size(); e++ )
+        {
+            // Both half-edges of an inner edge are there: only use the first one
+            if( m_halfedges[e] < 0 || (size_t) m_halfedges[e] > e )
+                aFunc( m_triangles[e], m_triangles[nextHalfedge( e )] );
+        }
+    }
+
+private:
+    double x( int aPoint ) const { return m_coords[2 * aPoint]; }
+    double y( int aPoint ) const { return m_coords[2 * aPoint + 1]; }
+
+    static size_t nextHalfedge( size_t e ) { return ( e % 3 == 2 ) ? e - 2 : e + 1; }
+
+    static double dist2( double ax, double ay, double bx, double by )
+    {
+        double dx = ax - bx;
+        double dy = ay - by;
+
+        return dx * dx + dy * dy;
+    }
+
+    ///> True if r is on the right of the p->q line
+    static bool orient( double px, double py, double qx, double qy, double rx, double ry )
+    {
+        return ( qy - py ) * ( rx - qx ) - ( qx - px ) * ( ry - qy ) < 0.0;
+    }
+
+    ///> True if p is inside the circumcircle of the (a, b, c) triangle
+    static bool inCircle( double ax, double ay, double bx, double by, double cx, double cy,
+                          double px, double py )
+    {
+        double dx = ax - px;
+        double dy = ay - py;
+        double ex = bx - px;
+        double ey = by - py;
+        double fx = cx - px;
+        double fy = cy - py;
+
+        double ap = dx * dx + dy * dy;
+        double bp = ex * ex + ey * ey;
+        double cp = fx * fx + fy * fy;
+
+        return dx * ( ey * cp - bp * fy ) - dy * ( ex * cp - bp * fx ) + ap * ( ex * fy - ey * fx )
+               < 0.0;
+    }
+
+    ///> Position of the circumcenter of the (a, b, c) triangle, relative to a
+    static void circumcenter( double ax, double ay, double bx, double by, double cx, double cy,
+                              double& aX, double& aY )
+    {
+        double dx = bx - ax;
+        double dy = by - ay;
+        double ex = cx - ax;
+        double ey = cy - ay;
+
+        double bl = dx * dx + dy * dy;
+        double cl = ex * ex + ey * ey;
+        double d = 0.5 / ( dx * ey - dy * ex );
+
+        aX = ( ey * bl - dy * cl ) * d;
+        aY = ( dx * cl - ex * bl ) * d;
+    }
+
+    static double circumradius2( double ax, double ay, double bx, double by, double cx,
+                                 double cy )
+    {
+        double rx, ry;
+
+        circumcenter( ax, ay, bx, by, cx, cy, rx, ry );
+
+        // Colinear points give an infinite or undefined radius
+        double r2 = rx * rx + ry * ry;
+
+        return std::isfinite( r2 ) ? r2 : std::numeric_limits<double>::max();
+    }
+
+    ///> Monotonic with the angle of (dx, dy), in [0..1]
+    static double pseudoAngle( double dx, double dy )
+    {
+        double p = dx / ( std::abs( dx ) + std::abs( dy ) );
+
+        return ( dy > 0.0 ? 3.0 - p : 1.0 + p ) / 4.0;
+    }
+
+    size_t hashKey( double aX, double aY ) const
+    {
+        double angle = pseudoAngle( aX - m_cx, aY - m_cy );
+
+        return (size_t) std::floor( angle * m_hullHash.size() ) % m_hullHash.size();
+    }
+
+    void link( int a, int b )
+    {
+        m_halfedges[a] = b;
+
+        if( b >= 0 )
+            m_halfedges[b] = a;
+    }
+
+    int addTriangle( int i0, int i1, int i2, int a, int b, int c )
+    {
+        int t = m_triangles.size();
+
+        m_triangles.push_back( i0 );
+        m_triangles.push_back( i1 );
+        m_triangles.push_back( i2 );
+        m_halfedges.resize( t + 3 );
+
+        link( t, a );
+        link( t + 1, b );
+        link( t + 2, c );
+
+        return t;
+    }
+
+    void triangulate();
+    int  legalize( int a );
+
+    const std::vector<double>& m_coords;
+
+    std::vector<int> m_triangles;       // 3 point indexes per triangle
+    std::vector<int> m_halfedges;       // opposite half-edge of each half-edge, or -1
+
+    // The convex hull, as a doubly linked list of points
+    std::vector<int> m_hullPrev;
+    std::vector<int> m_hullNext;
+    std::vector<int> m_hullTri;         // the half-edge of the hull edge starting at a point
+    std::vector<int> m_hullHash;        // hull points by their angle around the center
+    int              m_hullStart;
+
+    std::vector<int> m_edgeStack;
+
+    double           m_cx;
+    double           m_cy;
+};
+
+
+void DELAUNAY::triangulate()
+{
+    const int n = m_coords.size() / 2;
+
+    double minX = std::numeric_limits<double>::max();
+    double minY = std::numeric_limits<double>::max();
+    double maxX = std::numeric_limits<double>::lowest();
+    double maxY = std::numeric_limits<double>::lowest();
+
+    for( int i = 0; i < n; i++ )
+    {
+        minX = std::min( minX, x( i ) );
+        minY = std::min( minY, y( i ) );
+        maxX = std::max( maxX, x( i ) );
+        maxY = std::max( maxY, y( i ) );
+    }
+
+    double cx = ( minX + maxX ) / 2.0;
+    double cy = ( minY + maxY ) / 2.0;
+
+    // The seed triangle: the point closest to the center, the point closest to it, and the
+    // point which makes the smallest circumcircle with them
+    int    i0 = 0;
+    int    i1 = -1;
+    int    i2 = -1;
+    double minDist = std::numeric_limits<double>::max();
+
+    for( int i = 0; i < n; i++ )
+    {
+        double d = dist2( cx, cy, x( i ), y( i ) );
+
+        if( d < minDist )
+        {
+            i0 = i;
+            minDist = d;
+        }
+    }
+
+    minDist = std::numeric_limits<double>::max();
+
+    for( int i = 0; i < n; i++ )
+    {
+        double d = dist2( x( i0 ), y( i0 ), x( i ), y( i ) );
+
+        if( i != i0 && d < minDist )
+        {
+            i1 = i;
+            minDist = d;
+        }
+    }
+
+    double minRadius = std::numeric_limits<double>::max();
+
+    for( int i = 0; i < n; i++ )
+    {
+        if( i == i0 || i == i1 )
+            continue;
+
+        double r = circumradius2( x( i0 ), y( i0 ), x( i1 ), y( i1 ), x( i ), y( i ) );
+
+        if( r < minRadius )
+        {
+            i2 = i;
+            minRadius = r;
+        }
+    }
+
+    if( i1 < 0 || i2 < 0 )
+        return;     // less than 3 points, or all colinear: no triangle
+
+    if( orient( x( i0 ), y( i0 ), x( i1 ), y( i1 ), x( i2 ), y( i2 ) ) )
+        std::swap( i1, i2 );
+
+    circumcenter( x( i0 ), y( i0 ), x( i1 ), y( i1 ), x( i2 ), y( i2 ), m_cx, m_cy );
+    m_cx += x( i0 );
+    m_cy += y( i0 );
+
+    // Sort the points by their distance to the circumcenter of the seed triangle
+    std::vector<double> dists( n );
+    std::vector<int>    ids( n );
+
+    for( int i = 0; i < n; i++ )
+    {
+        dists[i] = dist2( x( i ), y( i ), m_cx, m_cy );
+        ids[i] = i;
+    }
+
+    std::sort( ids.begin(), ids.end(),
+            [&dists]( int a, int b )
             {
-                // for( it = cycles[trgTag].begin(), itEnd = cycles[trgTag].end(); it != itEnd; ++it )
-                // for( auto it : cycles[trgTag] )
-                for( auto it = cycles[trgTag].begin(); it != cycles[trgTag].end(); ++it )
-                {
-                    tags[aNodes[*it]] = srcTag;
-                    aNodes[*it]->SetTag( srcTag );
-                }
+                return dists[a] < dists[b];
+            } );
+
+    m_hullPrev.resize( n );
+    m_hullNext.resize( n );
+    m_hullTri.resize( n );
+    m_hullHash.assign( std::max( 1, (int) std::ceil( std::sqrt( n ) ) ), -1 );
+
+    m_triangles.reserve( std::max( 2 * n - 5, 1 ) * 3 );
+    m_halfedges.reserve( std::max( 2 * n - 5, 1 ) * 3 );
+
+    // The seed triangle is the first hull
+    m_hullStart = i0;
+
+    m_hullNext[i0] = m_hullPrev[i2] = i1;
+    m_hullNext[i1] = m_hullPrev[i0] = i2;
+    m_hullNext[i2] = m_hullPrev[i1] = i0;
+
+    m_hullTri[i0] = 0;
+    m_hullTri[i1] = 1;
+    m_hullTri[i2] = 2;
+
+    m_hullHash[hashKey( x( i0 ), y( i0 ) )] = i0;
+    m_hullHash[hashKey( x( i1 ), y( i1 ) )] = i1;
+    m_hullHash[hashKey( x( i2 ), y( i2 ) )] = i2;
+
+    addTriangle( i0, i1, i2, -1, -1, -1 );
+
+    for( int i : ids )
+    {
+        if( i == i0 || i == i1 || i == i2 )
+            continue;
+
+        double px = x( i );
+        double py = y( i );
 
-                // Processing a connection, decrease the expected size of the ratsnest MST
-                --mstExpectedSize;
+        // Find a hull edge visible from the point, starting from the hull point with the
+        // nearest angle
+        int    start = 0;
+        size_t key = hashKey( px, py );
+
+        for( size_t j = 0; j < m_hullHash.size(); j++ )
+        {
+            start = m_hullHash[( key + j ) % m_hullHash.size()];
+
+            if( start >= 0 && start != m_hullNext[start] )
+                break;
+        }
+
+        start = m_hullPrev[start];
+
+        int e = start;
+        int q = m_hullNext[e];
+
+        while( !orient( px, py, x( e ), y( e ), x( q ), y( q ) ) )
+        {
+            e = q;
+
+            if( e == start )
+            {
+                e = -1;
+                break;
             }
 
-            // Move nodes that were marked with old tag to the list marked with the new tag
-            cycles[srcTag].splice( cycles[srcTag].end(), cycles[trgTag] );
+            q = m_hullNext[e];
         }
 
-        // Remove the edge that was just processed
-        aEdges.erase( aEdges.begin() );
-    }
+        if( e < 0 )
+            continue;   // can only happen with rounding errors on almost coincident points
 
-    // Probably we have discarded some of edges, so reduce the size
-    mst.resize( mstSize );
+        // Add the first triangle from the point
+        int t = addTriangle( e, i, m_hullNext[e], -1, -1, m_hullTri[e] );
 
-    return mst;
+        // Flip the triangles until they satisfy the Delaunay condition
+        m_hullTri[i] = legalize( t + 2 );
+        m_hullTri[e] = t;
+
+        // Walk forward through the hull, adding more triangles and flipping
+        int next = m_hullNext[e];
+        q = m_hullNext[next];
+
+        while( orient( px, py, x( next ), y( next ), x( q ), y( q ) ) )
+        {
+            t = addTriangle( next, i, q, m_hullTri[i], -1, m_hullTri[next] );
+            m_hullTri[i] = legalize( t + 2 );
+            m_hullNext[next] = next;     // removed from the hull
+            next = q;
+            q = m_hullNext[next];
+        }
+
+        // Walk backward from the other side, adding more triangles and flipping
+        if( e == start )
+        {
+            q = m_hullPrev[e];
+
+            while( orient( px, py, x( q ), y( q ), x( e ), y( e ) ) )
+            {
+                t = addTriangle( q, i, e, -1, m_hullTri[e], m_hullTri[q] );
+                legalize( t + 2 );
+                m_hullTri[q] = t;
+                m_hullNext[e] = e;       // removed from the hull
+                e = q;
+                q = m_hullPrev[e];
+            }
+        }
+
+        // Update the hull
+        m_hullStart = m_hullPrev[i] = e;
+        m_hullNext[e] = m_hullPrev[next] = i;
+        m_hullNext[i] = next;
+
+        m_hullHash[hashKey( px, py )] = i;
+        m_hullHash[hashKey( x( e ), y( e ) )] = e;
+    }
 }
 
 
-class RN_NET::TRIANGULATOR_STATE
+int DELAUNAY::legalize( int a )
 {
-private:
-    std::vector<CN_ANCHOR_PTR>  m_allNodes;
+    int ar = 0;
 
-    std::list<hed::EDGE_PTR> hedTriangulation( std::vector<hed::NODE_PTR>& aNodes )
+    m_edgeStack.clear();
+
+    while( true )
     {
-        hed::TRIANGULATION triangulator;
-        triangulator.CreateDelaunay( aNodes.begin(), aNodes.end() );
-        std::list<hed::EDGE_PTR> edges;
-        triangulator.GetEdges( edges );
+        /* If the pair of triangles doesn't satisfy the Delaunay condition (p1 is inside the
+         * circumcircle of [p0, pl, pr]), flip them, then check the new pairs of triangles.
+         *
+         *           pl                    pl
+         *          /||\                  /  \
+         *       al/ || \bl            al/    \a
+         *        /  ||  \              /      \
+         *       /  a||b  \    flip    /___ar___\
+         *     p0\   ||   /p1   =>   p0\---bl---/p1
+         *        \  ||  /              \      /
+         *       ar\ || /br             b\    /br
+         *          \||/                  \  /
+         *           pr                    pr
+         */
+        int b = m_halfedges[a];
+        int a0 = a - a % 3;
+
+        ar = a0 + ( a + 2 ) % 3;
+
+        if( b < 0 )     // convex hull edge
+        {
+            if( m_edgeStack.empty() )
+                break;
+
+            a = m_edgeStack.back();
+            m_edgeStack.pop_back();
+            continue;
+        }
+
+        int b0 = b - b % 3;
+        int al = a0 + ( a + 1 ) % 3;
+        int bl = b0 + ( b + 2 ) % 3;
+
+        int p0 = m_triangles[ar];
+        int pr = m_triangles[a];
+        int pl = m_triangles[al];
+        int p1 = m_triangles[bl];
+
+        if( inCircle( x( p0 ), y( p0 ), x( pr ), y( pr ), x( pl ), y( pl ), x( p1 ), y( p1 ) ) )
+        {
+            m_triangles[a] = p1;
+            m_triangles[b] = p0;
+
+            int hbl = m_halfedges[bl];
+
+            // The flipped edge was on the hull: fix the hull reference to it
+            if( hbl < 0 )
+            {
+                int e = m_hullStart;
 
-        return edges;
+                do
+                {
+                    if( m_hullTri[e] == bl )
+                    {
+                        m_hullTri[e] = a;
+                        break;
+                    }
+
+                    e = m_hullPrev[e];
+                } while( e != m_hullStart );
+            }
+
+            link( a, hbl );
+            link( b, m_halfedges[ar] );
+            link( ar, bl );
+
+            m_edgeStack.push_back( b0 + ( b + 1 ) % 3 );
+        }
+        else
+        {
+            if( m_edgeStack.empty() )
+                break;
+
+            a = m_edgeStack.back();
+            m_edgeStack.pop_back();
+        }
     }
 
+    return ar;
+}
+
+
+class RN_NET::TRIANGULATOR_STATE
+{
+private:
+    std::vector<CN_ANCHOR_PTR>  m_allNodes;
 
     // Checks if all nodes in aNodes lie on a single line. Requires the nodes to
     // have unique coordinates!
-    bool areNodesColinear( const std::vector<hed::NODE_PTR>& aNodes ) const
+    bool areNodesColinear( const std::vector<int>& aNodes ) const
     {
         if ( aNodes.size() <= 2 )
             return true;
 
-        const auto p0 = aNodes[0]->Pos();
-        const auto v0 = aNodes[1]->Pos() - p0;
+        const auto p0 = m_allNodes[ aNodes[0] ]->Pos();
+        const auto v0 = m_allNodes[ aNodes[1] ]->Pos() - p0;
 
         for( unsigned i = 2; i < aNodes.size(); i++ )
         {
-            const auto v1 = aNodes[i]->Pos() - p0;
+            const auto v1 = m_allNodes[ aNodes[i] ]->Pos() - p0;
 
             if( v0.Cross( v1 ) != 0 )
             {
@@ -201,16 +663,19 @@ public:
         m_allNodes.push_back( aNode );
     }
 
-    const std::list<CN_EDGE> Triangulate()
+    std::vector<CN_EDGE> Triangulate()
     {
-        std::list<CN_EDGE> mstEdges;
-        std::list<hed::EDGE_PTR> triangEdges;
-        std::vector<hed::NODE_PTR> triNodes;
+        std::vector<CN_EDGE> mstEdges;
+
+        // The first node at each distinct position, and the coordinates of these positions
+        std::vector<int>    triNodes;
+        std::vector<double> triCoords;
 
         using ANCHOR_LIST = std::vector<CN_ANCHOR_PTR>;
         std::vector<ANCHOR_LIST> anchorChains;
 
         triNodes.reserve( m_allNodes.size() );
+        triCoords.reserve( m_allNodes.size() * 2 );
         anchorChains.resize( m_allNodes.size() );
 
         std::sort( m_allNodes.begin(), m_allNodes.end(),
@@ -227,17 +692,16 @@ public:
         }
                 );
 
-        CN_ANCHOR_PTR prev, last;
+        CN_ANCHOR_PTR prev;
         int id = 0;
 
         for( const auto& n : m_allNodes )
         {
             if( !prev || prev->Pos() != n->Pos() )
             {
-                auto tn = std::make_shared<hed::NODE> ( n->Pos().x, n->Pos().y );
-
-                tn->SetId( id );
-                triNodes.push_back( tn );
+                triNodes.push_back( id );
+                triCoords.push_back( n->Pos().x );
+                triCoords.push_back( n->Pos().y );
             }
 
             id++;
@@ -246,12 +710,12 @@ public:
 
         int prevId = 0;
 
-        for( const auto& n : triNodes )
+        for( int n : triNodes )
         {
-            for( int i = prevId; i < n->Id(); i++ )
+            for( int i = prevId; i < n; i++ )
                 anchorChains[prevId].push_back( m_allNodes[ i ] );
 
-            prevId = n->Id();
+            prevId = n;
         }
 
         for( int i = prevId; i < id; i++ )
@@ -268,24 +732,23 @@ public:
             // and chain the nodes together.
             for(int i = 0; i < (int)triNodes.size() - 1; i++ )
             {
-                auto src = m_allNodes[ triNodes[i]->Id() ];
-                auto dst = m_allNodes[ triNodes[i + 1]->Id() ];
+                auto src = m_allNodes[ triNodes[i] ];
+                auto dst = m_allNodes[ triNodes[i + 1] ];
                 mstEdges.emplace_back( src, dst, getDistance( src, dst ) );
             }
         }
         else
         {
-            hed::TRIANGULATION triangulator;
-            triangulator.CreateDelaunay( triNodes.begin(), triNodes.end() );
-            triangulator.GetEdges( triangEdges );
+            DELAUNAY triangulation( triCoords );
 
-            for( const auto& e : triangEdges )
-            {
-                auto    src = m_allNodes[ e->GetSourceNode()->Id() ];
-                auto    dst = m_allNodes[ e->GetTargetNode()->Id() ];
+            triangulation.ForEachEdge(
+                    [&]( int aSource, int aTarget )
+                    {
+                        auto src = m_allNodes[ triNodes[aSource] ];
+                        auto dst = m_allNodes[ triNodes[aTarget] ];
 
-                mstEdges.emplace_back( src, dst, getDistance( src, dst ) );
-            }
+                        mstEdges.emplace_back( src, dst, getDistance( src, dst ) );
+                    } );
         }
 
         for( unsigned int i = 0; i < anchorChains.size(); i++ )
@@ -358,25 +821,18 @@ void RN_NET::compute()
         m_triangulator->AddNode( n );
     }
 
-    #ifdef PROFILE
-    PROF_COUNTER cnt("triangulate");
-    #endif
-    auto triangEdges = m_triangulator->Triangulate();
-    #ifdef PROFILE
-    cnt.Show();
-    #endif
-
-    for( const auto& e : m_boardEdges )
-        triangEdges.push_back( e );
-
-// Get the minimal spanning tree
-#ifdef PROFILE
-    PROF_COUNTER cnt2("mst");
-#endif
+    std::vector<CN_EDGE> triangEdges;
+
+    {
+        PROF_SCOPE triangulation( "ratsnest-triangulate" );
+        triangEdges = m_triangulator->Triangulate();
+    }
+
+    triangEdges.insert( triangEdges.end(), m_boardEdges.begin(), m_boardEdges.end() );
+
+    // Get the minimal spanning tree
+    PROF_SCOPE mst( "ratsnest-mst" );
     m_rnEdges = kruskalMST( triangEdges, m_nodes );
-#ifdef PROFILE
-    cnt2.Show();
-#endif
 }
 
 
@@ -37,9 +37,6 @@
 #include <unordered_set>
 #include <unordered_map>
 
-#include <ttl/halfedge/hetriang.h>
-#include <ttl/halfedge/hetraits.h>
-
 #include <connectivity/connectivity_algo.h>
 
 class BOARD;
@@ -122,6 +119,15 @@ public:
      */
     std::list<CN_ANCHOR_PTR> GetNodes( const BOARD_CONNECTED_ITEM* aItem ) const;
 
+    /**
+     * Function GetNodes()
+     * Returns all the nodes of the net.
+     */
+    const std::vector<CN_ANCHOR_PTR>& GetNodes() const
+    {
+        return m_nodes;
+    }
+
     const std::vector<CN_EDGE>& GetEdges() const
     {
         return m_rnEdges;
@@ -30,6 +30,7 @@
 #include <gal/color4d.h>
 
 #include <pgm_base.h>
+#include <profile.h>
 #include <settings/settings_manager.h>
 
 #include <pcb_painter.h>
@@ -130,6 +131,7 @@ const ITEM_SET ROUTER::QueryHoverItems( const VECTOR2I& aP )
 
 bool ROUTER::StartDragging( const VECTOR2I& aP, ITEM* aStartItem, int aDragMode )
 {
+    PROF_SCOPE profScope( "router-start-dragging" );
 
     if( aDragMode & DM_FREE_ANGLE )
         m_forceMarkObstaclesMode = true;
@@ -179,6 +181,7 @@ bool ROUTER::isStartingPointRoutable( const VECTOR2I& aWhere, int aLayer )
 
 bool ROUTER::StartRouting( const VECTOR2I& aP, ITEM* aStartItem, int aLayer )
 {
+    PROF_SCOPE profScope( "router-start-routing" );
 
     if( ! isStartingPointRoutable( aP, aLayer ) )
     {
@@ -234,6 +237,8 @@ void ROUTER::DisplayItems( const ITEM_SET& aItems )
 
 void ROUTER::Move( const VECTOR2I& aP, ITEM* endItem )
 {
+    PROF_SCOPE profScope( "router-move" );
+
     m_currentEnd = aP;
 
     switch( m_state )
@@ -377,6 +382,8 @@ void ROUTER::CommitRouting( NODE* aNode )
 
 bool ROUTER::FixRoute( const VECTOR2I& aP, ITEM* aEndItem, bool aForceFinish )
 {
+    PROF_SCOPE profScope( "router-fix-route" );
+
     bool rv = false;
 
     switch( m_state )
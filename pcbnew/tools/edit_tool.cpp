@@ -385,7 +385,7 @@ int EDIT_TOOL::Move( const TOOL_EVENT& aEvent )
                         if( item->GetParent() && item->GetParent()->IsSelected() )
                             continue;
 
-                        m_commit->Modify( item );
+                        m_commit->ModifyForMove( item );
                     }
                 }
 
@@ -627,6 +627,10 @@ int EDIT_TOOL::Rotate( const TOOL_EVENT& aEvent )
     auto refPt = selection.GetReferencePoint();
     const int rotateAngle = TOOL_EVT_UTILS::GetEventRotationAngle( *editFrame, aEvent );
 
+    // A rotation by a multiple of 90 degrees is exact, so it is undone by rotating the items
+    // back, without keeping copies of them
+    const bool exactRotation = rotateAngle % 900 == 0;
+
     // When editing modules, all items have the same parent
     if( EditingModules() )
         m_commit->Modify( selection.Front() );
@@ -634,7 +638,12 @@ int EDIT_TOOL::Rotate( const TOOL_EVENT& aEvent )
     for( auto item : selection )
     {
         if( !item->IsNew() && !EditingModules() )
-            m_commit->Modify( item );
+        {
+            if( exactRotation )
+                m_commit->ModifyForRotate( item, (wxPoint) refPt, rotateAngle );
+            else
+                m_commit->Modify( item );
+        }
 
         static_cast<BOARD_ITEM*>( item )->Rotate( refPt, rotateAngle );
     }
@@ -808,8 +817,9 @@ int EDIT_TOOL::Flip( const TOOL_EVENT& aEvent )
 
     for( EDA_ITEM* item : selection )
     {
+        // A flip is undone by flipping the items again, without keeping copies of them
         if( !item->IsNew() && !EditingModules() )
-            m_commit->Modify( item );
+            m_commit->ModifyForFlip( item, (wxPoint) modPoint, leftRight );
 
         static_cast<BOARD_ITEM*>( item )->Flip( modPoint, leftRight );
     }
@@ -40,6 +40,7 @@ PCB_INSPECTION_TOOL::PCB_INSPECTION_TOOL() :
     m_lastNetcode = -1;
 
     m_slowRatsnest = false;
+    m_ratsnestPrepared = false;
 }
 
 
@@ -147,10 +148,14 @@ int PCB_INSPECTION_TOOL::HighlightItem( const TOOL_EVENT& aEvent )
         GENERAL_COLLECTOR collector;
 
         // Find a connected item for which we are going to highlight a net
-        collector.Collect( board, GENERAL_COLLECTOR::PadsOrTracks, (wxPoint) aPosition, guide );
+        collector.Collect( board, GENERAL_COLLECTOR::PadsOrTracks, (wxPoint) aPosition, guide,
+                           getView() );
 
         if( collector.GetCount() == 0 )
-            collector.Collect( board, GENERAL_COLLECTOR::Zones, (wxPoint) aPosition, guide );
+        {
+            collector.Collect( board, GENERAL_COLLECTOR::Zones, (wxPoint) aPosition, guide,
+                               getView() );
+        }
 
         // Clear the previous highlight
         m_frame->SendMessageToEESCHEMA( nullptr );
@@ -371,6 +376,8 @@ int PCB_INSPECTION_TOOL::UpdateSelectionRatsnest( const TOOL_EVENT& aEvent )
     if( selection.Empty() )
     {
         connectivity->ClearDynamicRatsnest();
+        m_ratsnestPrepared = false;
+        m_ratsnestItems.clear();
     }
     else if( m_slowRatsnest )
     {
@@ -385,13 +392,17 @@ int PCB_INSPECTION_TOOL::UpdateSelectionRatsnest( const TOOL_EVENT& aEvent )
         calculateSelectionRatsnest();
         counter.Stop();
 
-        // If it is too slow, then switch to 'slow ratsnest' mode when
-        // ratsnest is calculated when user stops dragging items for a moment
-        if( counter.msecs() > 25 )
+        // The first update of a move prepares the ratsnest of the moved items, the next
+        // ones only follow them and must fit in a frame.  If they are too slow, then switch
+        // to 'slow ratsnest' mode when ratsnest is calculated when user stops dragging items
+        // for a moment
+        if( m_ratsnestPrepared && counter.msecs() > 25 )
         {
             m_slowRatsnest = true;
             connectivity->HideDynamicRatsnest();
         }
+
+        m_ratsnestPrepared = true;
     }
 
     return 0;
@@ -402,6 +413,8 @@ int PCB_INSPECTION_TOOL::HideDynamicRatsnest( const TOOL_EVENT& aEvent )
 {
     getModel<BOARD>()->GetConnectivity()->HideDynamicRatsnest();
     m_slowRatsnest = false;
+    m_ratsnestPrepared = false;
+    m_ratsnestItems.clear();
     return 0;
 }
 
@@ -440,6 +453,13 @@ void PCB_INSPECTION_TOOL::calculateSelectionRatsnest()
         }
     }
 
+    // A different set of items is prepared again: this first update is not a move
+    if( items != m_ratsnestItems )
+    {
+        m_ratsnestPrepared = false;
+        m_ratsnestItems = items;
+    }
+
     connectivity->ComputeDynamicRatsnest( items );
 }
 
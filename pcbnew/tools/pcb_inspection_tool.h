@@ -101,6 +101,8 @@ private:
     int  m_lastNetcode;         // Used for toggling between last two highlighted nets
 
     bool m_slowRatsnest;        // Indicates current selection ratsnest will be slow to calculate
+    bool m_ratsnestPrepared;    // The dynamic ratsnest of the moved items has been prepared
+    std::vector<BOARD_ITEM*> m_ratsnestItems;   // The items the ratsnest was prepared for
     wxTimer m_ratsnestTimer;    // Timer to initiate lazy ratsnest calculation (ie: when slow)
 };
 
@@ -98,6 +98,12 @@ using namespace std::placeholders;
  *      move list of items (undo/redo is made by moving with the opposite move vector)
  *      mirror (Y) and flip list of items (undo/redo is made by mirror or flip items)
  *      so they are handled specifically.
+ *   The items moved by the move tool are stored this way (see COMMIT::ModifyForMove()), and
+ *   the items rotated by a multiple of 90 degrees or flipped by the edit tool (see
+ *   COMMIT::ModifyForRotate() and COMMIT::ModifyForFlip()), the list keeping the angle
+ *   and the direction of the command.
+ *   Copies of zones share the filled areas of the zone until one of them changes them,
+ *   so a copy of a zone in the undo list does not duplicate its fill.
  *
  */
 
@@ -197,6 +203,8 @@ void PCB_BASE_EDIT_FRAME::SaveCopyInUndoList( const PICKED_ITEMS_LIST& aItemsLis
     PICKED_ITEMS_LIST* commandToUndo = new PICKED_ITEMS_LIST();
 
     commandToUndo->m_TransformPoint = aTransformPoint;
+    commandToUndo->m_TransformAngle = aItemsList.m_TransformAngle;
+    commandToUndo->m_TransformFlipLeftRight = aItemsList.m_TransformFlipLeftRight;
 
     // First, filter unnecessary stuff from the list (i.e. for multiple pads / labels modified),
     // take the first occurence of the module (we save copies of modules when one of its subitems
@@ -503,7 +511,7 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool
         {
             BOARD_ITEM* item = (BOARD_ITEM*) eda_item;
             item->Rotate( aList->m_TransformPoint,
-                          aRedoCommand ? m_rotationAngle : -m_rotationAngle );
+                          aRedoCommand ? aList->m_TransformAngle : -aList->m_TransformAngle );
             view->Update( item, KIGFX::GEOMETRY );
             connectivity->Update( item );
         }
@@ -513,7 +521,7 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool
         {
             BOARD_ITEM* item = (BOARD_ITEM*) eda_item;
             item->Rotate( aList->m_TransformPoint,
-                          aRedoCommand ? -m_rotationAngle : m_rotationAngle );
+                          aRedoCommand ? -aList->m_TransformAngle : aList->m_TransformAngle );
             view->Update( item, KIGFX::GEOMETRY );
             connectivity->Update( item );
         }
@@ -522,8 +530,8 @@ void PCB_BASE_EDIT_FRAME::PutDataInPreviousState( PICKED_ITEMS_LIST* aList, bool
         case UR_FLIPPED:
         {
             BOARD_ITEM* item = (BOARD_ITEM*) eda_item;
-            item->Flip( aList->m_TransformPoint, m_Settings->m_FlipLeftRight );
-            view->Update( item, KIGFX::LAYERS );
+            item->Flip( aList->m_TransformPoint, aList->m_TransformFlipLeftRight );
+            view->Update( item, KIGFX::LAYERS | KIGFX::GEOMETRY );
             connectivity->Update( item );
         }
             break;
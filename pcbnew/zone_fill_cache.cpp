@@ -0,0 +1,164 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <zone_fill_cache.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <wx/dir.h>
+#include <wx/ffile.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+#include <wx/log.h>
+
+#include <geometry/shape_poly_set.h>
+#include <zone_fill_encoding.h>
+
+
+static const wxChar FolderName[] = wxT( "zone-fill-cache" );
+static const wxChar EntryExtension[] = wxT( "fill" );
+
+
+ZONE_FILL_CACHE::ZONE_FILL_CACHE( const wxString& aBoardFileName )
+{
+    if( aBoardFileName.IsEmpty() )
+        return;
+
+    wxString folder = wxFileName( aBoardFileName ).GetPath();
+
+    if( !folder.IsEmpty() )
+        folder += wxFileName::GetPathSeparator();
+
+    folder += FolderName;
+
+    if( !wxFileName::DirExists( folder ) )
+    {
+        // A read only board folder only disables the cache, without error messages
+        wxLogNull doNotLog;
+
+        if( !wxFileName::Mkdir( folder, wxS_DIR_DEFAULT ) )
+            return;
+    }
+
+    m_folder = folder;
+}
+
+
+wxString ZONE_FILL_CACHE::entryFileName( const std::string& aKey ) const
+{
+    wxFileName fn( m_folder, wxString::FromUTF8( aKey.c_str() ), EntryExtension );
+    return fn.GetFullPath();
+}
+
+
+bool ZONE_FILL_CACHE::Find( const std::string& aKey, SHAPE_POLY_SET& aFill ) const
+{
+    if( !IsValid() || aKey.empty() )
+        return false;
+
+    wxString fileName = entryFileName( aKey );
+
+    if( !wxFileName::FileExists( fileName ) )
+        return false;
+
+    std::string encoded;
+
+    {
+        wxFFile file( fileName, wxT( "rb" ) );
+
+        if( !file.IsOpened() || file.Length() <= 0 )
+            return false;
+
+        encoded.resize( file.Length() );
+
+        if( file.Read( &encoded[0], encoded.size() ) != encoded.size() )
+            return false;
+    }
+
+    SHAPE_POLY_SET fill;
+
+    if( !DecodeZoneFill( encoded, fill ) )
+        return false;
+
+    // The modification time orders the entries for Prune(): mark this one as recently used
+    wxFileName( fileName ).Touch();
+
+    aFill = fill;
+    return true;
+}
+
+
+void ZONE_FILL_CACHE::Store( const std::string& aKey, const SHAPE_POLY_SET& aFill ) const
+{
+    if( !IsValid() || aKey.empty() )
+        return;
+
+    // The fill is written to a temporary file, then renamed: another thread or another
+    // instance of Pcbnew never reads a partially written entry.
+    wxString tmpName = wxFileName::CreateTempFileName( m_folder + wxFileName::GetPathSeparator()
+                                                       + wxT( "tmp" ) );
+
+    if( tmpName.IsEmpty() )
+        return;
+
+    std::string encoded = EncodeZoneFill( aFill );
+    bool        written = false;
+
+    {
+        wxFFile file( tmpName, wxT( "wb" ) );
+
+        if( file.IsOpened() )
+        {
+            written = file.Write( encoded.data(), encoded.size() ) == encoded.size();
+            written = file.Close() && written;
+        }
+    }
+
+    if( !written || !wxRenameFile( tmpName, entryFileName( aKey ), true ) )
+        wxRemoveFile( tmpName );
+}
+
+
+void ZONE_FILL_CACHE::Prune() const
+{
+    if( !IsValid() )
+        return;
+
+    wxArrayString files;
+    wxDir::GetAllFiles( m_folder, &files, wxString( wxT( "*." ) ) + EntryExtension, wxDIR_FILES );
+
+    if( files.size() <= MaxEntries )
+        return;
+
+    std::vector<std::pair<time_t, wxString>> entries;
+
+    for( const wxString& file : files )
+        entries.emplace_back( wxFileName( file ).GetModificationTime().GetTicks(), file );
+
+    std::sort( entries.begin(), entries.end() );
+
+    for( size_t ii = 0; ii < entries.size() - MaxEntries; ++ii )
+        wxRemoveFile( entries[ii].second );
+}
@@ -0,0 +1,85 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef ZONE_FILL_CACHE_H
+#define ZONE_FILL_CACHE_H
+
+#include <string>
+
+#include <wx/string.h>
+
+class SHAPE_POLY_SET;
+
+
+/**
+ * ZONE_FILL_CACHE
+ * keeps zone fills on disk, in a zone-fill-cache folder next to the board file, so that a
+ * zone filled again with the same inputs (after reopening the board, switching to another
+ * revision of it, or from a script) reuses its previous fill instead of computing it again.
+ *
+ * Each fill is stored in its own file, named after a key which is a hash of everything the
+ * fill depends on, built by ZONE_FILLER: a fill is never updated, a zone with other inputs
+ * has another key.  The files are written with EncodeZoneFill(), and the least recently used
+ * ones are removed when there are more than MaxEntries of them.
+ */
+class ZONE_FILL_CACHE
+{
+public:
+    ///> The maximum number of fills kept in the folder
+    static const size_t MaxEntries = 2000;
+
+    /**
+     * @param aBoardFileName is the full path of the board file.  The cache is not usable
+     * (IsValid() returns false) if it is empty, i.e. for a board never saved.
+     */
+    ZONE_FILL_CACHE( const wxString& aBoardFileName );
+
+    bool IsValid() const { return !m_folder.IsEmpty(); }
+
+    /**
+     * Function Find
+     * reads the fill stored for \a aKey in \a aFill.  Can be called from several threads.
+     * @return false if no valid fill is stored for \a aKey.
+     */
+    bool Find( const std::string& aKey, SHAPE_POLY_SET& aFill ) const;
+
+    /**
+     * Function Store
+     * stores \a aFill for \a aKey.  Can be called from several threads.  The errors are
+     * ignored: the fill will only be computed again next time.
+     */
+    void Store( const std::string& aKey, const SHAPE_POLY_SET& aFill ) const;
+
+    /**
+     * Function Prune
+     * removes the least recently used fills when the folder holds more than MaxEntries.
+     */
+    void Prune() const;
+
+private:
+    wxString entryFileName( const std::string& aKey ) const;
+
+    wxString m_folder;
+};
+
+#endif  // ZONE_FILL_CACHE_H
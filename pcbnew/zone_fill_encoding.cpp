@@ -0,0 +1,207 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <zone_fill_encoding.h>
+
+#include <cstdint>
+#include <vector>
+
+#include <wx/mstream.h>
+#include <wx/zstream.h>
+
+#include <base64.h>
+#include <geometry/shape_poly_set.h>
+
+
+namespace
+{
+
+/// Version of the encoded data, for future changes of the encoding
+const uint64_t FormatVersion = 1;
+
+
+void putVarint( std::vector<uint8_t>& aOut, uint64_t aValue )
+{
+    while( aValue >= 0x80 )
+    {
+        aOut.push_back( uint8_t( aValue ) | 0x80 );
+        aValue >>= 7;
+    }
+
+    aOut.push_back( uint8_t( aValue ) );
+}
+
+
+// Zigzag encoding: the small negative values are encoded in a few bytes, as the positive ones
+void putSigned( std::vector<uint8_t>& aOut, int64_t aValue )
+{
+    putVarint( aOut, ( uint64_t( aValue ) << 1 ) ^ uint64_t( aValue >> 63 ) );
+}
+
+
+bool getVarint( const uint8_t*& aIn, const uint8_t* aEnd, uint64_t& aValue )
+{
+    aValue = 0;
+
+    for( int shift = 0; shift < 64; shift += 7 )
+    {
+        if( aIn == aEnd )
+            return false;
+
+        uint8_t byte = *aIn++;
+        aValue |= uint64_t( byte & 0x7F ) << shift;
+
+        if( !( byte & 0x80 ) )
+            return true;
+    }
+
+    return false;
+}
+
+
+bool getSigned( const uint8_t*& aIn, const uint8_t* aEnd, int64_t& aValue )
+{
+    uint64_t value;
+
+    if( !getVarint( aIn, aEnd, value ) )
+        return false;
+
+    aValue = int64_t( value >> 1 ) ^ -int64_t( value & 1 );
+    return true;
+}
+
+}
+
+
+std::string EncodeZoneFill( const SHAPE_POLY_SET& aFill )
+{
+    std::vector<uint8_t> raw;
+    int64_t              prevX = 0;
+    int64_t              prevY = 0;
+
+    putVarint( raw, FormatVersion );
+    putVarint( raw, aFill.OutlineCount() );
+
+    for( int ii = 0; ii < aFill.OutlineCount(); ++ii )
+    {
+        const SHAPE_LINE_CHAIN& outline = aFill.COutline( ii );
+
+        putVarint( raw, outline.PointCount() );
+
+        for( int jj = 0; jj < outline.PointCount(); ++jj )
+        {
+            const VECTOR2I& pt = outline.CPoint( jj );
+
+            putSigned( raw, pt.x - prevX );
+            putSigned( raw, pt.y - prevY );
+            prevX = pt.x;
+            prevY = pt.y;
+        }
+    }
+
+    wxMemoryOutputStream memos;
+
+    {
+        wxZlibOutputStream zos( memos, wxZ_DEFAULT_COMPRESSION, wxZLIB_ZLIB );
+
+        zos.Write( raw.data(), raw.size() );
+    }   // flush the zip stream using zos destructor
+
+    wxStreamBuffer*      sb = memos.GetOutputStreamBuffer();
+    const uint8_t*       start = static_cast<const uint8_t*>( sb->GetBufferStart() );
+    std::vector<uint8_t> compressed( start, start + sb->Tell() );
+    std::vector<uint8_t> encoded;
+
+    base64::encode( compressed, encoded );
+
+    return std::string( encoded.begin(), encoded.end() );
+}
+
+
+bool DecodeZoneFill( const std::string& aEncoded, SHAPE_POLY_SET& aFill )
+{
+    std::vector<uint8_t> encoded( aEncoded.begin(), aEncoded.end() );
+    std::vector<uint8_t> compressed;
+
+    if( !base64::decode( encoded, compressed ) || compressed.empty() )
+        return false;
+
+    std::vector<uint8_t> raw;
+
+    {
+        wxMemoryInputStream mis( compressed.data(), compressed.size() );
+        wxZlibInputStream   zis( mis, wxZLIB_ZLIB );
+        uint8_t             buffer[65536];
+
+        do
+        {
+            zis.Read( buffer, sizeof( buffer ) );
+            raw.insert( raw.end(), buffer, buffer + zis.LastRead() );
+        } while( zis.LastRead() > 0 && zis.IsOk() );
+
+        // A valid stream is read until its end, without error
+        if( zis.GetLastError() != wxSTREAM_EOF )
+            return false;
+    }
+
+    const uint8_t* in = raw.data();
+    const uint8_t* end = in + raw.size();
+    uint64_t       version;
+    uint64_t       outlineCount;
+    int64_t        x = 0;
+    int64_t        y = 0;
+
+    if( !getVarint( in, end, version ) || version != FormatVersion )
+        return false;
+
+    // Each outline takes at least one byte: do not trust bigger counts
+    if( !getVarint( in, end, outlineCount ) || outlineCount > uint64_t( end - in ) )
+        return false;
+
+    for( uint64_t ii = 0; ii < outlineCount; ++ii )
+    {
+        uint64_t         pointCount;
+        SHAPE_LINE_CHAIN outline;
+
+        // Each point takes at least two bytes
+        if( !getVarint( in, end, pointCount ) || pointCount > uint64_t( end - in ) / 2 )
+            return false;
+
+        for( uint64_t jj = 0; jj < pointCount; ++jj )
+        {
+            int64_t dx, dy;
+
+            if( !getSigned( in, end, dx ) || !getSigned( in, end, dy ) )
+                return false;
+
+            x += dx;
+            y += dy;
+            outline.Append( int( x ), int( y ) );
+        }
+
+        outline.SetClosed( true );
+        aFill.AddOutline( outline );
+    }
+
+    return in == end;
+}
@@ -0,0 +1,62 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file zone_fill_encoding.h
+ * @brief Compact encoding of the filled polygons of the zones, used by the
+ * (filled_polygon_data ...) blocks of the board files.
+ *
+ * The filled polygons of a zone usually have thousands of points.  Written as
+ * (filled_polygon (pts (xy 123.456789 45.678901) ...)) each point takes about 30 bytes and
+ * must be tokenized and converted from text.  The encoding stores instead:
+ *  - each coordinate as the difference with the previous point, zigzag and varint encoded:
+ *    1 to 3 bytes for the short edges of the fills,
+ *  - the whole compressed with zlib, then written in base64 to keep the board file a text
+ *    file.
+ *
+ * The fills take then typically 10 to 20 times less space, and are read several times faster.
+ */
+
+#ifndef ZONE_FILL_ENCODING_H
+#define ZONE_FILL_ENCODING_H
+
+#include <string>
+
+class SHAPE_POLY_SET;
+
+
+/**
+ * Function EncodeZoneFill
+ * @return the outlines of \a aFill encoded in base64 (holes are not encoded: the zone fills
+ * are fractured, they have no holes).
+ */
+std::string EncodeZoneFill( const SHAPE_POLY_SET& aFill );
+
+/**
+ * Function DecodeZoneFill
+ * appends to \a aFill the outlines encoded by EncodeZoneFill() in \a aEncoded.
+ * @return false if \a aEncoded is not a valid encoded zone fill.
+ */
+bool DecodeZoneFill( const std::string& aEncoded, SHAPE_POLY_SET& aFill );
+
+#endif  // ZONE_FILL_ENCODING_H
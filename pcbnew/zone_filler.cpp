@@ -45,6 +45,12 @@
 #include <confirm.h>
 #include <convert_to_biu.h>
 #include <math/util.h>      // for KiROUND
+#include <advanced_config.h>
+#include <base_units.h>
+#include <build_version.h>
+#include <kicad_plugin.h>
+#include <profile.h>
+#include <zone_fill_cache.h>
 
 #include "zone_filler.h"
 
@@ -100,6 +106,7 @@ void ZONE_FILLER::InstallNewProgressReporter( wxWindow* aParent, const wxString&
 
 bool ZONE_FILLER::Fill( const std::vector<ZONE_CONTAINER*>& aZones, bool aCheck )
 {
+    PROF_SCOPE profScope( "zone-fill" );
     std::vector<CN_ZONE_ISOLATED_ISLAND_LIST> toFill;
     auto connectivity = m_board->GetConnectivity();
     bool filledPolyWithOutline = not m_board->GetDesignSettings().m_ZoneUseNoOutlineInFill;
@@ -145,6 +152,65 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE_CONTAINER*>& aZones, bool aCheck
             std::min<size_t>( std::thread::hardware_concurrency(), aZones.size() );
     std::vector<std::future<size_t>> returns( parallelThreadCount );
 
+    // With the fill cache enabled, the key and the cached fill, if any, of each zone of toFill
+    // (isCached is a vector<char> rather than a vector<bool>: it is written by several threads)
+    std::unique_ptr<ZONE_FILL_CACHE> cache;
+    std::vector<std::string>         cacheKeys( toFill.size() );
+    std::vector<SHAPE_POLY_SET>      cachedFills( toFill.size() );
+    std::vector<char>                isCached( toFill.size(), false );
+    std::atomic<bool>                cacheUpdated( false );
+
+    if( ADVANCED_CFG::GetCfg().m_zoneFillCache )
+    {
+        cache = std::make_unique<ZONE_FILL_CACHE>( m_board->GetFileName() );
+
+        if( !cache->IsValid() )
+            cache.reset();
+    }
+
+    auto cache_lambda = [&] ( PROGRESS_REPORTER* aReporter ) -> size_t
+    {
+        size_t num = 0;
+
+        for( size_t i = nextItem++; i < toFill.size(); i = nextItem++ )
+        {
+            PROF_SCOPE profZone( "zone-fill-cache-lookup", toFill[i].m_zone->GetNetCode() );
+            cacheKeys[i] = BuildFillCacheKey( toFill[i].m_zone );
+            isCached[i] = cache->Find( cacheKeys[i], cachedFills[i] );
+            num++;
+        }
+
+        return num;
+    };
+
+    // The keys are all built before filling any zone: the fill temporarily moves the pads (see
+    // buildThermalSpokes()), which would change the keys of the zones built meanwhile.
+    if( cache )
+    {
+        if( parallelThreadCount <= 1 )
+            cache_lambda( m_progressReporter );
+        else
+        {
+            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+                returns[ii] = std::async( std::launch::async, cache_lambda, m_progressReporter );
+
+            for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+            {
+                // Here we balance returns with a 100ms timeout to allow UI updating
+                std::future_status status;
+                do
+                {
+                    if( m_progressReporter )
+                        m_progressReporter->KeepRefreshing();
+
+                    status = returns[ii].wait_for( std::chrono::milliseconds( 100 ) );
+                } while( status != std::future_status::ready );
+            }
+        }
+
+        nextItem = 0;
+    }
+
     auto fill_lambda = [&] ( PROGRESS_REPORTER* aReporter ) -> size_t
     {
         size_t num = 0;
@@ -152,9 +218,28 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE_CONTAINER*>& aZones, bool aCheck
         for( size_t i = nextItem++; i < toFill.size(); i = nextItem++ )
         {
             ZONE_CONTAINER* zone = toFill[i].m_zone;
+            PROF_SCOPE      profZone( "zone-fill-zone", zone->GetNetCode() );
             zone->SetFilledPolysUseThickness( filledPolyWithOutline );
             SHAPE_POLY_SET rawPolys, finalPolys;
-            fillSingleZone( zone, rawPolys, finalPolys );
+
+            if( isCached[i] )
+            {
+                // The raw polygons are not cached: they are only used while filling, and are
+                // the final polygons for the copper zones
+                finalPolys = std::move( cachedFills[i] );
+                rawPolys = finalPolys;
+                zone->SetNeedRefill( false );
+            }
+            else
+            {
+                fillSingleZone( zone, rawPolys, finalPolys );
+
+                if( cache )
+                {
+                    cache->Store( cacheKeys[i], finalPolys );
+                    cacheUpdated = true;
+                }
+            }
 
             zone->SetRawPolysList( rawPolys );
             zone->SetFilledPolysList( finalPolys );
@@ -190,6 +275,9 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE_CONTAINER*>& aZones, bool aCheck
         }
     }
 
+    if( cacheUpdated )
+        cache->Prune();
+
     // Now update the connectivity to check for copper islands
     if( m_progressReporter )
     {
@@ -199,7 +287,11 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE_CONTAINER*>& aZones, bool aCheck
     }
 
     connectivity->SetProgressReporter( m_progressReporter );
-    connectivity->FindIsolatedCopperIslands( toFill );
+
+    {
+        PROF_SCOPE profIslands( "zone-fill-islands" );
+        connectivity->FindIsolatedCopperIslands( toFill );
+    }
 
     // Now remove insulated copper islands and islands outside the board edge
     bool outOfDate = false;
@@ -283,6 +375,7 @@ bool ZONE_FILLER::Fill( const std::vector<ZONE_CONTAINER*>& aZones, bool aCheck
 
         for( size_t i = nextItem++; i < toFill.size(); i = nextItem++ )
         {
+            PROF_SCOPE profZone( "zone-fill-triangulation", toFill[i].m_zone->GetNetCode() );
             toFill[i].m_zone->CacheTriangulation();
             num++;
 
@@ -897,6 +990,161 @@ bool ZONE_FILLER::fillSingleZone( ZONE_CONTAINER* aZone, SHAPE_POLY_SET& aRawPol
 }
 
 
+std::string ZONE_FILLER::BuildFillCacheKey( const ZONE_CONTAINER* aZone ) const
+{
+    BOARD_DESIGN_SETTINGS& bds = m_board->GetDesignSettings();
+    STRING_FORMATTER       out;
+    int                    netCode = aZone->GetNetCode();
+
+    // The nets are described by their relation to the zone net: the net codes change when
+    // nets are added to the board, the fill does not
+    auto sameNet = [&]( const BOARD_CONNECTED_ITEM* aItem )
+    {
+        return netCode > 0 && aItem->GetNetCode() == netCode;
+    };
+
+    // The items which can change the fill are near the zone (see buildCopperItemClearances())
+    int      extra_margin = Millimeter2iu( 0.002 );
+    EDA_RECT zone_boundingbox = aZone->GetBoundingBox();
+    zone_boundingbox.Inflate( std::max( bds.GetBiggestClearanceValue(), aZone->GetClearance() )
+                              + extra_margin );
+
+    // A fill is computed again by another version of Pcbnew
+    out.Print( 0, "(version %s)\n", TO_UTF8( GetBuildVersion() ) );
+
+    MD5_HASH boardOutlineHash = m_boardOutline.GetHash();
+
+    out.Print( 0, "(board %d %d %d %d %d %d %s)\n",
+               bds.m_MaxError, m_low_def, bds.m_CopperEdgeClearance,
+               bds.GetBiggestClearanceValue(), bds.m_ZoneUseNoOutlineInFill ? 1 : 0,
+               m_brdOutlinesValid ? 1 : 0, boardOutlineHash.Format().c_str() );
+
+    MD5_HASH outlineHash = aZone->Outline()->GetHash();
+
+    out.Print( 0, "(zone %s %s %d %u %d %d %d %d %d %d %d %d %d %s %d %s %d %u)\n",
+               outlineHash.Format().c_str(), aZone->GetLayerSet().FmtHex().c_str(),
+               netCode > 0 ? 1 : 0, aZone->GetPriority(), aZone->GetClearance(),
+               aZone->GetZoneClearance(), aZone->GetMinThickness(),
+               static_cast<int>( aZone->GetPadConnection() ), aZone->GetThermalReliefGap(),
+               aZone->GetThermalReliefCopperBridge(), static_cast<int>( aZone->GetFillMode() ),
+               aZone->GetHatchFillTypeThickness(), aZone->GetHatchFillTypeGap(),
+               Double2Str( aZone->GetHatchFillTypeOrientation() ).c_str(),
+               aZone->GetHatchFillTypeSmoothingLevel(),
+               Double2Str( aZone->GetHatchFillTypeSmoothingValue() ).c_str(),
+               aZone->GetCornerSmoothingType(), aZone->GetCornerRadius() );
+
+    try
+    {
+        // The footprints are written as in the board files (without the nets of the pads),
+        // followed by what the fill uses of the pads which depends on the board or the zone
+        PCB_IO io( CTL_STD_LAYER_NAMES | CTL_OMIT_NETS | CTL_OMIT_TSTAMPS | CTL_OMIT_PATH
+                   | CTL_OMIT_INITIAL_COMMENTS );
+        io.SetOutputFormatter( &out );
+
+        for( MODULE* module : m_board->Modules() )
+        {
+            EDA_RECT module_boundingbox = module->GetBoundingBox();
+            int      margin = 0;
+
+            for( D_PAD* pad : module->Pads() )
+            {
+                margin = std::max( margin, pad->GetClearance() );
+                margin = std::max( margin, aZone->GetThermalReliefGap( pad ) );
+            }
+
+            module_boundingbox.Inflate( margin );
+
+            if( !module_boundingbox.Intersects( zone_boundingbox ) )
+                continue;
+
+            io.Format( module );
+
+            for( D_PAD* pad : module->Pads() )
+            {
+                out.Print( 0, "(pad %d %d %d %d %d %d)\n",
+                           sameNet( pad ) ? 1 : 0, pad->GetNetCode() > 0 ? 1 : 0,
+                           pad->GetClearance(), static_cast<int>( aZone->GetPadConnection( pad ) ),
+                           aZone->GetThermalReliefGap( pad ),
+                           aZone->GetThermalReliefCopperBridge( pad ) );
+            }
+        }
+
+        // The tracks are written here: the vias need the board to be formatted by PCB_IO
+        for( TRACK* track : m_board->Tracks() )
+        {
+            if( !aZone->CommonLayerExists( track->GetLayerSet() ) )
+                continue;
+
+            EDA_RECT item_boundingbox = track->GetBoundingBox();
+            item_boundingbox.Inflate( track->GetClearance() );
+
+            if( !item_boundingbox.Intersects( zone_boundingbox ) )
+                continue;
+
+            out.Print( 0, "(track %d %d %d %d %d %d %s %d %d",
+                       static_cast<int>( track->Type() ),
+                       track->GetStart().x, track->GetStart().y,
+                       track->GetEnd().x, track->GetEnd().y, track->GetWidth(),
+                       track->GetLayerSet().FmtHex().c_str(), sameNet( track ) ? 1 : 0,
+                       track->GetClearance() );
+
+            if( track->Type() == PCB_VIA_T )
+            {
+                const VIA* via = static_cast<const VIA*>( track );
+                out.Print( 0, " %d %d", static_cast<int>( via->GetViaType() ),
+                           via->GetDrillValue() );
+            }
+            else if( track->Type() == PCB_ARC_T )
+            {
+                const ARC* arc = static_cast<const ARC*>( track );
+                out.Print( 0, " %d %d", arc->GetMid().x, arc->GetMid().y );
+            }
+
+            out.Print( 0, ")\n" );
+        }
+
+        for( BOARD_ITEM* item : m_board->Drawings() )
+        {
+            if( !aZone->CommonLayerExists( item->GetLayerSet() ) && !item->IsOnLayer( Edge_Cuts ) )
+                continue;
+
+            if( item->GetBoundingBox().Intersects( zone_boundingbox ) )
+                io.Format( item );
+        }
+    }
+    catch( const IO_ERROR& )
+    {
+        return std::string();
+    }
+
+    // The other zones are used by their outline (see also ZONE_CONTAINER::GetColinearCorners())
+    for( ZONE_CONTAINER* zone : m_board->GetZoneList( true ) )
+    {
+        if( zone == aZone || !aZone->CommonLayerExists( zone->GetLayerSet() ) )
+            continue;
+
+        if( !zone->GetBoundingBox().Intersects( zone_boundingbox ) )
+            continue;
+
+        MD5_HASH zoneOutlineHash = zone->Outline()->GetHash();
+
+        out.Print( 0, "(other_zone %s %s %d %d %u %d %d)\n",
+                   zoneOutlineHash.Format().c_str(), zone->GetLayerSet().FmtHex().c_str(),
+                   zone->GetIsKeepout() ? 1 : 0, zone->GetDoNotAllowCopperPour() ? 1 : 0,
+                   zone->GetPriority(), zone->GetNetCode() == netCode ? 1 : 0,
+                   zone->GetClearance() );
+    }
+
+    const std::string& description = out.GetString();
+    MD5_HASH           key;
+
+    key.Hash( (uint8_t*) description.data(), description.size() );
+    key.Finalize();
+
+    return key.Format();
+}
+
+
 /**
  * Function buildThermalSpokes
  */
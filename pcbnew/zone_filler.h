@@ -26,6 +26,7 @@
 #ifndef __ZONE_FILLER_H
 #define __ZONE_FILLER_H
 
+#include <string>
 #include <vector>
 #include <class_zone.h>
 
@@ -45,6 +46,17 @@ public:
     void InstallNewProgressReporter( wxWindow* aParent, const wxString& aTitle, int aNumPhases );
     bool Fill( const std::vector<ZONE_CONTAINER*>& aZones, bool aCheck = false );
 
+    /**
+     * Function BuildFillCacheKey
+     * builds the key of the fill of \a aZone in the ZONE_FILL_CACHE: a hash of everything
+     * fillSingleZone() uses to fill it (the zone outline and settings, the board outline and
+     * settings, and the pads, tracks, graphic items and zones near the zone).
+     * It must be updated with the knockouts of the fill.
+     * The board outline is the one read by the last Fill() (none before the first one).
+     * @return the key, or an empty string if it cannot be built.
+     */
+    std::string BuildFillCacheKey( const ZONE_CONTAINER* aZone ) const;
+
 private:
 
     void addKnockout( D_PAD* aPad, int aGap, SHAPE_POLY_SET& aHoles );
@@ -26,6 +26,7 @@
 #include <map>
 #include <utility>
 #include <iterator>
+#include <mutex>
 #include <cctype>
 #include <iostream>
 #include <algorithm>
@@ -97,7 +98,10 @@ WRL1NODE::WRL1NODE( NAMEREGISTER* aDictionary )
     m_Type = WRL1_END;
     m_dictionary = aDictionary;
 
-    if( nodenames.empty() )
+    // nodes are created by models loading concurrently
+    static std::once_flag nodenamesInit;
+
+    std::call_once( nodenamesInit, []()
     {
         nodenames.insert( NODEITEM( "AsciiText", WRL1_ASCIITEXT ) );
         nodenames.insert( NODEITEM( "Cone", WRL1_CONE ) );
@@ -134,7 +138,7 @@ WRL1NODE::WRL1NODE( NAMEREGISTER* aDictionary )
         nodenames.insert( NODEITEM( "Translation", WRL1_TRANSLATION ) );
         nodenames.insert( NODEITEM( "WWWAnchor", WRL1_WWWANCHOR ) );
         nodenames.insert( NODEITEM( "WWWInline", WRL1_WWWINLINE ) );
-    }
+    } );
 
     return;
 }
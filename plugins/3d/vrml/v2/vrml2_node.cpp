@@ -26,6 +26,7 @@
 #include <map>
 #include <utility>
 #include <iterator>
+#include <mutex>
 #include <cctype>
 #include <iostream>
 #include <sstream>
@@ -48,7 +49,10 @@ WRL2NODE::WRL2NODE()
     m_Parent = NULL;
     m_Type = WRL2_END;
 
-    if( badNames.empty() )
+    // nodes are created by models loading concurrently
+    static std::once_flag badNamesInit;
+
+    std::call_once( badNamesInit, []()
     {
         badNames.insert( "DEF" );
         badNames.insert( "EXTERNPROTO" );
@@ -64,9 +68,11 @@ WRL2NODE::WRL2NODE()
         badNames.insert( "eventOut" );
         badNames.insert( "exposedField" );
         badNames.insert( "field" );
-    }
+    } );
 
-    if( nodenames.empty() )
+    static std::once_flag nodenamesInit;
+
+    std::call_once( nodenamesInit, []()
     {
         nodenames.insert( NODEITEM( "Anchor", WRL2_ANCHOR ) );
         nodenames.insert( NODEITEM( "Appearance", WRL2_APPEARANCE ) );
@@ -122,7 +128,7 @@ WRL2NODE::WRL2NODE()
         nodenames.insert( NODEITEM( "ViewPoint", WRL2_VIEWPOINT ) );
         nodenames.insert( NODEITEM( "VisibilitySensor", WRL2_VISIBILITYSENSOR ) );
         nodenames.insert( NODEITEM( "WorldInfo", WRL2_WORLDINFO ) );
-    }
+    } );
 
     return;
 }
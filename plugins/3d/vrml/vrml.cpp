@@ -39,6 +39,7 @@
 #include "wrlproc.h"
 #include "x3d.h"
 #include <clocale>
+#include <mutex>
 #include <wx/filename.h>
 #include <wx/log.h>
 
@@ -156,21 +157,41 @@ bool CanRender( void )
 }
 
 
-class LOCALESWITCH
+bool CanLoadConcurrently( void )
 {
-    // Store the user locale name, to restore this locale later, in dtor
-    std::string m_locale;
+    // the parsers have no shared state other than the locale (see LOCALESWITCH)
+    return true;
+}
+
+
+// Models may be loaded by several threads at once: the first one to start switches
+// to the C locale and the last one to finish restores the user locale
+static std::mutex  s_localeLock;
+static int         s_localeCount = 0;
+static std::string s_userLocale;
+
 
+class LOCALESWITCH
+{
 public:
     LOCALESWITCH()
     {
-        m_locale = setlocale( LC_NUMERIC, 0 );
-        setlocale( LC_NUMERIC, "C" );
+        std::lock_guard<std::mutex> lock( s_localeLock );
+
+        if( s_localeCount++ == 0 )
+        {
+            // Store the user locale name, to restore this locale later, in dtor
+            s_userLocale = setlocale( LC_NUMERIC, 0 );
+            setlocale( LC_NUMERIC, "C" );
+        }
     }
 
     ~LOCALESWITCH()
     {
-        setlocale( LC_NUMERIC, m_locale.c_str() );
+        std::lock_guard<std::mutex> lock( s_localeLock );
+
+        if( --s_localeCount == 0 )
+            setlocale( LC_NUMERIC, s_userLocale.c_str() );
     }
 };
 
@@ -44,6 +44,7 @@ KICAD_PLUGIN_LDR_3D::KICAD_PLUGIN_LDR_3D()
     m_getFileFilter = NULL;
     m_canRender = NULL;
     m_load = NULL;
+    m_canLoadConcurrently = NULL;
 
     return;
 }
@@ -94,6 +95,13 @@ bool KICAD_PLUGIN_LDR_3D::Open( const wxString& aFullFileName )
     LINK_ITEM( m_canRender, PLUGIN_3D_CAN_RENDER, "CanRender" );
     LINK_ITEM( m_load, PLUGIN_3D_LOAD, "Load" );
 
+    // optional function; older plugins do not export it
+    if( m_PluginLoader.HasSymbol( wxT( "CanLoadConcurrently" ) ) )
+    {
+        LINK_ITEM( m_canLoadConcurrently, PLUGIN_3D_CAN_LOAD_CONCURRENTLY,
+                   "CanLoadConcurrently" );
+    }
+
     #ifdef DEBUG
         bool fail = false;
 
@@ -250,6 +258,7 @@ void KICAD_PLUGIN_LDR_3D::Close( void )
     m_getFileFilter = NULL;
     m_canRender = NULL;
     m_load = NULL;
+    m_canLoadConcurrently = NULL;
     close();
 
     return;
@@ -428,14 +437,19 @@ bool KICAD_PLUGIN_LDR_3D::CanRender( void )
 
 SCENEGRAPH* KICAD_PLUGIN_LDR_3D::Load( char const* aFileName )
 {
-    m_error.clear();
-
-    if( !ok && !reopen() )
+    // the error is not cleared once the plugin is open since plugins which
+    // can load concurrently are called from several threads at once
+    if( !ok )
     {
-        if( m_error.empty() )
-            m_error = "[INFO] no open plugin / plugin could not be opened";
+        m_error.clear();
 
-        return NULL;
+        if( !reopen() )
+        {
+            if( m_error.empty() )
+                m_error = "[INFO] no open plugin / plugin could not be opened";
+
+            return NULL;
+        }
     }
 
     if( NULL == m_load )
@@ -454,3 +468,12 @@ SCENEGRAPH* KICAD_PLUGIN_LDR_3D::Load( char const* aFileName )
 
     return m_load( aFileName );
 }
+
+
+bool KICAD_PLUGIN_LDR_3D::CanLoadConcurrently( void )
+{
+    if( !ok || NULL == m_canLoadConcurrently )
+        return false;
+
+    return m_canLoadConcurrently();
+}
@@ -47,6 +47,8 @@ typedef bool (*PLUGIN_3D_CAN_RENDER) ( void );
 
 typedef SCENEGRAPH* (*PLUGIN_3D_LOAD) ( char const* aFileName );
 
+typedef bool (*PLUGIN_3D_CAN_LOAD_CONCURRENTLY) ( void );
+
 
 class KICAD_PLUGIN_LDR_3D : public KICAD_PLUGIN_LDR
 {
@@ -58,6 +60,7 @@ private:
     PLUGIN_3D_GET_FILE_FILTER       m_getFileFilter;
     PLUGIN_3D_CAN_RENDER            m_canRender;
     PLUGIN_3D_LOAD                  m_load;
+    PLUGIN_3D_CAN_LOAD_CONCURRENTLY m_canLoadConcurrently;  // optional, may be NULL
 
 public:
     KICAD_PLUGIN_LDR_3D();
@@ -85,6 +88,8 @@ public:
     bool CanRender( void );
 
     SCENEGRAPH* Load( char const* aFileName );
+
+    bool CanLoadConcurrently( void );
 };
 
 #endif  // PLUGINMGR3D_H
@@ -0,0 +1,189 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+
+#include <tool/coroutine.h>
+#include <tool/coroutine_stack_pool.h>
+#include <tool/tool_event.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <profile.h>
+
+
+/**
+ * The coroutine type used by the TOOL_MANAGER to run the tools.
+ */
+typedef COROUTINE<int, const TOOL_EVENT&> TOOL_COROUTINE;
+
+
+/**
+ * A minimal interactive tool: it waits for events until it gets a cancel event, as the
+ * event loop of the tools does with TOOL_INTERACTIVE::Wait().
+ */
+class BENCH_TOOL
+{
+public:
+    BENCH_TOOL() :
+        m_event( nullptr ),
+        m_handled( 0 )
+    {
+    }
+
+    int Main( const TOOL_EVENT& aEvent )
+    {
+        m_event = &aEvent;
+
+        while( !m_event->IsCancel() )
+        {
+            if( m_event->IsMotion() )
+                m_handled++;
+
+            m_cofunc->KiYield();
+        }
+
+        return 0;
+    }
+
+    ///> Wakes the tool up for an event, as TOOL_MANAGER::dispatchInternal() does
+    void Dispatch( const TOOL_EVENT& aEvent )
+    {
+        m_event = &aEvent;
+        m_cofunc->Resume();
+    }
+
+    std::unique_ptr<TOOL_COROUTINE> m_cofunc;
+    const TOOL_EVENT*               m_event;
+    long                            m_handled;
+};
+
+
+static void printTime( const char* aName, double aTotalMs, long aCount )
+{
+    printf( "%-30s %10.1f ns (%ld iterations)\n", aName, aTotalMs * 1e6 / aCount, aCount );
+}
+
+
+/**
+ * Times the context switches of the coroutines, and the dispatch of events to a tool
+ * running in a coroutine:
+ *  - context switch: a Resume() and the KiYield() back to the caller,
+ *  - event dispatch: waking up a waiting tool for a mouse motion event,
+ *  - tool invocation: creating the coroutine of a tool, running it until it waits for an
+ *    event, then ending and deleting it (the stacks come from COROUTINE_STACK_POOL).
+ */
+static int coroutine_bench_main( int argc, char** argv )
+{
+    long count = 1000000;
+
+    if( argc > 1 )
+        count = std::max( 1L, atol( argv[1] ) );
+
+    // Context switches
+    {
+        long yields = 0;
+        std::unique_ptr<COROUTINE<int, int>> cofunc;
+
+        cofunc = std::make_unique<COROUTINE<int, int>>(
+                [&]( int aCount ) -> int
+                {
+                    for( int i = 0; i < aCount; i++ )
+                        cofunc->KiYield( i );
+
+                    return 0;
+                } );
+
+        PROF_COUNTER cnt;
+
+        cofunc->Call( (int) count );
+
+        while( cofunc->Running() )
+        {
+            yields++;
+            cofunc->Resume();
+        }
+
+        printTime( "context switch (round trip):", cnt.msecs(), yields );
+    }
+
+    // Event dispatch
+    {
+        BENCH_TOOL tool;
+        TOOL_EVENT activate( TC_COMMAND, TA_ACTIVATE );
+        TOOL_EVENT motion( TC_MOUSE, TA_MOUSE_MOTION, 0 );
+        TOOL_EVENT cancel( TC_COMMAND, TA_CANCEL_TOOL );
+
+        tool.m_cofunc = std::make_unique<TOOL_COROUTINE>( &tool, &BENCH_TOOL::Main );
+        tool.m_cofunc->Call( activate );
+
+        PROF_COUNTER cnt;
+
+        for( long i = 0; i < count; i++ )
+        {
+            motion.SetMousePosition( VECTOR2D( i, i ) );
+            tool.Dispatch( motion );
+        }
+
+        double ms = cnt.msecs();
+
+        tool.Dispatch( cancel );
+
+        printTime( "motion event dispatch:", ms, tool.m_handled );
+    }
+
+    // Tool invocations
+    {
+        BENCH_TOOL tool;
+        TOOL_EVENT activate( TC_COMMAND, TA_ACTIVATE );
+        TOOL_EVENT cancel( TC_COMMAND, TA_CANCEL_TOOL );
+        long       invocations = std::max( 1L, count / 10 );
+        size_t     mapped = COROUTINE_STACK_POOL::Instance().GetMappedCount();
+
+        PROF_COUNTER cnt;
+
+        for( long i = 0; i < invocations; i++ )
+        {
+            tool.m_cofunc = std::make_unique<TOOL_COROUTINE>( &tool, &BENCH_TOOL::Main );
+            tool.m_cofunc->Call( activate );
+            tool.Dispatch( cancel );
+            tool.m_cofunc.reset();
+        }
+
+        printTime( "tool invocation:", cnt.msecs(), invocations );
+        printf( "coroutine stacks mapped: %zu\n",
+                COROUTINE_STACK_POOL::Instance().GetMappedCount() - mapped );
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "coroutine_bench",
+        "Benchmark the coroutine context switches and the dispatch of events to a tool",
+        coroutine_bench_main,
+} );
@@ -0,0 +1,112 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 3
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-3.0.html
+ * or you may search the http://www.gnu.org website for the version 3 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file
+ * Test suite for the connection point queries of SCH_SCREEN
+ */
+
+#include <convert_to_biu.h>
+#include <sch_line.h>
+#include <unit_test_utils/unit_test_utils.h>
+
+// Code under test
+#include <sch_screen.h>
+
+
+class TEST_SCH_SCREEN_FIXTURE
+{
+public:
+    TEST_SCH_SCREEN_FIXTURE() : m_screen( nullptr )
+    {
+    }
+
+    SCH_SCREEN m_screen;
+};
+
+
+/**
+ * Declare the test suite
+ */
+BOOST_FIXTURE_TEST_SUITE( SchScreen, TEST_SCH_SCREEN_FIXTURE )
+
+
+/**
+ * Check the wire ends are found at their positions
+ */
+BOOST_AUTO_TEST_CASE( WireEnds )
+{
+    const wxPoint start( 0, 0 );
+    const wxPoint end( Mils2iu( 1000 ), 0 );
+
+    SCH_LINE* wire = new SCH_LINE( start, LAYER_WIRE );
+    wire->SetEndPoint( end );
+    m_screen.Append( wire );
+
+    BOOST_CHECK_EQUAL( m_screen.GetWire( start, 0, END_POINTS_ONLY_T ), wire );
+    BOOST_CHECK_EQUAL( m_screen.GetWire( end, 0, END_POINTS_ONLY_T ), wire );
+    BOOST_CHECK_EQUAL( m_screen.CountConnectedItems( end, false ), 1u );
+
+    const wxPoint middle( Mils2iu( 500 ), 0 );
+
+    BOOST_CHECK( m_screen.GetWire( middle, 0, END_POINTS_ONLY_T ) == nullptr );
+    BOOST_CHECK_EQUAL( m_screen.CountConnectedItems( middle, false ), 0u );
+}
+
+
+/**
+ * Check a wire end rotated in place, then updated on the screen, is found at its new
+ * position and no longer at its old one
+ */
+BOOST_AUTO_TEST_CASE( RotatedWireEnd )
+{
+    const wxPoint start( 0, 0 );
+    const wxPoint end( Mils2iu( 1000 ), 0 );
+
+    SCH_LINE* wire = new SCH_LINE( start, LAYER_WIRE );
+    wire->SetEndPoint( end );
+    m_screen.Append( wire );
+
+    // A second wire ending where the rotated end will be
+    SCH_LINE* other = new SCH_LINE( wxPoint( Mils2iu( 1000 ), Mils2iu( 1000 ) ), LAYER_WIRE );
+    m_screen.Append( other );
+
+    wire->RotateEnd( start );
+    m_screen.Update( wire );
+
+    const wxPoint rotatedEnd = wire->GetEndPoint();
+
+    BOOST_REQUIRE( rotatedEnd != end );
+    other->SetEndPoint( rotatedEnd );
+    m_screen.Update( other );
+
+    BOOST_CHECK( m_screen.GetWire( end, 0, END_POINTS_ONLY_T ) == nullptr );
+    BOOST_CHECK_EQUAL( m_screen.CountConnectedItems( end, false ), 0u );
+
+    BOOST_CHECK_EQUAL( m_screen.GetWire( start, 0, END_POINTS_ONLY_T ), wire );
+    BOOST_CHECK( m_screen.GetWire( rotatedEnd, 0, END_POINTS_ONLY_T ) != nullptr );
+    BOOST_CHECK_EQUAL( m_screen.CountConnectedItems( rotatedEnd, false ), 2u );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,192 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file test_zone_fill_cache.cpp
+ * Test suite for the #ZONE_FILL_CACHE and the keys of the fills built by the #ZONE_FILLER
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <zone_fill_cache.h> // UUT
+
+#include <wx/filefn.h>
+#include <wx/filename.h>
+
+#include <class_board.h>
+#include <class_module.h>
+#include <class_pad.h>
+#include <class_track.h>
+#include <class_zone.h>
+#include <geometry/shape_poly_set.h>
+#include <zone_filler.h>
+
+
+/**
+ * A folder in the temp directory, holding a (never written) board file, removed with its
+ * content at the end of the test
+ */
+struct TEMP_BOARD_FOLDER
+{
+    TEMP_BOARD_FOLDER()
+    {
+        wxFileName fn( wxFileName::CreateTempFileName( wxT( "qa_zone_fill_cache" ) ) );
+
+        // The temp file only reserves a unique name for the folder
+        wxRemoveFile( fn.GetFullPath() );
+        BOOST_REQUIRE( wxFileName::Mkdir( fn.GetFullPath() ) );
+
+        m_folder = fn.GetFullPath();
+        m_boardFileName = wxFileName( m_folder, wxT( "board.kicad_pcb" ) ).GetFullPath();
+    }
+
+    ~TEMP_BOARD_FOLDER()
+    {
+        wxFileName::Rmdir( m_folder, wxPATH_RMDIR_RECURSIVE );
+    }
+
+    wxString m_folder;
+    wxString m_boardFileName;
+};
+
+
+static SHAPE_POLY_SET MakeFill()
+{
+    SHAPE_POLY_SET fill;
+
+    fill.NewOutline();
+    fill.Append( 0, 0 );
+    fill.Append( 10000000, 0 );
+    fill.Append( 10000000, 5000000 );
+    fill.Append( 0, 5000000 );
+
+    return fill;
+}
+
+
+/**
+ * Declare the test suite
+ */
+BOOST_AUTO_TEST_SUITE( ZoneFillCache )
+
+
+/**
+ * Check a stored fill is found again, and only for its key
+ */
+BOOST_AUTO_TEST_CASE( StoreAndFind )
+{
+    TEMP_BOARD_FOLDER folder;
+    ZONE_FILL_CACHE   cache( folder.m_boardFileName );
+    SHAPE_POLY_SET    found;
+
+    BOOST_REQUIRE( cache.IsValid() );
+    BOOST_CHECK( !cache.Find( "0123456789abcdef0123456789abcdef", found ) );
+
+    const SHAPE_POLY_SET fill = MakeFill();
+    cache.Store( "0123456789abcdef0123456789abcdef", fill );
+
+    BOOST_REQUIRE( cache.Find( "0123456789abcdef0123456789abcdef", found ) );
+    BOOST_REQUIRE_EQUAL( found.OutlineCount(), 1 );
+    BOOST_REQUIRE_EQUAL( found.COutline( 0 ).PointCount(), fill.COutline( 0 ).PointCount() );
+
+    for( int ii = 0; ii < fill.COutline( 0 ).PointCount(); ++ii )
+        BOOST_CHECK_EQUAL( found.COutline( 0 ).CPoint( ii ), fill.COutline( 0 ).CPoint( ii ) );
+
+    BOOST_CHECK( !cache.Find( "fedcba9876543210fedcba9876543210", found ) );
+}
+
+
+/**
+ * Check the cache is not usable for a board never saved
+ */
+BOOST_AUTO_TEST_CASE( UnsavedBoard )
+{
+    ZONE_FILL_CACHE cache( wxEmptyString );
+    SHAPE_POLY_SET  found;
+
+    BOOST_CHECK( !cache.IsValid() );
+
+    cache.Store( "0123456789abcdef0123456789abcdef", MakeFill() );
+    BOOST_CHECK( !cache.Find( "0123456789abcdef0123456789abcdef", found ) );
+}
+
+
+/**
+ * Check the key of a fill changes when a pad or a track near the zone moves, and not when
+ * a track far from the zone moves
+ */
+BOOST_AUTO_TEST_CASE( KeyChangesWithNearbyItems )
+{
+    BOARD board;
+
+    ZONE_CONTAINER* zone = new ZONE_CONTAINER( &board );
+    zone->SetLayer( F_Cu );
+    zone->Outline()->NewOutline();
+    zone->Outline()->Append( 0, 0 );
+    zone->Outline()->Append( 20000000, 0 );
+    zone->Outline()->Append( 20000000, 20000000 );
+    zone->Outline()->Append( 0, 20000000 );
+    board.Add( zone );
+
+    MODULE* module = new MODULE( &board );
+    module->Add( new D_PAD( module ) );
+    module->SetPosition( wxPoint( 5000000, 5000000 ) );
+    board.Add( module );
+
+    TRACK* nearTrack = new TRACK( &board );
+    nearTrack->SetLayer( F_Cu );
+    nearTrack->SetWidth( 250000 );
+    nearTrack->SetStart( wxPoint( 10000000, 2000000 ) );
+    nearTrack->SetEnd( wxPoint( 10000000, 18000000 ) );
+    board.Add( nearTrack );
+
+    TRACK* farTrack = new TRACK( &board );
+    farTrack->SetLayer( F_Cu );
+    farTrack->SetWidth( 250000 );
+    farTrack->SetStart( wxPoint( 100000000, 2000000 ) );
+    farTrack->SetEnd( wxPoint( 100000000, 18000000 ) );
+    board.Add( farTrack );
+
+    ZONE_FILLER       filler( &board );
+    const std::string key = filler.BuildFillCacheKey( zone );
+
+    BOOST_REQUIRE( !key.empty() );
+    BOOST_CHECK_EQUAL( filler.BuildFillCacheKey( zone ), key );
+
+    farTrack->Move( wxPoint( 1000000, 0 ) );
+    BOOST_CHECK_EQUAL( filler.BuildFillCacheKey( zone ), key );
+
+    module->Move( wxPoint( 1000000, 0 ) );
+    const std::string movedPadKey = filler.BuildFillCacheKey( zone );
+    BOOST_CHECK_NE( movedPadKey, key );
+
+    nearTrack->Move( wxPoint( 1000000, 0 ) );
+    BOOST_CHECK_NE( filler.BuildFillCacheKey( zone ), movedPadKey );
+
+    // Moving the items back gives the first key again
+    module->Move( wxPoint( -1000000, 0 ) );
+    nearTrack->Move( wxPoint( -1000000, 0 ) );
+    BOOST_CHECK_EQUAL( filler.BuildFillCacheKey( zone ), key );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,241 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file test_zone_fill_encoding.cpp
+ * Test suite for the encoding of the zone fills (#EncodeZoneFill, #DecodeZoneFill) and the
+ * (filled_polygon_data ...) blocks of the board files
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <zone_fill_encoding.h> // UUT
+
+#include <wx/ffile.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+
+#include <class_board.h>
+#include <class_zone.h>
+#include <geometry/shape_poly_set.h>
+#include <kicad_plugin.h>
+#include <properties.h>
+
+
+/**
+ * Make a fill with several outlines, with short and long edges and negative coordinates
+ */
+static SHAPE_POLY_SET MakeFill()
+{
+    SHAPE_POLY_SET fill;
+
+    for( int ii = 0; ii < 5; ++ii )
+    {
+        SHAPE_LINE_CHAIN outline;
+        int              x = -50000000 + ii * 20000000;
+
+        outline.Append( x, -3000000 );
+        outline.Append( x + 1, -3000000 );
+        outline.Append( x + 15000000, 2000000 + ii * 127 );
+        outline.Append( x + 7000000, 40000000 );
+        outline.Append( x - 3, 39999999 );
+        outline.SetClosed( true );
+
+        fill.AddOutline( outline );
+    }
+
+    return fill;
+}
+
+
+/**
+ * Predicate checking that two fills have the same outlines and points, in the same order
+ */
+static bool AreFillsEqual( const SHAPE_POLY_SET& aExpected, const SHAPE_POLY_SET& aActual )
+{
+    if( aExpected.OutlineCount() != aActual.OutlineCount() )
+    {
+        BOOST_TEST_INFO( "Outline count: " << aExpected.OutlineCount() << " != "
+                                           << aActual.OutlineCount() );
+        return false;
+    }
+
+    for( int ii = 0; ii < aExpected.OutlineCount(); ++ii )
+    {
+        const SHAPE_LINE_CHAIN& expected = aExpected.COutline( ii );
+        const SHAPE_LINE_CHAIN& actual = aActual.COutline( ii );
+
+        if( expected.PointCount() != actual.PointCount() )
+        {
+            BOOST_TEST_INFO( "Point count of outline " << ii << ": " << expected.PointCount()
+                                                       << " != " << actual.PointCount() );
+            return false;
+        }
+
+        for( int jj = 0; jj < expected.PointCount(); ++jj )
+        {
+            if( expected.CPoint( jj ) != actual.CPoint( jj ) )
+            {
+                BOOST_TEST_INFO( "Point " << jj << " of outline " << ii );
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+
+/**
+ * Make a board with a single zone filled with MakeFill()
+ */
+static std::unique_ptr<BOARD> MakeBoardWithFilledZone()
+{
+    auto board = std::make_unique<BOARD>();
+    auto zone = std::make_unique<ZONE_CONTAINER>( board.get() );
+
+    zone->SetLayer( F_Cu );
+    zone->Outline()->NewOutline();
+    zone->Outline()->Append( -60000000, -10000000 );
+    zone->Outline()->Append( 60000000, -10000000 );
+    zone->Outline()->Append( 60000000, 50000000 );
+    zone->Outline()->Append( -60000000, 50000000 );
+
+    SHAPE_POLY_SET fill = MakeFill();
+    zone->SetFilledPolysList( fill );
+    zone->SetIsFilled( true );
+
+    board->Add( zone.release() );
+
+    return board;
+}
+
+
+static std::string ReadFile( const wxString& aFileName )
+{
+    wxFFile     file( aFileName, wxT( "rb" ) );
+    std::string content;
+
+    BOOST_REQUIRE( file.IsOpened() );
+
+    content.resize( file.Length() );
+    BOOST_REQUIRE_EQUAL( file.Read( &content[0], content.size() ), content.size() );
+
+    return content;
+}
+
+
+/**
+ * Declare the test suite
+ */
+BOOST_AUTO_TEST_SUITE( ZoneFillEncoding )
+
+
+/**
+ * Check a fill is decoded as it was encoded
+ */
+BOOST_AUTO_TEST_CASE( RoundTrip )
+{
+    const SHAPE_POLY_SET fill = MakeFill();
+    const std::string    encoded = EncodeZoneFill( fill );
+    SHAPE_POLY_SET       decoded;
+
+    BOOST_CHECK( DecodeZoneFill( encoded, decoded ) );
+    BOOST_CHECK_PREDICATE( AreFillsEqual, ( fill )( decoded ) );
+}
+
+
+/**
+ * Check the invalid data is rejected, without reading out of it
+ */
+BOOST_AUTO_TEST_CASE( InvalidData )
+{
+    const std::string encoded = EncodeZoneFill( MakeFill() );
+    SHAPE_POLY_SET    decoded;
+
+    BOOST_CHECK( !DecodeZoneFill( "", decoded ) );
+    BOOST_CHECK( !DecodeZoneFill( "not base64!", decoded ) );
+
+    // A truncated stream, with a valid and an invalid base64 length
+    BOOST_CHECK( !DecodeZoneFill( encoded.substr( 0, encoded.size() - 4 ), decoded ) );
+    BOOST_CHECK( !DecodeZoneFill( encoded.substr( 0, 4 * ( encoded.size() / 4 - 1 ) + 1 ),
+                                  decoded ) );
+
+    // An invalid character inside valid data
+    std::string corrupted = encoded;
+    corrupted[corrupted.size() / 2] = '*';
+    BOOST_CHECK( !DecodeZoneFill( corrupted, decoded ) );
+}
+
+
+/**
+ * Check a board saved with compressed fills is loaded with the same fills, or without fills
+ * when they are skipped
+ */
+BOOST_AUTO_TEST_CASE( SaveAndLoad )
+{
+    std::unique_ptr<BOARD> board = MakeBoardWithFilledZone();
+    wxString               fileName = wxFileName::CreateTempFileName( wxT( "qa_zone_fill" ) );
+    PROPERTIES             saveProps;
+
+    BOOST_REQUIRE( !fileName.IsEmpty() );
+
+    saveProps["compress_zone_fills"] = "";
+
+    PCB_IO io;
+    io.Save( fileName, board.get(), &saveProps );
+
+    const std::string content = ReadFile( fileName );
+    BOOST_CHECK( content.find( "(filled_polygon_data" ) != std::string::npos );
+    BOOST_CHECK( content.find( "(filled_polygon " ) == std::string::npos );
+
+    {
+        std::unique_ptr<BOARD> loaded( io.Load( fileName, nullptr ) );
+
+        BOOST_REQUIRE( loaded );
+        BOOST_REQUIRE_EQUAL( loaded->Zones().size(), 1 );
+
+        const ZONE_CONTAINER* zone = loaded->Zones()[0];
+
+        BOOST_CHECK_PREDICATE( AreFillsEqual,
+                               ( board->Zones()[0]->GetFilledPolysList() )
+                               ( zone->GetFilledPolysList() ) );
+        BOOST_CHECK( !zone->NeedRefill() );
+    }
+
+    {
+        PROPERTIES loadProps;
+        loadProps["skip_zone_fills"] = "";
+
+        std::unique_ptr<BOARD> loaded( io.Load( fileName, nullptr, &loadProps ) );
+
+        BOOST_REQUIRE( loaded );
+        BOOST_REQUIRE_EQUAL( loaded->Zones().size(), 1 );
+        BOOST_CHECK( loaded->Zones()[0]->GetFilledPolysList().IsEmpty() );
+        BOOST_CHECK( loaded->Zones()[0]->NeedRefill() );
+    }
+
+    wxRemoveFile( fileName );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,163 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include <wx/filename.h>
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <class_board.h>
+#include <common.h>
+#include <pcb_plot_params.h>
+#include <pcbplot.h>
+#include <plotter.h>
+#include <profile.h>
+
+
+enum PLOT_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    PLOT_FAILED,
+};
+
+
+/**
+ * Times the Gerber output of the enabled layers of a board: each layer alone on a single
+ * thread, then all of them through PlotBoardLayers(), which plots them concurrently.  Prints
+ * the slowest layer and the size of the created files to compare implementations.
+ */
+int plot_main( int argc, char* argv[] )
+{
+    std::string filename;
+    wxString    outputDir = wxFileName::GetTempDir();
+    int         iterations = 5;
+
+    if( argc > 1 )
+        filename = argv[1];
+
+    if( argc > 2 )
+        outputDir = wxString::FromUTF8( argv[2] );
+
+    if( argc > 3 )
+        iterations = std::max( 1, atoi( argv[3] ) );
+
+    auto brd = KI_TEST::ReadBoardFromFileOrStream( filename );
+
+    if( !brd )
+        return PLOT_RET_CODES::LOAD_FAILED;
+
+    PCB_PLOT_PARAMS plotOpts;
+
+    plotOpts.SetFormat( PLOT_FORMAT::GERBER );
+    plotOpts.SetUseGerberX2format( true );
+    plotOpts.SetSkipPlotNPTH_Pads( false );
+
+    LSEQ          layers = brd->GetEnabledLayers().Seq();
+    wxArrayString fullFileNames;
+
+    for( PCB_LAYER_ID layer : layers )
+    {
+        wxFileName fn( wxT( "plot" ) );
+
+        BuildPlotFileName( &fn, outputDir, brd->GetLayerName( layer ),
+                           GetDefaultPlotExtension( PLOT_FORMAT::GERBER ) );
+        fullFileNames.Add( fn.GetFullPath() );
+    }
+
+    double slowestTime = 0.0;
+    size_t slowestLayer = 0;
+
+    {
+        // As PlotBoardLayers() does, once for all the layers
+        LOCALE_IO toggle;
+
+        for( size_t i = 0; i < layers.size(); ++i )
+        {
+            PROF_COUNTER cnt;
+
+            for( int ii = 0; ii < iterations; ++ii )
+            {
+                PCB_PLOT_PARAMS layerOpts = plotOpts;
+                PLOTTER*        plotter = StartPlotBoard( brd.get(), &layerOpts, layers[i],
+                                                          fullFileNames[i], wxEmptyString );
+
+                if( !plotter )
+                    return PLOT_RET_CODES::PLOT_FAILED;
+
+                PlotOneBoardLayer( brd.get(), plotter, layers[i], layerOpts );
+                plotter->EndPlot();
+                delete plotter;
+            }
+
+            double layerTime = cnt.msecs() / iterations;
+
+            if( layerTime > slowestTime )
+            {
+                slowestTime = layerTime;
+                slowestLayer = i;
+            }
+        }
+    }
+
+    PROF_COUNTER allCnt;
+
+    for( int ii = 0; ii < iterations; ++ii )
+    {
+        if( !PlotBoardLayers( brd.get(), plotOpts, layers, fullFileNames, wxEmptyString ) )
+            return PLOT_RET_CODES::PLOT_FAILED;
+    }
+
+    double allTime = allCnt.msecs() / iterations;
+
+    wxULongLong fileSize = 0;
+
+    for( const wxString& fullFileName : fullFileNames )
+        fileSize += wxFileName::GetSize( fullFileName );
+
+    printf( "layers: %zu, plot files: %s bytes in \"%s\"\n", layers.size(),
+            (const char*) fileSize.ToString().utf8_str(), (const char*) outputDir.utf8_str() );
+
+    if( !layers.empty() )
+    {
+        printf( "slowest layer: %s, %.3f ms (single thread)\n",
+                (const char*) brd->GetLayerName( layers[slowestLayer] ).utf8_str(),
+                slowestTime );
+    }
+
+    printf( "plot of all layers: %.3f ms (mean of %d iterations)\n", allTime, iterations );
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "plot",
+        "Benchmark the Gerber plot of the layers of a PCB",
+        plot_main,
+} );
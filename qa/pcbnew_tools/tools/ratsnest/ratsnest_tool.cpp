@@ -0,0 +1,130 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <class_board.h>
+#include <connectivity/connectivity_data.h>
+#include <profile.h>
+#include <ratsnest_data.h>
+
+
+enum RATSNEST_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+};
+
+
+/**
+ * Times the ratsnest computation (triangulation and minimum spanning tree) of each net of
+ * a board, on a single thread, and prints a summary of the result (count and length of the
+ * ratsnest lines) to compare implementations.
+ */
+int ratsnest_main( int argc, char* argv[] )
+{
+    std::string filename;
+    int         iterations = 10;
+
+    if( argc > 1 )
+        filename = argv[1];
+
+    if( argc > 2 )
+        iterations = std::max( 1, atoi( argv[2] ) );
+
+    auto brd = KI_TEST::ReadBoardFromFileOrStream( filename );
+
+    if( !brd )
+        return RATSNEST_RET_CODES::LOAD_FAILED;
+
+    PROF_COUNTER buildCnt( "build connectivity" );
+    brd->BuildConnectivity();
+    buildCnt.Show();
+
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = brd->GetConnectivity();
+
+    double totalTime = 0.0;
+    double slowestTime = 0.0;
+    int    slowestNet = 0;
+    size_t nodeCount = 0;
+    size_t edgeCount = 0;
+    double edgeLength = 0.0;
+
+    for( int net = 1; net < connectivity->GetNetCount(); ++net )
+    {
+        RN_NET* rnNet = connectivity->GetRatsnestForNet( net );
+
+        if( !rnNet || rnNet->GetNodeCount() == 0 )
+            continue;
+
+        PROF_COUNTER cnt;
+
+        for( int ii = 0; ii < iterations; ++ii )
+            rnNet->Update();
+
+        double netTime = cnt.msecs() / iterations;
+
+        totalTime += netTime;
+
+        if( netTime > slowestTime )
+        {
+            slowestTime = netTime;
+            slowestNet = net;
+        }
+
+        nodeCount += rnNet->GetNodeCount();
+
+        for( const CN_EDGE& edge : rnNet->GetEdges() )
+        {
+            edgeCount++;
+            edgeLength += ( edge.GetTargetPos() - edge.GetSourcePos() ).EuclideanNorm();
+        }
+    }
+
+    printf( "nets: %d, nodes: %zu\n", connectivity->GetNetCount() - 1, nodeCount );
+    printf( "ratsnest lines: %zu, total length: %.0f\n", edgeCount, edgeLength );
+    printf( "ratsnest update of all nets: %.3f ms (mean of %d iterations)\n", totalTime,
+            iterations );
+
+    if( slowestNet > 0 && brd->FindNet( slowestNet ) )
+    {
+        printf( "slowest net: %s (%u nodes), %.3f ms\n",
+                (const char*) brd->FindNet( slowestNet )->GetNetname().utf8_str(),
+                connectivity->GetRatsnestForNet( slowestNet )->GetNodeCount(), slowestTime );
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "ratsnest",
+        "Benchmark the ratsnest computation of the nets of a PCB",
+        ratsnest_main,
+} );
@@ -0,0 +1,275 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2020 KiCad Developers, see CHANGELOG.TXT for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+#include <common.h>
+#include <pgm_base.h>
+#include <profile.h>
+#include <reporter.h>
+#include <settings/color_settings.h>
+#include <settings/settings_manager.h>
+
+#include <wx/cmdline.h>
+#include <wx/filename.h>
+#include <wx/image.h>
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <3d_cache/3d_cache.h>
+#include <3d_canvas/cinfo3d_visu.h>
+#include <3d_rendering/3d_render_raytracing/c3d_render_raytracing.h>
+
+#include <qa_utils/utility_registry.h>
+
+
+using RENDER_DURATION = std::chrono::milliseconds;
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    {
+            wxCMD_LINE_SWITCH,
+            "h",
+            "help",
+            _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE,
+            wxCMD_LINE_OPTION_HELP,
+    },
+    {
+            wxCMD_LINE_SWITCH,
+            "v",
+            "verbose",
+            _( "print the render progress and timings" ).mb_str(),
+    },
+    {
+            wxCMD_LINE_OPTION,
+            "o",
+            "output",
+            _( "output PNG file" ).mb_str(),
+            wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_OPTION_MANDATORY,
+    },
+    {
+            wxCMD_LINE_OPTION,
+            "W",
+            "width",
+            _( "image width in pixels (default 1600)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER,
+    },
+    {
+            wxCMD_LINE_OPTION,
+            "H",
+            "height",
+            _( "image height in pixels (default 1200)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER,
+    },
+    {
+            wxCMD_LINE_OPTION,
+            "x",
+            "rotate-x",
+            _( "camera rotation around the X axis, in degrees" ).mb_str(),
+            wxCMD_LINE_VAL_DOUBLE,
+    },
+    {
+            wxCMD_LINE_OPTION,
+            "z",
+            "rotate-z",
+            _( "camera rotation around the Z axis, in degrees" ).mb_str(),
+            wxCMD_LINE_VAL_DOUBLE,
+    },
+    {
+            wxCMD_LINE_OPTION,
+            "Z",
+            "zoom",
+            _( "camera zoom factor" ).mb_str(),
+            wxCMD_LINE_VAL_DOUBLE,
+    },
+    {
+            wxCMD_LINE_SWITCH,
+            "P",
+            "no-post-processing",
+            _( "disable the screen space ambient occlusion pass" ).mb_str(),
+    },
+    {
+            wxCMD_LINE_PARAM,
+            nullptr,
+            nullptr,
+            _( "input file" ).mb_str(),
+            wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_PARAM_OPTIONAL,
+    },
+    { wxCMD_LINE_NONE }
+};
+
+/**
+ * Tool=specific return codes
+ */
+enum RENDER_RET_CODES
+{
+    PARSE_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    RENDER_FAILED,
+    SAVE_FAILED,
+};
+
+
+/**
+ * Set up the 3D settings as the default realistic mode of the 3D viewer.
+ */
+static void setupSettings( CINFO3D_VISU& aSettings, bool aPostProcessing )
+{
+    aSettings.RenderEngineSet( RENDER_ENGINE::RAYTRACING );
+    aSettings.MaterialModeSet( MATERIAL_MODE::NORMAL );
+
+    const DISPLAY3D_FLG enabledFlags[] = {
+        FL_ZONE,
+        FL_SILKSCREEN,
+        FL_SOLDERMASK,
+        FL_MODULE_ATTRIBUTES_NORMAL,
+        FL_MODULE_ATTRIBUTES_NORMAL_INSERT,
+        FL_SHOW_BOARD_BODY,
+        FL_USE_REALISTIC_MODE,
+        FL_SUBTRACT_MASK_FROM_SILK,
+        FL_RENDER_RAYTRACING_SHADOWS,
+        FL_RENDER_RAYTRACING_REFRACTIONS,
+        FL_RENDER_RAYTRACING_REFLECTIONS,
+        FL_RENDER_RAYTRACING_ANTI_ALIASING,
+        FL_RENDER_RAYTRACING_PROCEDURAL_TEXTURES,
+    };
+
+    for( DISPLAY3D_FLG flag : enabledFlags )
+        aSettings.SetFlag( flag, true );
+
+    aSettings.SetFlag( FL_RENDER_RAYTRACING_POST_PROCESSING, aPostProcessing );
+}
+
+
+int render_3d_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText(
+            _( "This program renders a PCB file with the 3D viewer raytracer, without any "
+               "window or OpenGL context, and saves the image as a PNG file. The 3D models "
+               "are found as in the 3D viewer, relative to the folder of the PCB file." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    const bool verbose = cl_parser.Found( "verbose" );
+
+    wxString output;
+    cl_parser.Found( "output", &output );
+
+    long width = 1600;
+    long height = 1200;
+    cl_parser.Found( "width", &width );
+    cl_parser.Found( "height", &height );
+
+    if( width <= 0 || height <= 0 )
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+
+    std::string filename;
+
+    if( cl_parser.GetParamCount() )
+    {
+        filename = cl_parser.GetParam( 0 ).ToStdString();
+    }
+
+    std::unique_ptr<BOARD> board = KI_TEST::ReadBoardFromFileOrStream( filename );
+
+    if( !board )
+        return RENDER_RET_CODES::PARSE_FAILED;
+
+    // The 3D models are loaded by the plugins of the cache, which resolves their paths as
+    // PROJECT::Get3DCacheManager() does, with the folder of the board as project folder
+    S3D_CACHE  modelCache;
+    wxFileName configDir;
+
+    configDir.AssignDir( SETTINGS_MANAGER::GetUserSettingsPath() );
+    configDir.AppendDir( wxT( "3d" ) );
+
+    modelCache.SetProgramBase( &Pgm() );
+    modelCache.Set3DConfigDir( configDir.GetFullPath() );
+
+    if( filename.empty() )
+        modelCache.SetProjectDir( wxGetCwd() );
+    else
+        modelCache.SetProjectDir( wxFileName( filename ).GetPath( wxPATH_GET_VOLUME ) );
+
+    COLOR_SETTINGS colors;
+    CINFO3D_VISU   settings;
+
+    settings.SetBoard( board.get() );
+    settings.Set3DCacheManager( &modelCache );
+    settings.SetColorSettings( &colors );
+    setupSettings( settings, !cl_parser.Found( "no-post-processing" ) );
+
+    double angle;
+
+    if( cl_parser.Found( "rotate-x", &angle ) )
+        settings.CameraGet().RotateX( glm::radians( (float) angle ) );
+
+    if( cl_parser.Found( "rotate-z", &angle ) )
+        settings.CameraGet().RotateZ( glm::radians( (float) angle ) );
+
+    double zoom;
+
+    if( cl_parser.Found( "zoom", &zoom ) )
+        settings.CameraGet().Zoom( (float) zoom );
+
+    C3D_RENDER_RAYTRACING renderer( settings );
+    NULL_REPORTER         nullReporter;
+    REPORTER&             reporter = verbose ? STDOUT_REPORTER::GetInstance() : nullReporter;
+    wxImage               image;
+
+    renderer.ReloadRequest();
+
+    PROF_COUNTER timer;
+
+    if( !renderer.RenderOffscreen( wxSize( width, height ), image, &reporter, &reporter ) )
+        return RENDER_RET_CODES::RENDER_FAILED;
+
+    if( verbose )
+    {
+        std::cout << "Took: " << timer.SinceStart<RENDER_DURATION>().count() << "ms"
+                  << std::endl;
+    }
+
+    wxInitAllImageHandlers();
+
+    if( !image.SaveFile( output, wxBITMAP_TYPE_PNG ) )
+        return RENDER_RET_CODES::SAVE_FAILED;
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register(
+        { "render_3d", "Render a PCB with the 3D raytracer to a PNG file", render_3d_main_func } );